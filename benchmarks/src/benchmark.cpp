@@ -0,0 +1,167 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <numeric>
+
+using namespace bit7z::bench;
+
+BenchmarkRunner::BenchmarkRunner( size_t iterations, std::string filter )
+    : mIterations{ std::max< size_t >( iterations, 1 ) }, mFilter{ std::move( filter ) } {}
+
+bool BenchmarkRunner::accepts( const std::string& full_name ) const {
+    return mFilter.empty() || full_name.find( mFilter ) != std::string::npos;
+}
+
+void BenchmarkRunner::run( const Benchmark& benchmark ) {
+    const std::string full_name = benchmark.format + "/" + benchmark.corpus + "/" + benchmark.name;
+    if ( !accepts( full_name ) ) {
+        return;
+    }
+
+    std::cerr << "Running " << full_name << "..." << std::endl;
+    BenchmarkResult result{ benchmark.name, benchmark.format, benchmark.corpus, benchmark.bytes, {}, {}, {} };
+    result.seconds.reserve( mIterations );
+    try {
+        for ( size_t iteration = 0; iteration < mIterations; ++iteration ) {
+            if ( benchmark.setup ) {
+                benchmark.setup();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            benchmark.body();
+            const auto end = std::chrono::steady_clock::now();
+            result.seconds.push_back( std::chrono::duration< double >( end - start ).count() );
+            if ( benchmark.teardown ) {
+                benchmark.teardown();
+            }
+        }
+        if ( benchmark.counters ) {
+            result.counters = benchmark.counters();
+        }
+    } catch ( const std::exception& ex ) {
+        result.error = ex.what();
+        std::cerr << "Error: " << result.error << std::endl;
+    }
+    mResults.push_back( std::move( result ) );
+}
+
+namespace {
+
+std::string jsonNumber( double value ) {
+    char buffer[ 32 ];
+    std::snprintf( buffer, sizeof( buffer ), "%.9g", value );
+    return buffer;
+}
+
+double median( std::vector< double > values ) {
+    std::sort( values.begin(), values.end() );
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 != 0 ? values[ middle ] : ( values[ middle - 1 ] + values[ middle ] ) / 2;
+}
+
+} // namespace
+
+void BenchmarkRunner::writeJson( std::ostream& out, const std::map< std::string, std::string >& metadata ) const {
+    out << "{\n  \"metadata\": {";
+    bool first = true;
+    for ( const auto& entry : metadata ) {
+        out << ( first ? "\n" : ",\n" ) << "    " << jsonString( entry.first ) << ": " << jsonString( entry.second );
+        first = false;
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+
+    first = true;
+    for ( const auto& result : mResults ) {
+        out << ( first ? "\n" : ",\n" ) << "    {\n";
+        first = false;
+        out << "      \"name\": " << jsonString( result.name ) << ",\n";
+        out << "      \"format\": " << jsonString( result.format ) << ",\n";
+        out << "      \"corpus\": " << jsonString( result.corpus ) << ",\n";
+        out << "      \"bytes\": " << result.bytes << ",\n";
+        if ( !result.error.empty() ) {
+            out << "      \"error\": " << jsonString( result.error ) << ",\n";
+        }
+        out << "      \"iterations\": " << result.seconds.size();
+        if ( !result.seconds.empty() ) {
+            const auto minmax = std::minmax_element( result.seconds.cbegin(), result.seconds.cend() );
+            const double mean = std::accumulate( result.seconds.cbegin(), result.seconds.cend(), 0.0 ) /
+                                static_cast< double >( result.seconds.size() );
+            const double median_seconds = median( result.seconds );
+            out << ",\n      \"seconds\": [";
+            for ( size_t i = 0; i < result.seconds.size(); ++i ) {
+                out << ( i == 0 ? "" : ", " ) << jsonNumber( result.seconds[ i ] );
+            }
+            out << "],\n";
+            out << "      \"min\": " << jsonNumber( *minmax.first ) << ",\n";
+            out << "      \"max\": " << jsonNumber( *minmax.second ) << ",\n";
+            out << "      \"mean\": " << jsonNumber( mean ) << ",\n";
+            out << "      \"median\": " << jsonNumber( median_seconds );
+            if ( result.bytes > 0 && median_seconds > 0 ) {
+                out << ",\n      \"throughput_mib_s\": "
+                    << jsonNumber( static_cast< double >( result.bytes ) / ( 1024.0 * 1024.0 ) / median_seconds );
+                out << ",\n      \"throughput_gb_s\": "
+                    << jsonNumber( static_cast< double >( result.bytes ) / 1e9 / median_seconds );
+            }
+        }
+        if ( !result.counters.empty() ) {
+            out << ",\n      \"counters\": {";
+            bool first_counter = true;
+            for ( const auto& counter : result.counters ) {
+                out << ( first_counter ? " " : ", " ) << jsonString( counter.first ) << ": "
+                    << jsonNumber( counter.second );
+                first_counter = false;
+            }
+            out << " }";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+std::string bit7z::bench::jsonString( const std::string& value ) {
+    std::string result = "\"";
+    for ( const char character : value ) {
+        switch ( character ) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                if ( static_cast< unsigned char >( character ) < 0x20 ) {
+                    char buffer[ 8 ];
+                    std::snprintf( buffer, sizeof( buffer ), "\\u%04x", static_cast< unsigned >( character ) );
+                    result += buffer;
+                } else {
+                    result += character;
+                }
+        }
+    }
+    result += '"';
+    return result;
+}
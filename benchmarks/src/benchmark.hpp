@@ -0,0 +1,95 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace bench {
+
+/**
+ * @brief The measurements of a single benchmark.
+ */
+struct BenchmarkResult {
+    std::string name; ///< The name of the measured operation (e.g., "extract_dir").
+    std::string format; ///< The archive format (e.g., "7z").
+    std::string corpus; ///< The name of the corpus.
+    uint64_t bytes; ///< The amount of (uncompressed) data processed by each iteration.
+    std::vector< double > seconds; ///< The duration of each iteration.
+    std::string error; ///< The error message, if the benchmark failed.
+    std::map< std::string, double > counters; ///< Additional measurements (e.g., the system calls per file).
+};
+
+/**
+ * @brief A single benchmark: the setup and teardown functions run before and after each iteration,
+ * outside the measured time.
+ *
+ * The counters function, if any, runs once after the measured iterations, and returns
+ * additional measurements of the benchmarked operation.
+ */
+struct Benchmark {
+    std::string name;
+    std::string format;
+    std::string corpus;
+    uint64_t bytes;
+    std::function< void() > body;
+    std::function< void() > setup;
+    std::function< void() > teardown;
+    std::function< std::map< std::string, double >() > counters;
+};
+
+/**
+ * @brief Runs benchmarks and collects their results.
+ */
+class BenchmarkRunner final {
+    public:
+        /**
+         * @param iterations    the number of measured iterations of each benchmark.
+         * @param filter        if not empty, only the benchmarks whose full name
+         *                      ("format/corpus/name") contains it are run.
+         */
+        BenchmarkRunner( size_t iterations, std::string filter );
+
+        /**
+         * @return true if the benchmark with the given full name would be run by the runner.
+         */
+        bool accepts( const std::string& full_name ) const;
+
+        /**
+         * @brief Runs the given benchmark; errors are reported in the results, and do not stop the runner.
+         */
+        void run( const Benchmark& benchmark );
+
+        /**
+         * @brief Writes the results, and the given metadata about the run, as a JSON document.
+         */
+        void writeJson( std::ostream& out, const std::map< std::string, std::string >& metadata ) const;
+
+    private:
+        size_t mIterations;
+        std::string mFilter;
+        std::vector< BenchmarkResult > mResults;
+};
+
+/**
+ * @return the given string escaped and quoted for a JSON document.
+ */
+std::string jsonString( const std::string& value );
+
+} // namespace bench
+} // namespace bit7z
+
+#endif //BENCHMARK_HPP
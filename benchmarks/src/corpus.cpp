@@ -0,0 +1,178 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "corpus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace bit7z;
+using namespace bit7z::bench;
+
+constexpr uint64_t kKiB = 1024;
+constexpr uint64_t kMiB = 1024 * kKiB;
+constexpr size_t kWriteChunkSize = 1 * kMiB;
+
+RandomGenerator::RandomGenerator( uint64_t seed ) noexcept: mState{ seed } {}
+
+uint64_t RandomGenerator::next() noexcept {
+    uint64_t result = ( mState += 0x9E3779B97F4A7C15ull );
+    result = ( result ^ ( result >> 30u ) ) * 0xBF58476D1CE4E5B9ull;
+    result = ( result ^ ( result >> 27u ) ) * 0x94D049BB133111EBull;
+    return result ^ ( result >> 31u );
+}
+
+uint64_t RandomGenerator::nextInRange( uint64_t min, uint64_t max ) noexcept {
+    return min + ( next() % ( max - min + 1 ) );
+}
+
+namespace {
+
+enum struct DataKind {
+    Random,
+    Text,
+    Mixed ///< Alternating chunks of random and text data.
+};
+
+void fillRandom( RandomGenerator& generator, std::vector< char >& chunk ) {
+    for ( size_t i = 0; i < chunk.size(); i += sizeof( uint64_t ) ) {
+        const uint64_t value = generator.next();
+        const size_t count = std::min( sizeof( uint64_t ), chunk.size() - i );
+        for ( size_t j = 0; j < count; ++j ) {
+            chunk[ i + j ] = static_cast< char >( ( value >> ( 8u * j ) ) & 0xFFu );
+        }
+    }
+}
+
+void fillText( RandomGenerator& generator, std::vector< char >& chunk ) {
+    static const std::array< const char*, 16 > dictionary = { {
+        "archive ", "compression ", "the ", "of ", "stream ", "item ", "extract ", "data ",
+        "block ", "solid ", "header ", "and ", "file ", "to ", "format ", "7-zip\n"
+    } };
+
+    size_t position = 0;
+    while ( position < chunk.size() ) {
+        const char* word = dictionary[ generator.next() % dictionary.size() ];
+        while ( *word != '\0' && position < chunk.size() ) {
+            chunk[ position++ ] = *word++;
+        }
+    }
+}
+
+void writeFile( const fs::path& path, uint64_t size, DataKind data_kind, RandomGenerator& generator ) {
+    fs::ofstream out{ path, std::ios::binary | std::ios::trunc };
+    if ( !out ) {
+        throw std::runtime_error( "Could not create the corpus file " + path.string() );
+    }
+
+    std::vector< char > chunk;
+    bool random_chunk = data_kind != DataKind::Text;
+    uint64_t remaining = size;
+    while ( remaining > 0 ) {
+        chunk.resize( static_cast< size_t >( std::min< uint64_t >( remaining, kWriteChunkSize ) ) );
+        if ( random_chunk ) {
+            fillRandom( generator, chunk );
+        } else {
+            fillText( generator, chunk );
+        }
+        if ( data_kind == DataKind::Mixed ) {
+            random_chunk = !random_chunk;
+        }
+        out.write( chunk.data(), static_cast< std::streamsize >( chunk.size() ) );
+        remaining -= chunk.size();
+    }
+    if ( !out ) {
+        throw std::runtime_error( "Could not write the corpus file " + path.string() );
+    }
+}
+
+} // namespace
+
+CorpusGenerator::CorpusGenerator( fs::path work_dir, double scale, uint64_t seed )
+    : mWorkDir{ std::move( work_dir ) }, mScale{ scale }, mSeed{ seed } {}
+
+uint64_t CorpusGenerator::scaled( uint64_t value ) const noexcept {
+    return std::max< uint64_t >( static_cast< uint64_t >( static_cast< double >( value ) * mScale ), 1 );
+}
+
+Corpus CorpusGenerator::generate( CorpusKind kind ) const {
+    Corpus corpus{ kind, corpusName( kind ), mWorkDir / corpusName( kind ), {}, 0 };
+    fs::remove_all( corpus.root );
+    fs::create_directories( corpus.root );
+
+    // Note: each corpus has its own generator, so that its content doesn't depend on the other corpora.
+    RandomGenerator generator{ mSeed ^ ( static_cast< uint64_t >( kind ) + 1 ) * 0x9E3779B97F4A7C15ull };
+    auto add_file = [ & ]( const fs::path& relative_path, uint64_t size, DataKind data_kind ) {
+        writeFile( corpus.root / relative_path, size, data_kind, generator );
+        corpus.files.push_back( relative_path );
+        corpus.totalSize += size;
+    };
+
+    switch ( kind ) {
+        case CorpusKind::TinyFiles: {
+            const uint64_t files_count = scaled( 10000 );
+            for ( uint64_t i = 0; i < files_count; ++i ) {
+                const auto data_kind = ( i % 2 == 0 ) ? DataKind::Text : DataKind::Random;
+                add_file( "file" + std::to_string( i ) + ".bin", generator.nextInRange( 0, 2 * kKiB ), data_kind );
+            }
+            break;
+        }
+        case CorpusKind::HugeFiles: {
+            for ( int i = 0; i < 2; ++i ) {
+                add_file( "huge" + std::to_string( i ) + ".bin", scaled( 128 * kMiB ), DataKind::Mixed );
+            }
+            break;
+        }
+        case CorpusKind::Incompressible:
+        case CorpusKind::Compressible: {
+            const auto data_kind = kind == CorpusKind::Incompressible ? DataKind::Random : DataKind::Text;
+            for ( int i = 0; i < 8; ++i ) {
+                add_file( "data" + std::to_string( i ) + ".bin",
+                          generator.nextInRange( scaled( 4 * kMiB ), scaled( 12 * kMiB ) ),
+                          data_kind );
+            }
+            break;
+        }
+        case CorpusKind::DeepTree: {
+            const uint64_t depth = std::min< uint64_t >( scaled( 48 ), 96 ); // Keeping paths below common limits.
+            fs::path directory;
+            for ( uint64_t level = 0; level < depth; ++level ) {
+                directory /= "d" + std::to_string( level );
+                fs::create_directories( corpus.root / directory );
+                for ( int i = 0; i < 4; ++i ) {
+                    add_file( directory / ( "f" + std::to_string( i ) + ".txt" ),
+                              generator.nextInRange( 0, 8 * kKiB ),
+                              DataKind::Text );
+                }
+            }
+            break;
+        }
+    }
+    return corpus;
+}
+
+std::string bench::corpusName( CorpusKind kind ) {
+    switch ( kind ) {
+        case CorpusKind::TinyFiles:
+            return "tiny_files";
+        case CorpusKind::HugeFiles:
+            return "huge_files";
+        case CorpusKind::Incompressible:
+            return "incompressible";
+        case CorpusKind::Compressible:
+            return "compressible";
+        case CorpusKind::DeepTree:
+        default:
+            return "deep_tree";
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <internal/fs.hpp>
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace bench {
+
+enum struct CorpusKind {
+    TinyFiles, ///< Many small files in a flat directory.
+    HugeFiles, ///< A few large files of mixed data.
+    Incompressible, ///< Random data.
+    Compressible, ///< Text-like data built from a small dictionary.
+    DeepTree ///< Small files in a deeply nested directory tree.
+};
+
+/**
+ * @brief A corpus of files generated on the filesystem.
+ */
+struct Corpus {
+    CorpusKind kind;
+    std::string name;
+    fs::path root;
+    std::vector< fs::path > files; ///< The paths of the files, relative to the corpus root, in generation order.
+    uint64_t totalSize;
+};
+
+/**
+ * @brief Deterministic pseudo-random number generator (SplitMix64), so that the same seed
+ * always produces the same corpus, on every platform.
+ */
+class RandomGenerator final {
+    public:
+        explicit RandomGenerator( uint64_t seed ) noexcept;
+
+        uint64_t next() noexcept;
+
+        /**
+         * @return a number in the range [min, max].
+         */
+        uint64_t nextInRange( uint64_t min, uint64_t max ) noexcept;
+
+    private:
+        uint64_t mState;
+};
+
+/**
+ * @brief Generates deterministic benchmark corpora inside a working directory.
+ */
+class CorpusGenerator final {
+    public:
+        /**
+         * @param work_dir  the directory where the corpora will be generated (one subdirectory for each corpus).
+         * @param scale     the scale factor applied to the number of files and to their sizes.
+         * @param seed      the seed of the pseudo-random data.
+         */
+        CorpusGenerator( fs::path work_dir, double scale, uint64_t seed );
+
+        /**
+         * @brief Generates the given corpus, replacing any previous content of its directory.
+         */
+        Corpus generate( CorpusKind kind ) const;
+
+    private:
+        fs::path mWorkDir;
+        double mScale;
+        uint64_t mSeed;
+
+        BIT7Z_NODISCARD uint64_t scaled( uint64_t value ) const noexcept;
+};
+
+std::string corpusName( CorpusKind kind );
+
+} // namespace bench
+} // namespace bit7z
+
+#endif //CORPUS_HPP
@@ -0,0 +1,147 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <bit7z/bit7zlibrary.hpp>
+
+#include "benchmark.hpp"
+#include "compiler.hpp"
+#include "corpus.hpp"
+#include "scenarios.hpp"
+#include "shared_lib.hpp"
+
+using namespace bit7z;
+using namespace bit7z::bench;
+
+namespace {
+
+constexpr auto kUsage =
+    "Usage: bit7z-bench [options]\n"
+    "Options:\n"
+    "  --lib <path>         the path to the 7-zip shared library\n"
+    "  --work-dir <path>    the directory for the corpora, archives, and extracted files\n"
+    "                       (default: <temp dir>/bit7z-bench)\n"
+    "  --output <path>      the output JSON file (default: standard output)\n"
+    "  --iterations <n>     the measured iterations of each benchmark (default: 5)\n"
+    "  --scale <factor>     the scale factor of the corpora (default: 1.0)\n"
+    "  --seed <n>           the seed of the corpora data (default: 7)\n"
+    "  --filter <text>      run only the benchmarks whose name (format/corpus/name) contains the text\n"
+    "  --keep-work-dir      do not delete the working directory at the end\n";
+
+struct Options {
+    tstring libraryPath = test::sevenzip_lib_path();
+    fs::path workDir = fs::temp_directory_path() / "bit7z-bench";
+    std::string outputPath;
+    size_t iterations = 5;
+    double scale = 1.0;
+    uint64_t seed = 7;
+    std::string filter;
+    bool keepWorkDir = false;
+};
+
+bool parseOptions( int argc, char* argv[], Options& options ) {
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string option = argv[ i ];
+        if ( option == "--keep-work-dir" ) {
+            options.keepWorkDir = true;
+            continue;
+        }
+        if ( i + 1 >= argc ) {
+            return false;
+        }
+        const std::string value = argv[ ++i ];
+        if ( option == "--lib" ) {
+            options.libraryPath = fs::path( value ).string< tchar >();
+        } else if ( option == "--work-dir" ) {
+            options.workDir = value;
+        } else if ( option == "--output" ) {
+            options.outputPath = value;
+        } else if ( option == "--iterations" ) {
+            options.iterations = static_cast< size_t >( std::stoul( value ) );
+        } else if ( option == "--scale" ) {
+            options.scale = std::stod( value );
+        } else if ( option == "--seed" ) {
+            options.seed = std::stoull( value );
+        } else if ( option == "--filter" ) {
+            options.filter = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main( int argc, char* argv[] ) try {
+    Options options;
+    if ( !parseOptions( argc, argv, options ) ) {
+        std::cerr << kUsage;
+        return EXIT_FAILURE;
+    }
+
+    const Bit7zLibrary lib{ options.libraryPath };
+    const CorpusGenerator generator{ options.workDir / "corpora", options.scale, options.seed };
+    BenchmarkRunner runner{ options.iterations, options.filter };
+
+    if ( hasScanBenchmarks( runner ) ) {
+        std::cerr << "Running the signature scanning benchmarks..." << std::endl;
+        runScanBenchmarks( runner, options.scale, options.seed );
+    }
+
+    for ( const auto kind : { CorpusKind::TinyFiles,
+                              CorpusKind::HugeFiles,
+                              CorpusKind::Incompressible,
+                              CorpusKind::Compressible,
+                              CorpusKind::DeepTree } ) {
+        // Not generating the corpora whose benchmarks are all filtered out.
+        const std::string corpus_name = corpusName( kind );
+        if ( !hasArchiveBenchmarks( runner, corpus_name ) && !hasIndexingBenchmarks( runner, corpus_name ) ) {
+            continue;
+        }
+        std::cerr << "Generating the " << corpus_name << " corpus..." << std::endl;
+        const Corpus corpus = generator.generate( kind );
+        // Note: the indexing benchmark runs first, since it forks the process for counting the system calls.
+        runIndexingBenchmarks( runner, corpus );
+        runArchiveBenchmarks( runner, lib, corpus, options.workDir );
+        fs::remove_all( options.workDir / "archives" );
+    }
+
+    const std::map< std::string, std::string > metadata = {
+        { "compiler", std::string{ test::compiler::name } + " " + test::compiler::version },
+        { "target_arch", test::compiler::target_arch },
+        { "iterations", std::to_string( options.iterations ) },
+        { "scale", std::to_string( options.scale ) },
+        { "seed", std::to_string( options.seed ) },
+        { "filter", options.filter }
+    };
+    if ( options.outputPath.empty() ) {
+        runner.writeJson( std::cout, metadata );
+    } else {
+        std::ofstream output{ options.outputPath };
+        runner.writeJson( output, metadata );
+    }
+
+    if ( !options.keepWorkDir ) {
+        fs::remove_all( options.workDir );
+    }
+    return EXIT_SUCCESS;
+} catch ( const std::exception& ex ) {
+    std::cerr << "Error: " << ex.what() << std::endl;
+    return EXIT_FAILURE;
+}
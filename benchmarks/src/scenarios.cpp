@@ -0,0 +1,324 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "scenarios.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitarchivewriter.hpp>
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bitfilecompressor.hpp>
+#ifdef BIT7Z_AUTO_FORMAT
+#include <bit7z/bitformatprober.hpp>
+#endif
+#include <bit7z/bititemsvector.hpp>
+#include <internal/genericinputitem.hpp>
+
+#include "syscalls.hpp"
+
+using namespace bit7z;
+using namespace bit7z::bench;
+
+namespace {
+
+struct BenchmarkedFormat {
+    const char* name;
+    const BitInOutFormat& format;
+    bool multiFile; ///< Whether the format can store more than one file (single-file formats compress only one).
+};
+
+const std::array< BenchmarkedFormat, 5 >& benchmarkedFormats() {
+    static const std::array< BenchmarkedFormat, 5 > formats = { {
+        { "7z", BitFormat::SevenZip, true },
+        { "zip", BitFormat::Zip, true },
+        { "tar", BitFormat::Tar, true },
+        { "gz", BitFormat::GZip, false },
+        { "xz", BitFormat::Xz, false }
+    } };
+    return formats;
+}
+
+/**
+ * @brief A stream buffer discarding all the data written to it.
+ */
+class NullBuffer final : public std::streambuf {
+    protected:
+        int_type overflow( int_type character ) override {
+            return traits_type::not_eof( character );
+        }
+
+        std::streamsize xsputn( const char_type* /*data*/, std::streamsize count ) override {
+            return count;
+        }
+};
+
+const std::array< const char*, 9 > kBenchmarkNames = { {
+    "compress", "open", "list", "extract_dir", "extract_buffer", "extract_stream", "extract_map", "test", "update"
+} };
+
+// In update benchmarks, about one item every kUpdatedItemsRatio is replaced (the same path is added again).
+constexpr size_t kUpdatedItemsRatio = 100;
+
+tstring toTString( const fs::path& path ) {
+    return path.string< tchar >();
+}
+
+constexpr auto kIndexingFormatName = "fs";
+
+constexpr auto kScanFormatName = "signatures";
+constexpr uint64_t kScanDataSize = 256 * 1024 * 1024;
+const std::array< const char*, 2 > kScanCorpusNames = { { "random", "zeros" } };
+
+} // namespace
+
+bool bench::hasArchiveBenchmarks( const BenchmarkRunner& runner, const std::string& corpus_name ) {
+    for ( const auto& benchmarked_format : benchmarkedFormats() ) {
+        for ( const auto* name : kBenchmarkNames ) {
+            if ( runner.accepts( std::string{ benchmarked_format.name } + "/" + corpus_name + "/" + name ) ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void bench::runArchiveBenchmarks( BenchmarkRunner& runner,
+                                  const Bit7zLibrary& lib,
+                                  const Corpus& corpus,
+                                  const fs::path& work_dir ) {
+    if ( corpus.files.empty() ) {
+        return;
+    }
+
+    const fs::path archives_dir = work_dir / "archives";
+    const fs::path output_dir = work_dir / "output";
+    fs::create_directories( archives_dir );
+
+    // Single-file formats compress the largest file of the corpus.
+    const auto largest_file = *std::max_element( corpus.files.cbegin(), corpus.files.cend(),
+                                                 [ &corpus ]( const fs::path& first, const fs::path& second ) {
+                                                     return fs::file_size( corpus.root / first ) <
+                                                            fs::file_size( corpus.root / second );
+                                                 } );
+    const uint64_t largest_file_size = fs::file_size( corpus.root / largest_file );
+
+    for ( const auto& benchmarked_format : benchmarkedFormats() ) {
+        const std::string format_name = benchmarked_format.name;
+        const BitInOutFormat& format = benchmarked_format.format;
+        const bool multi_file = benchmarked_format.multiFile;
+        const uint64_t input_size = multi_file ? corpus.totalSize : largest_file_size;
+        const fs::path archive_path = archives_dir / ( corpus.name + "." + format_name );
+
+        auto make_benchmark = [ & ]( const std::string& name, uint64_t bytes ) {
+            return Benchmark{ name, format_name, corpus.name, bytes, {}, {}, {}, {} };
+        };
+
+        BitFileCompressor compressor{ lib, format };
+        auto compress = [ & ]() {
+            if ( multi_file ) {
+                compressor.compressDirectory( toTString( corpus.root ), toTString( archive_path ) );
+            } else {
+                compressor.compressFile( toTString( corpus.root / largest_file ), toTString( archive_path ) );
+            }
+        };
+
+        Benchmark compress_benchmark = make_benchmark( "compress", input_size );
+        compress_benchmark.setup = [ &archive_path ]() {
+            fs::remove( archive_path );
+        };
+        compress_benchmark.body = compress;
+        runner.run( compress_benchmark );
+
+        // The following benchmarks need the archive, even if the compression benchmark was filtered out.
+        std::unique_ptr< BitArchiveReader > reader;
+        try {
+            if ( !fs::exists( archive_path ) ) {
+                compress();
+            }
+            reader = std::make_unique< BitArchiveReader >( lib, toTString( archive_path ), format );
+        } catch ( const BitException& ex ) {
+            std::cerr << "Skipping " << format_name << "/" << corpus.name << ": " << ex.what() << std::endl;
+            continue;
+        }
+
+        Benchmark open_benchmark = make_benchmark( "open", 0 );
+        open_benchmark.body = [ & ]() {
+            const BitArchiveReader opened_reader{ lib, toTString( archive_path ), format };
+            static_cast< void >( opened_reader.itemsCount() );
+        };
+        runner.run( open_benchmark );
+
+        Benchmark list_benchmark = make_benchmark( "list", 0 );
+        list_benchmark.body = [ & ]() {
+            static_cast< void >( reader->items() );
+        };
+        runner.run( list_benchmark );
+
+        Benchmark extract_dir_benchmark = make_benchmark( "extract_dir", input_size );
+        extract_dir_benchmark.body = [ & ]() {
+            reader->extract( toTString( output_dir ) );
+        };
+        extract_dir_benchmark.teardown = [ &output_dir ]() {
+            fs::remove_all( output_dir );
+        };
+        runner.run( extract_dir_benchmark );
+
+        // The buffer and stream benchmarks extract the largest item of the archive.
+        uint32_t largest_item = 0;
+        uint64_t largest_item_size = 0;
+        for ( const auto& item : reader->items() ) {
+            if ( !item.isDir() && item.size() >= largest_item_size ) {
+                largest_item = item.index();
+                largest_item_size = item.size();
+            }
+        }
+
+        Benchmark extract_buffer_benchmark = make_benchmark( "extract_buffer", largest_item_size );
+        extract_buffer_benchmark.body = [ & ]() {
+            std::vector< byte_t > buffer;
+            reader->extract( buffer, largest_item );
+        };
+        runner.run( extract_buffer_benchmark );
+
+        Benchmark extract_stream_benchmark = make_benchmark( "extract_stream", largest_item_size );
+        extract_stream_benchmark.body = [ & ]() {
+            NullBuffer null_buffer;
+            std::ostream null_stream{ &null_buffer };
+            reader->extract( null_stream, largest_item );
+        };
+        runner.run( extract_stream_benchmark );
+
+        Benchmark extract_map_benchmark = make_benchmark( "extract_map", input_size );
+        extract_map_benchmark.body = [ & ]() {
+            std::map< tstring, std::vector< byte_t > > map;
+            reader->extract( map );
+        };
+        runner.run( extract_map_benchmark );
+
+        Benchmark test_benchmark = make_benchmark( "test", input_size );
+        test_benchmark.body = [ & ]() {
+            reader->test();
+        };
+        runner.run( test_benchmark );
+
+        if ( !multi_file ) {
+            continue;
+        }
+
+        /* Update planning: some files of the corpus are added again to the archive using UpdateMode::Update,
+         * so that the corresponding old items must be found and replaced. */
+        std::map< tstring, tstring > updated_items;
+        uint64_t updated_size = 0;
+        for ( size_t i = 0; i < corpus.files.size(); i += kUpdatedItemsRatio ) {
+            const fs::path& file = corpus.files[ i ];
+            const fs::path in_archive_path = fs::path( corpus.name ) / file;
+            updated_items.emplace( toTString( corpus.root / file ), toTString( in_archive_path ) );
+            updated_size += fs::file_size( corpus.root / file );
+        }
+        const fs::path updated_archive_path = archives_dir / ( corpus.name + ".updated." + format_name );
+
+        Benchmark update_benchmark = make_benchmark( "update", updated_size );
+        update_benchmark.body = [ & ]() {
+            BitArchiveWriter writer{ lib, toTString( archive_path ), format };
+            writer.setUpdateMode( UpdateMode::Update );
+            writer.addItems( updated_items );
+            writer.compressTo( toTString( updated_archive_path ) );
+        };
+        update_benchmark.teardown = [ &updated_archive_path ]() {
+            fs::remove( updated_archive_path );
+        };
+        runner.run( update_benchmark );
+    }
+}
+
+bool bench::hasIndexingBenchmarks( const BenchmarkRunner& runner, const std::string& corpus_name ) {
+    return runner.accepts( std::string{ kIndexingFormatName } + "/" + corpus_name + "/index" );
+}
+
+void bench::runIndexingBenchmarks( BenchmarkRunner& runner, const Corpus& corpus ) {
+    auto index = [ &corpus ]() -> size_t {
+        BitItemsVector items;
+        items.indexDirectory( corpus.root );
+        return items.size();
+    };
+
+    Benchmark index_benchmark{ "index", kIndexingFormatName, corpus.name, 0, {}, {}, {}, {} };
+    index_benchmark.body = [ &index ]() {
+        static_cast< void >( index() );
+    };
+    index_benchmark.counters = [ &index ]() {
+        const size_t items_count = index();
+        std::map< std::string, double > counters{ { "items", static_cast< double >( items_count ) } };
+        uint64_t syscalls = 0;
+        if ( items_count > 0 && countSyscalls( [ &index ]() { static_cast< void >( index() ); }, syscalls ) ) {
+            counters.emplace( "syscalls", static_cast< double >( syscalls ) );
+            counters.emplace( "syscalls_per_item", static_cast< double >( syscalls ) / static_cast< double >( items_count ) );
+        }
+        return counters;
+    };
+    runner.run( index_benchmark );
+}
+
+bool bench::hasScanBenchmarks( const BenchmarkRunner& runner ) {
+#ifdef BIT7Z_AUTO_FORMAT
+    for ( const auto* corpus_name : kScanCorpusNames ) {
+        if ( runner.accepts( std::string{ kScanFormatName } + "/" + corpus_name + "/scan" ) ) {
+            return true;
+        }
+    }
+#else
+    static_cast< void >( runner );
+#endif
+    return false;
+}
+
+void bench::runScanBenchmarks( BenchmarkRunner& runner, double scale, uint64_t seed ) {
+#ifdef BIT7Z_AUTO_FORMAT
+    const auto data_size = std::max< uint64_t >( static_cast< uint64_t >( kScanDataSize * scale ), 1 );
+    std::vector< byte_t > data( static_cast< size_t >( data_size ) );
+    for ( const auto* corpus_name : kScanCorpusNames ) {
+        if ( !runner.accepts( std::string{ kScanFormatName } + "/" + corpus_name + "/scan" ) ) {
+            continue;
+        }
+        if ( std::string{ corpus_name } == "random" ) {
+            RandomGenerator random{ seed };
+            for ( auto& byte : data ) {
+                byte = static_cast< byte_t >( random.next() );
+            }
+        } else {
+            std::fill( data.begin(), data.end(), byte_t{} );
+        }
+
+        const BitFormatProber prober{ 1 };
+        size_t candidates_count = 0;
+        Benchmark scan_benchmark{ "scan", kScanFormatName, corpus_name, data_size, {}, {}, {}, {} };
+        scan_benchmark.body = [ & ]() {
+            candidates_count = prober.scan( data.data(), data.size() ).size();
+        };
+        scan_benchmark.counters = [ &candidates_count ]() -> std::map< std::string, double > {
+            return { { "candidates", static_cast< double >( candidates_count ) } };
+        };
+        runner.run( scan_benchmark );
+    }
+#else
+    static_cast< void >( runner );
+    static_cast< void >( scale );
+    static_cast< void >( seed );
+#endif
+}
@@ -0,0 +1,77 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SCENARIOS_HPP
+#define SCENARIOS_HPP
+
+#include <string>
+
+#include <bit7z/bit7zlibrary.hpp>
+
+#include "benchmark.hpp"
+#include "corpus.hpp"
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace bench {
+
+/**
+ * @return true if the runner accepts at least one of the archive benchmarks of the given corpus.
+ */
+bool hasArchiveBenchmarks( const BenchmarkRunner& runner, const std::string& corpus_name );
+
+/**
+ * @brief Runs the archive benchmarks on the given corpus, for each of the benchmarked formats
+ * (7z, zip, tar, gz, xz): compression, open latency, listing, extraction to a directory,
+ * a buffer, a stream, and a map, testing, and updating.
+ *
+ * @param runner    the runner of the benchmarks.
+ * @param lib       the 7-zip library to be used.
+ * @param corpus    the corpus to be benchmarked.
+ * @param work_dir  the directory where the archives and the extracted files are written.
+ */
+void runArchiveBenchmarks( BenchmarkRunner& runner,
+                           const Bit7zLibrary& lib,
+                           const Corpus& corpus,
+                           const fs::path& work_dir );
+
+/**
+ * @return true if the runner accepts the indexing benchmark of the given corpus.
+ */
+bool hasIndexingBenchmarks( const BenchmarkRunner& runner, const std::string& corpus_name );
+
+/**
+ * @brief Runs the indexing benchmark on the given corpus, i.e., the recursive indexing of the corpus directory
+ * done before compressing it; where supported, it also counts the system calls made for each indexed item.
+ *
+ * @param runner    the runner of the benchmarks.
+ * @param corpus    the corpus to be benchmarked.
+ */
+void runIndexingBenchmarks( BenchmarkRunner& runner, const Corpus& corpus );
+
+/**
+ * @return true if the runner accepts at least one of the signature scanning benchmarks.
+ */
+bool hasScanBenchmarks( const BenchmarkRunner& runner );
+
+/**
+ * @brief Runs the signature scanning benchmarks, i.e., the search of embedded archives in in-memory data
+ * (random bytes, and zero bytes), reporting the scanning throughput.
+ *
+ * @note The benchmarks are run only if bit7z was built with the BIT7Z_AUTO_FORMAT option.
+ *
+ * @param runner    the runner of the benchmarks.
+ * @param scale     the scale factor of the scanned data (1.0 means 256 MiB).
+ * @param seed      the seed of the random data.
+ */
+void runScanBenchmarks( BenchmarkRunner& runner, double scale, uint64_t seed );
+
+} // namespace bench
+} // namespace bit7z
+
+#endif //SCENARIOS_HPP
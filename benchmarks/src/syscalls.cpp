@@ -0,0 +1,92 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "syscalls.hpp"
+
+#ifdef __linux__
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace bit7z::bench;
+
+namespace {
+#ifdef __linux__
+/**
+ * @brief Runs the given function in a child process, counting the system calls it makes (via ptrace).
+ */
+bool traceSyscalls( const std::function< void() >& body, uint64_t& count ) {
+    const pid_t child = fork();
+    if ( child < 0 ) {
+        return false;
+    }
+    if ( child == 0 ) {
+        // Waiting for the parent to start tracing the system calls.
+        if ( ptrace( PTRACE_TRACEME, 0, nullptr, nullptr ) != 0 || raise( SIGSTOP ) != 0 ) {
+            _exit( EXIT_FAILURE );
+        }
+        try {
+            body();
+        } catch ( const std::exception& ) {
+            _exit( EXIT_FAILURE );
+        }
+        _exit( EXIT_SUCCESS );
+    }
+
+    int status = 0;
+    if ( waitpid( child, &status, 0 ) != child || !WIFSTOPPED( status ) ) {
+        return false;
+    }
+    ptrace( PTRACE_SETOPTIONS, child, nullptr, PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL );
+
+    // Each system call stops the child twice, on entry and on exit; we count only the entries.
+    count = 0;
+    bool in_syscall = false;
+    int signal = 0;
+    while ( ptrace( PTRACE_SYSCALL, child, nullptr, signal ) == 0 && waitpid( child, &status, 0 ) == child ) {
+        signal = 0;
+        if ( WIFEXITED( status ) || WIFSIGNALED( status ) ) {
+            return WIFEXITED( status ) && WEXITSTATUS( status ) == EXIT_SUCCESS;
+        }
+        if ( WSTOPSIG( status ) == ( SIGTRAP | 0x80 ) ) {
+            if ( !in_syscall ) {
+                ++count;
+            }
+            in_syscall = !in_syscall;
+        } else {
+            signal = WSTOPSIG( status ); // Forwarding any other signal to the child.
+        }
+    }
+    return false;
+}
+#endif
+} // namespace
+
+bool bit7z::bench::countSyscalls( const std::function< void() >& body, uint64_t& count ) {
+#ifdef __linux__
+    uint64_t baseline = 0;
+    if ( !traceSyscalls( [] {}, baseline ) || !traceSyscalls( body, count ) ) {
+        return false;
+    }
+    count = count > baseline ? count - baseline : 0;
+    return true;
+#else
+    static_cast< void >( body );
+    static_cast< void >( count );
+    return false;
+#endif
+}
@@ -0,0 +1,37 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SYSCALLS_HPP
+#define SYSCALLS_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace bench {
+
+/**
+ * @brief Counts the system calls made by the given function.
+ *
+ * The function runs in a child process traced by the current one, so it must not have side effects
+ * needed by the caller. The system calls needed for running an empty function are not counted.
+ *
+ * @note Currently supported only on Linux.
+ *
+ * @param body  the function whose system calls must be counted.
+ * @param count the number of system calls made by the function.
+ *
+ * @return true if the system calls could be counted, false otherwise.
+ */
+bool countSyscalls( const std::function< void() >& body, uint64_t& count );
+
+} // namespace bench
+} // namespace bit7z
+
+#endif //SYSCALLS_HPP
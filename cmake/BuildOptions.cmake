@@ -29,6 +29,18 @@ if( BIT7Z_USE_NATIVE_STRING )
     target_compile_definitions( ${LIB_TARGET} PUBLIC BIT7Z_USE_NATIVE_STRING )
 endif()
 
+option( BIT7Z_USE_MAPPED_FILES "Enable or disable reading archive files through read-only memory mappings" )
+message( STATUS "Use memory-mapped archive files: ${BIT7Z_USE_MAPPED_FILES}" )
+if( BIT7Z_USE_MAPPED_FILES )
+    target_compile_definitions( ${LIB_TARGET} PUBLIC BIT7Z_USE_MAPPED_FILES )
+endif()
+
+option( BIT7Z_ENABLE_TRACING "Enable or disable recording trace spans of the archive operations" )
+message( STATUS "Enable tracing: ${BIT7Z_ENABLE_TRACING}" )
+if( BIT7Z_ENABLE_TRACING )
+    target_compile_definitions( ${LIB_TARGET} PUBLIC BIT7Z_ENABLE_TRACING )
+endif()
+
 option( BIT7Z_GENERATE_PIC "Enable or disable generating Position Independent Code" )
 message( STATUS "Generate Position Independent Code: ${BIT7Z_GENERATE_PIC}" )
 if( BIT7Z_USE_NATIVE_STRING )
@@ -38,6 +50,9 @@ endif()
 option( BIT7Z_BUILD_TESTS "Enable or disable building the testing executable" )
 message( STATUS "Build tests: ${BIT7Z_BUILD_TESTS}" )
 
+option( BIT7Z_BUILD_BENCHMARKS "Enable or disable building the benchmarking executable" )
+message( STATUS "Build benchmarks: ${BIT7Z_BUILD_BENCHMARKS}" )
+
 if( CMAKE_CXX_COMPILER_ID MATCHES "Clang" )
     option( BIT7Z_LINK_LIBCPP "Enable or disable linking to libc++" )
     message( STATUS "Link to libc++: ${BIT7Z_LINK_LIBCPP}" )
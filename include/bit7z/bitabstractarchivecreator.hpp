@@ -110,6 +110,16 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD uint32_t threadsCount() const noexcept;
 
+        /**
+         * @return the number of threads used for indexing the directories to be compressed.
+         */
+        BIT7Z_NODISCARD uint32_t indexingThreads() const noexcept;
+
+        /**
+         * @return whether the entries of the indexed directories are sorted by name.
+         */
+        BIT7Z_NODISCARD bool sortedIndexing() const noexcept;
+
         /**
          * @brief Sets up a password for the output archives.
          *
@@ -231,6 +241,29 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
          */
         void setThreadsCount( uint32_t threads_count ) noexcept;
 
+        /**
+         * @brief Sets the number of threads to be used for indexing the directories to be compressed
+         * (e.g., by BitArchiveWriter::addDirectory).
+         *
+         * When more than one thread is used, the subdirectories are listed concurrently, and each thread
+         * keeps at most one directory open at a time. The indexed items are the same, and in the same order,
+         * as the ones indexed by a single thread.
+         *
+         * @param threads_count the number of threads to be used (0 means the number of hardware threads).
+         */
+        void setIndexingThreads( uint32_t threads_count ) noexcept;
+
+        /**
+         * @brief Sets whether to sort by name the entries of each directory to be compressed.
+         *
+         * By default, the entries are indexed in the order given by the filesystem, which might differ
+         * between filesystems (and machines); sorting them makes the order of the items in the output
+         * archives deterministic, regardless of the number of indexing threads.
+         *
+         * @param sorted if true, the entries of each directory are sorted by name.
+         */
+        void setSortedIndexing( bool sorted ) noexcept;
+
         /**
          * @brief Sets a property for the output archive format as described by the 7-zip documentation
          * (e.g. https://sevenzip.osdn.jp/chm/cmdline/switches/method.htm).
@@ -284,6 +317,8 @@ class BitAbstractArchiveCreator : public BitAbstractArchiveHandler {
         bool mSolidMode;
         uint64_t mVolumeSize;
         uint32_t mThreadsCount;
+        uint32_t mIndexingThreads;
+        bool mSortedIndexing;
         std::map< std::wstring, BitPropVariant > mExtraProperties;
 };
 
@@ -14,7 +14,10 @@
 #include <functional>
 
 #include "bit7zlibrary.hpp"
+#include "bitcancellationtoken.hpp"
 #include "bitdefines.hpp"
+#include "bitoperationstats.hpp"
+#include "bitprogressmonitor.hpp"
 
 namespace bit7z {
 
@@ -50,6 +53,11 @@ using FileCallback = function< void( tstring ) >;
  */
 using PasswordCallback = function< tstring() >;
 
+/**
+ * @brief A std::function whose argument is the I/O statistics of the streams used by a completed operation.
+ */
+using OperationStatsCallback = function< void( const BitOperationStats& ) >;
+
 /**
  * @brief Enumeration representing how a handler should deal when an output file already exists.
  */
@@ -105,33 +113,48 @@ class BitAbstractArchiveHandler {
         /**
          * @return the current total callback.
          */
-        BIT7Z_NODISCARD TotalCallback totalCallback() const;
+        BIT7Z_NODISCARD const TotalCallback& totalCallback() const noexcept;
 
         /**
          * @return the current progress callback.
          */
-        BIT7Z_NODISCARD ProgressCallback progressCallback() const;
+        BIT7Z_NODISCARD const ProgressCallback& progressCallback() const noexcept;
 
         /**
          * @return the current ratio callback.
          */
-        BIT7Z_NODISCARD RatioCallback ratioCallback() const;
+        BIT7Z_NODISCARD const RatioCallback& ratioCallback() const noexcept;
 
         /**
          * @return the current file callback.
          */
-        BIT7Z_NODISCARD FileCallback fileCallback() const;
+        BIT7Z_NODISCARD const FileCallback& fileCallback() const noexcept;
 
         /**
          * @return the current password callback.
          */
-        BIT7Z_NODISCARD PasswordCallback passwordCallback() const;
+        BIT7Z_NODISCARD const PasswordCallback& passwordCallback() const noexcept;
+
+        /**
+         * @return the current operation stats callback.
+         */
+        BIT7Z_NODISCARD const OperationStatsCallback& operationStatsCallback() const noexcept;
 
         /**
          * @return the current OverwriteMode.
          */
         BIT7Z_NODISCARD OverwriteMode overwriteMode() const;
 
+        /**
+         * @return the token used for cancelling the operations of the handler.
+         */
+        BIT7Z_NODISCARD const BitCancellationToken& cancellationToken() const noexcept;
+
+        /**
+         * @return the monitor whose counters are updated during the operations of the handler.
+         */
+        BIT7Z_NODISCARD const BitProgressMonitor& progressMonitor() const noexcept;
+
         /**
          * @brief Sets up a password to be used by the archive handler.
          *
@@ -211,6 +234,17 @@ class BitAbstractArchiveHandler {
          */
         void setPasswordCallback( const PasswordCallback& callback );
 
+        /**
+         * @brief Sets the function to be called with the I/O statistics of each extraction, test,
+         * or compression operation, once the operation ends.
+         *
+         * @note The statistics are collected only if this callback is set: otherwise, the streams
+         * do not even measure the time spent in their calls.
+         *
+         * @param callback  the operation stats callback to be used.
+         */
+        void setOperationStatsCallback( const OperationStatsCallback& callback );
+
         /**
          * @brief Sets how the handler should behave when it tries to output to an existing file or buffer.
          *
@@ -218,6 +252,26 @@ class BitAbstractArchiveHandler {
          */
         void setOverwriteMode( OverwriteMode mode );
 
+        /**
+         * @brief Sets the token used for cancelling the operations of the handler from any thread.
+         *
+         * @note The token is polled while extracting or compressing, so a cancelled operation stops
+         * (throwing a BitException) as soon as the 7-zip library reports some progress or asks for the next item.
+         *
+         * @param token the cancellation token to be used.
+         */
+        void setCancellationToken( const BitCancellationToken& token );
+
+        /**
+         * @brief Sets the monitor whose counters will be updated during the operations of the handler.
+         *
+         * @note Each handler has its own monitor by default, so this is needed only for sharing the same
+         * monitor between different handlers.
+         *
+         * @param monitor   the progress monitor to be used.
+         */
+        void setProgressMonitor( const BitProgressMonitor& monitor );
+
     protected:
         explicit BitAbstractArchiveHandler( const Bit7zLibrary& lib,
                                             tstring password = {},
@@ -228,6 +282,8 @@ class BitAbstractArchiveHandler {
         tstring mPassword;
         bool mRetainDirectories;
         OverwriteMode mOverwriteMode;
+        BitCancellationToken mCancellationToken;
+        BitProgressMonitor mProgressMonitor;
 
         //CALLBACKS
         TotalCallback mTotalCallback;
@@ -235,6 +291,7 @@ class BitAbstractArchiveHandler {
         RatioCallback mRatioCallback;
         FileCallback mFileCallback;
         PasswordCallback mPasswordCallback;
+        OperationStatsCallback mOperationStatsCallback;
 };
 
 }  // namespace bit7z
@@ -45,6 +45,26 @@ class BitAbstractArchiveOpener : public BitAbstractArchiveHandler {
          */
         BIT7Z_NODISCARD const BitInFormat& extractionFormat() const noexcept;
 
+        /**
+         * @return the number of threads used for extracting (non-solid) archive files to the filesystem.
+         */
+        BIT7Z_NODISCARD uint32_t extractionThreads() const noexcept;
+
+        /**
+         * @brief Sets the number of threads to be used for extracting archive files to the filesystem.
+         *
+         * When more than one thread is used, the items to be extracted are split into groups with similar
+         * total size, and each group is extracted by a separate thread using its own instance of the archive.
+         * The progress notifications of the threads are merged and passed to the callbacks of this opener
+         * (which are never called concurrently).
+         *
+         * @note Only non-solid archive files are extracted in parallel: archives in memory buffers or streams,
+         * as well as solid archives, are always extracted by a single thread.
+         *
+         * @param threads_count the number of threads to be used (0 means the number of hardware threads).
+         */
+        void setExtractionThreads( uint32_t threads_count ) noexcept;
+
     protected:
         BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                   const BitInFormat& format,
@@ -52,6 +72,7 @@ class BitAbstractArchiveOpener : public BitAbstractArchiveHandler {
 
     private:
         const BitInFormat& mFormat;
+        uint32_t mExtractionThreads;
 };
 
 }  // namespace bit7z
@@ -43,6 +43,28 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
                           const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
                           const tstring& password = {} );
 
+        /**
+         * @brief Constructs a BitArchiveReader object, opening the archive starting at the given offset
+         * of the input file (e.g., a candidate found by BitFormatProber::scan()).
+         *
+         * @note When bit7z is compiled using the `BIT7Z_AUTO_FORMAT` option, the format
+         * argument has default value BitFormat::Auto (automatic format detection of the input archive,
+         * using the signature at the given offset).
+         * On the contrary, when `BIT7Z_AUTO_FORMAT` is not defined (i.e., no auto format detection available),
+         * the format argument must be specified.
+         *
+         * @param lib           the 7z library used.
+         * @param in_archive    the path to the file containing the archive to be read.
+         * @param offset        the offset of the start of the archive in the file.
+         * @param format        the format of the input archive.
+         * @param password      the password needed for opening the input archive.
+         */
+        BitArchiveReader( const Bit7zLibrary& lib,
+                          const tstring& in_archive,
+                          uint64_t offset,
+                          const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
+                          const tstring& password = {} );
+
         /**
          * @brief Constructs a BitArchiveReader object, opening the archive in the input buffer.
          *
@@ -79,6 +101,27 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
                           const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
                           const tstring& password = {} );
 
+        /**
+         * @brief Constructs a BitArchiveReader object, opening the archive from the standard input stream
+         * using the given mode (e.g., InputStreamMode::ForwardOnly for reading non-seekable streams).
+         *
+         * @note When bit7z is compiled using the `BIT7Z_AUTO_FORMAT` option, the format
+         * argument has default value BitFormat::Auto (automatic format detection of the input archive).
+         * On the contrary, when `BIT7Z_AUTO_FORMAT` is not defined (i.e., no auto format detection available),
+         * the format argument must be specified.
+         *
+         * @param lib           the 7z library used.
+         * @param in_archive    the standard input stream of the archive to be read.
+         * @param mode          how the input stream must be read.
+         * @param format        the format of the input archive.
+         * @param password      the password needed for opening the input archive.
+         */
+        BitArchiveReader( const Bit7zLibrary& lib,
+                          std::istream& in_archive,
+                          InputStreamMode mode,
+                          const BitInFormat& format BIT7Z_DEFAULT_FORMAT,
+                          const tstring& password = {} );
+
         BitArchiveReader( const BitArchiveReader& ) = delete;
 
         BitArchiveReader( BitArchiveReader&& ) = delete;
@@ -104,6 +147,16 @@ class BitArchiveReader final : public BitAbstractArchiveOpener, public BitInputA
          */
         BIT7Z_NODISCARD vector< BitArchiveItemInfo > items() const;
 
+        /**
+         * @brief Reads only the given properties of the archive items.
+         *
+         * @param properties_mask   the item properties to be read (properties not supported by the
+         *                          archive format are ignored).
+         *
+         * @return a vector of all the archive items as BitArchiveItem objects.
+         */
+        BIT7Z_NODISCARD vector< BitArchiveItemInfo > items( const vector< BitProperty >& properties_mask ) const;
+
         /**
          * @return the number of folders contained in the archive.
          */
@@ -0,0 +1,38 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITASYNC_HPP
+#define BITASYNC_HPP
+
+#include <functional>
+#include <future>
+
+namespace bit7z {
+
+/**
+ * @brief A std::function running the given task, e.g., by submitting it to a thread pool.
+ *
+ * The executor may run the task in any thread, but it must run it exactly once.
+ */
+using BitExecutor = std::function< void( std::function< void() > ) >;
+
+/**
+ * @brief Runs the given task using the given executor.
+ *
+ * @param executor  the executor running the task (if empty, the task is run in a new thread as by std::async,
+ *                  hence the destructor of the returned future waits for the completion of the task).
+ * @param task      the task to be run.
+ *
+ * @return the future holding the completion of the task, or the exception it threw.
+ */
+std::future< void > runAsync( const BitExecutor& executor, std::function< void() > task );
+
+}  // namespace bit7z
+
+#endif //BITASYNC_HPP
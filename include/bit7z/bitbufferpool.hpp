@@ -0,0 +1,43 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITBUFFERPOOL_HPP
+#define BITBUFFERPOOL_HPP
+
+#include <cstdint>
+
+#include "bitdefines.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief Usage statistics of the process-wide pool of I/O buffers used by bit7z's file streams.
+ */
+struct BitBufferPoolStats {
+    uint64_t acquiredBuffers;   ///< Number of buffers borrowed by file streams so far.
+    uint64_t reusedBuffers;     ///< Number of borrowed buffers that were reused rather than newly allocated.
+    uint64_t allocatedBytes;    ///< Total bytes of the buffers allocated so far.
+    uint64_t bytesInUse;        ///< Bytes of the buffers currently borrowed by file streams.
+    uint64_t peakBytesInUse;    ///< Maximum value reached by bytesInUse.
+    uint64_t cachedBytes;       ///< Bytes of the free buffers currently kept in the pool for reuse.
+};
+
+/**
+ * @return the current usage statistics of the I/O buffers pool.
+ */
+BIT7Z_NODISCARD BitBufferPoolStats bufferPoolStats();
+
+/**
+ * @brief Frees all the buffers currently kept in the I/O buffers pool for reuse.
+ */
+void trimBufferPool();
+
+}  // namespace bit7z
+
+#endif //BITBUFFERPOOL_HPP
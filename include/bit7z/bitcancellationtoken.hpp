@@ -0,0 +1,62 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITCANCELLATIONTOKEN_HPP
+#define BITCANCELLATIONTOKEN_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "bitdefines.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief A thread-safe flag for cancelling the operations of an archive handler from any thread.
+ *
+ * Copies of a token share the same state: the token set to a handler (see
+ * BitAbstractArchiveHandler::setCancellationToken) can be cancelled through any other copy of it.
+ * Once cancelled, the ongoing operations are stopped as soon as possible, throwing a BitException
+ * with the BitError::OperationCancelled error code.
+ *
+ * @note A cancelled token stays cancelled, so all the following operations using it fail too:
+ * call reset() (or set a new token to the handler) before starting a new operation.
+ */
+class BitCancellationToken final {
+    public:
+        /**
+         * @brief Constructs a new token, not cancelled.
+         */
+        BitCancellationToken();
+
+        /**
+         * @brief Requests the cancellation of the operations using this token (or any of its copies).
+         */
+        void cancel() const noexcept;
+
+        /**
+         * @return true if the cancellation was requested.
+         */
+        BIT7Z_NODISCARD bool isCancelled() const noexcept;
+
+        /**
+         * @brief Clears the cancellation request, so that the token (and all its copies) can be used
+         *        for new operations.
+         *
+         * @note It must not be called while an operation using the token is still running.
+         */
+        void reset() const noexcept;
+
+    private:
+        std::shared_ptr< std::atomic< bool > > mCancelled;
+};
+
+}  // namespace bit7z
+
+#endif //BITCANCELLATIONTOKEN_HPP
@@ -38,7 +38,8 @@ enum struct BitError {
     NonEmptyOutputBuffer,
     RequestedWrongVariantType,
     UnsupportedOperation,
-    WrongUpdateMode
+    WrongUpdateMode,
+    OperationCancelled
 };
 
 std::error_code make_error_code( const BitError& e );
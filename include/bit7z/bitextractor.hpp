@@ -11,8 +11,11 @@
 #define BITEXTRACTOR_HPP
 
 #include <algorithm>
+#include <functional>
+#include <type_traits>
 
 #include "bitabstractarchiveopener.hpp"
+#include "bitasync.hpp"
 #include "biterror.hpp"
 #include "bitexception.hpp"
 #include "bitinputarchive.hpp"
@@ -71,6 +74,33 @@ class BitExtractor final : public BitAbstractArchiveOpener {
             input_archive.extract( out_dir );
         }
 
+        /**
+         * @brief Asynchronously extracts the given archive to the chosen directory.
+         *
+         * @note The extractor must outlive the returned future; input paths are copied, while input buffers
+         * and streams are referenced, so they must outlive the returned future too.
+         * The extraction can be stopped using the extractor's cancellation token.
+         *
+         * @param in_archive    the input archive to be extracted.
+         * @param out_dir       the output directory where extracted files will be put.
+         * @param executor      the executor running the extraction (if empty, the extraction runs in a new thread).
+         *
+         * @return the future holding the completion of the extraction, or the exception it threw.
+         */
+        BIT7Z_NODISCARD std::future< void > extractAsync( Input in_archive,
+                                                          const tstring& out_dir = {},
+                                                          const BitExecutor& executor = {} ) const {
+            using StoredInput = typename std::conditional< std::is_same< typename std::decay< Input >::type,
+                                                                         tstring >::value,
+                                                           tstring,
+                                                           std::reference_wrapper<
+                                                               typename std::remove_reference< Input >::type > >::type;
+            return runAsync( executor, [ this, input = StoredInput( in_archive ), out_dir ]() {
+                BitInputArchive input_archive( *this, static_cast< Input >( input ) );
+                input_archive.extract( out_dir );
+            } );
+        }
+
         /**
          * @brief Extracts a file from the given archive to the output buffer.
          *
@@ -0,0 +1,175 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITFORMATPROBER_HPP
+#define BITFORMATPROBER_HPP
+
+#ifdef BIT7Z_AUTO_FORMAT
+
+#include <cstdint>
+#include <vector>
+
+#include "bitformat.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief How much a format detected by the BitFormatProber can be trusted,
+ * depending on the length of the matched signature.
+ */
+enum struct BitProbeConfidence : uint8_t {
+    None,   ///< No signature matched.
+    Low,    ///< A signature of one or two bytes matched (e.g., the "PK" of Zip files, or the "MZ" of PE files).
+    Medium, ///< A signature of three or four bytes matched.
+    High    ///< A signature of five or more bytes matched.
+};
+
+/**
+ * @brief The result of the probing of a file, i.e., its detected format and the confidence of the detection.
+ */
+class BitProbeResult final {
+    public:
+        /**
+         * @brief Constructs a result representing a file whose format was not detected.
+         */
+        BitProbeResult() noexcept;
+
+        BitProbeResult( const BitInFormat& format, BitProbeConfidence confidence ) noexcept;
+
+        /**
+         * @return the detected format, or BitFormat::Auto if no format was detected.
+         */
+        BIT7Z_NODISCARD const BitInFormat& format() const noexcept;
+
+        /**
+         * @return the confidence of the detection.
+         */
+        BIT7Z_NODISCARD BitProbeConfidence confidence() const noexcept;
+
+        /**
+         * @return true if the format of the file was detected.
+         */
+        BIT7Z_NODISCARD bool detected() const noexcept;
+
+    private:
+        const BitInFormat* mFormat;
+        BitProbeConfidence mConfidence;
+};
+
+/**
+ * @brief A possible archive embedded in a larger file (e.g., an archive appended to a self-extracting executable),
+ * as found by BitFormatProber::scan().
+ */
+class BitEmbeddedArchive final {
+    public:
+        BitEmbeddedArchive( uint64_t offset, const BitInFormat& format ) noexcept;
+
+        /**
+         * @return the offset of the start of the archive in the scanned file.
+         */
+        BIT7Z_NODISCARD uint64_t offset() const noexcept;
+
+        /**
+         * @return the format of the archive, as detected by its signature.
+         */
+        BIT7Z_NODISCARD const BitInFormat& format() const noexcept;
+
+    private:
+        uint64_t mOffset;
+        const BitInFormat* mFormat;
+};
+
+/**
+ * @brief The BitFormatProber class detects the format of files by their signatures without using
+ * the 7-zip library (i.e., without creating any IInArchive object).
+ *
+ * Only the initial 64 KiB of each file are read (with a single read call), and all the signatures known
+ * by bit7z are checked against them in memory.
+ * Alternatively, the whole content of a file can be scanned for archives embedded at any offset.
+ */
+class BitFormatProber final {
+    public:
+        /**
+         * @brief Constructs a BitFormatProber object.
+         *
+         * @param threads_count the number of threads used for probing many files (if 0, the number of threads
+         *                      is the number of hardware threads available).
+         */
+        explicit BitFormatProber( uint32_t threads_count = 0 ) noexcept;
+
+        /**
+         * @return the number of threads used for probing many files.
+         */
+        BIT7Z_NODISCARD uint32_t threadsCount() const noexcept;
+
+        /**
+         * @brief Detects the format of the given file.
+         *
+         * @param in_file the path to the file to be probed.
+         *
+         * @return the result of the probing.
+         */
+        BIT7Z_NODISCARD BitProbeResult probe( const tstring& in_file ) const;
+
+        /**
+         * @brief Detects the format of the file whose initial bytes are in the given buffer.
+         *
+         * @param data  the initial bytes of the file.
+         * @param size  the number of bytes in data.
+         *
+         * @return the result of the probing.
+         */
+        BIT7Z_NODISCARD BitProbeResult probe( const byte_t* data, std::size_t size ) const noexcept;
+
+        /**
+         * @brief Detects, in parallel, the format of the given files.
+         *
+         * @note Files that cannot be read are reported as not detected, without stopping the probing of the others.
+         *
+         * @param in_files the paths to the files to be probed.
+         *
+         * @return the results of the probing, in the same order of the given paths.
+         */
+        BIT7Z_NODISCARD std::vector< BitProbeResult > probe( const std::vector< tstring >& in_files ) const;
+
+        /**
+         * @brief Searches the signatures of the archive formats in the whole content of the given file.
+         *
+         * The file is split in ranges scanned in parallel; each found candidate can then be opened
+         * using the BitArchiveReader constructor taking the offset of the archive in the file.
+         *
+         * @note Only signatures of at least four bytes are searched, and a candidate is not guaranteed
+         * to be an actual archive (the signature may just occur by chance in the data).
+         *
+         * @param in_file the path to the file to be scanned.
+         *
+         * @return the candidate archives found, sorted by their offset.
+         */
+        BIT7Z_NODISCARD std::vector< BitEmbeddedArchive > scan( const tstring& in_file ) const;
+
+        /**
+         * @brief Searches the signatures of the archive formats in the given buffer.
+         *
+         * @param data  the data to be scanned.
+         * @param size  the number of bytes in data.
+         *
+         * @return the candidate archives found, sorted by their offset.
+         */
+        BIT7Z_NODISCARD std::vector< BitEmbeddedArchive > scan( const byte_t* data, std::size_t size ) const;
+
+    private:
+        uint32_t mThreadsCount;
+};
+
+}  // namespace bit7z
+
+#endif
+
+#endif //BITFORMATPROBER_HPP
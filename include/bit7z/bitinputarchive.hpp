@@ -10,21 +10,50 @@
 #define BITINPUTARCHIVE_HPP
 
 #include <array>
+#include <functional>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "bitabstractarchivehandler.hpp"
 #include "bitarchiveitemoffset.hpp"
+#include "bitasync.hpp"
 #include "bitformat.hpp"
 #include "bitfs.hpp"
+#include "bititemsarena.hpp"
+#include "bititemstream.hpp"
 
 struct IInStream;
 struct IInArchive;
 struct IOutArchive;
+struct ISequentialInStream;
 
 namespace bit7z {
 
 using std::vector;
 
+/**
+ * @brief A std::function receiving, chunk by chunk, the content of an item being extracted.
+ * The function takes a pointer to the chunk data and its size, and returns false to stop the extraction.
+ */
+using SinkCallback = std::function< bool( const byte_t*, std::size_t ) >;
+
+/**
+ * @brief Enumeration representing how an archive is read from an input stream.
+ */
+enum struct InputStreamMode {
+    Seekable,   ///< The stream is read at random offsets (i.e., it must support seeking).
+    ForwardOnly ///< The stream is read only once from start to end (e.g., a pipe, a socket, or the standard input).
+};
+
+class IOStatsRecorder;
+
+class ItemsSnapshot;
+
+class SolidBlockCache;
+
 /**
  * @brief The BitInputArchive class, given a handler object, allows reading/extracting the content of archives.
  */
@@ -52,6 +81,20 @@ class BitInputArchive {
         BitInputArchive( const BitAbstractArchiveHandler& handler, const fs::path& arc_path );
 #endif
 
+        /**
+         * @brief Constructs a BitInputArchive object, opening the archive starting at the given offset
+         * of the input file (e.g., an archive appended to an executable, or embedded in a disk image).
+         *
+         * @note The format is not detected from the file extension: if the handler's format is BitFormat::Auto,
+         * it is detected from the signature at the given offset.
+         *
+         * @param handler   the reference to the BitAbstractArchiveHandler object containing all the settings to
+         *                  be used for reading the input archive
+         * @param in_file   the path to the file containing the input archive
+         * @param offset    the offset of the start of the archive in the file
+         */
+        BitInputArchive( const BitAbstractArchiveHandler& handler, const tstring& in_file, uint64_t offset );
+
         /**
          * @brief Constructs a BitInputArchive object, opening the archive given in the input buffer.
          *
@@ -70,6 +113,28 @@ class BitInputArchive {
          */
         BitInputArchive( const BitAbstractArchiveHandler& handler, std::istream& in_stream );
 
+        /**
+         * @brief Constructs a BitInputArchive object, opening the archive by reading the given input stream
+         * using the given mode.
+         *
+         * In the InputStreamMode::ForwardOnly mode, the stream is never seeked: the format is detected
+         * (if needed) from a bounded look-ahead buffer, and the archive is opened through the sequential
+         * open interface of the format handler (available for formats like tar, gzip, bzip2, xz, and lzma).
+         * A BitException is thrown if the format requires random access to the archive (e.g., 7z and zip).
+         *
+         * @note In the ForwardOnly mode, the archive content is decoded while reading the stream,
+         * hence the archive can be extracted (or tested) only once, and only as a whole: the functions needing
+         * to know the items in advance (e.g., itemsCount() and the extraction of single items) throw a BitException
+         * with the BitError::FormatFeatureNotSupported error code, while the iterators give an empty range,
+         * find() returns the end() iterator, and contains() returns false.
+         *
+         * @param handler   the reference to the BitAbstractArchiveHandler object containing all the settings to
+         *                  be used for reading the input archive
+         * @param in_stream the standard input stream of the input archive
+         * @param mode      how the input stream must be read
+         */
+        BitInputArchive( const BitAbstractArchiveHandler& handler, std::istream& in_stream, InputStreamMode mode );
+
         BitInputArchive( const BitInputArchive& ) = delete;
 
         BitInputArchive( BitInputArchive&& ) = delete;
@@ -105,6 +170,16 @@ class BitInputArchive {
          */
         BIT7Z_NODISCARD BitPropVariant itemProperty( uint32_t index, BitProperty property ) const;
 
+        /**
+         * @return the archive properties supported by the format handler of the archive.
+         */
+        BIT7Z_NODISCARD const std::vector< BitProperty >& supportedArchiveProperties() const;
+
+        /**
+         * @return the item properties supported by the format handler of the archive.
+         */
+        BIT7Z_NODISCARD const std::vector< BitProperty >& supportedItemProperties() const;
+
         /**
          * @return the number of items contained in the archive.
          */
@@ -124,11 +199,49 @@ class BitInputArchive {
          */
         BIT7Z_NODISCARD bool isItemEncrypted( uint32_t index ) const;
 
+        /**
+         * @brief Reads, in a single pass, the main metadata of all the items in the archive (paths, sizes,
+         * packed sizes, CRCs, attributes, times, and directory/encryption flags) and keeps it in memory.
+         *
+         * After this call, the item properties covered by the snapshot are served from memory rather than
+         * queried to the archive handler every time; this speeds up, for example, iterating the items
+         * of the archive many times.
+         *
+         * @note The snapshot is opt-in since its memory usage grows with the number of items in the archive.
+         */
+        void loadItemsSnapshot();
+
+        /**
+         * @return true if and only if the metadata snapshot of the archive items was loaded.
+         */
+        BIT7Z_NODISCARD bool hasItemsSnapshot() const noexcept;
+
+        /**
+         * @brief Enables (or disables) the in-memory cache of the decoded items of solid blocks.
+         *
+         * When the cache is enabled, extracting a single item of a solid archive to a memory buffer decodes
+         * (and caches) all the items of the same solid block, so that subsequent extractions of the other items
+         * of the block to memory buffers are served without decoding the block again.
+         * When the cache is full, the least recently used blocks are evicted; blocks larger than the cache
+         * are never cached.
+         *
+         * @note Items served from the cache are not notified to the archive handler's callbacks.
+         *
+         * @param max_memory    the maximum number of bytes of decoded data kept in memory (0 disables the cache).
+         */
+        void setSolidBlockCacheSize( uint64_t max_memory );
+
         /**
          * @return the path to the archive (the empty string for buffer/stream archives).
          */
         BIT7Z_NODISCARD const tstring& archivePath() const noexcept;
 
+        /**
+         * @return the offset of the archive in the file at archivePath() (0 unless the archive was opened
+         * at a given offset).
+         */
+        BIT7Z_NODISCARD uint64_t archiveOffset() const noexcept;
+
         /**
          * @return the BitAbstractArchiveHandler object containing the settings for reading the archive.
          */
@@ -142,6 +255,22 @@ class BitInputArchive {
          */
         void extract( const tstring& out_dir, const std::vector< uint32_t >& indices = {} ) const;
 
+        /**
+         * @brief Asynchronously extracts the specified items to the chosen directory.
+         *
+         * @note The BitInputArchive object (and its handler) must outlive the returned future.
+         * The extraction can be stopped using the handler's cancellation token.
+         *
+         * @param out_dir   the output directory where the extracted files will be put.
+         * @param indices   the array of indices of the files in the archive that must be extracted.
+         * @param executor  the executor running the extraction (if empty, the extraction runs in a new thread).
+         *
+         * @return the future holding the completion of the extraction, or the exception it threw.
+         */
+        BIT7Z_NODISCARD std::future< void > extractAsync( const tstring& out_dir,
+                                                          const std::vector< uint32_t >& indices = {},
+                                                          const BitExecutor& executor = {} ) const;
+
         /**
          * @brief Extracts a file to the output buffer.
          *
@@ -194,6 +323,18 @@ class BitInputArchive {
          */
         void extract( std::ostream& out_stream, uint32_t index = 0 ) const;
 
+        /**
+         * @brief Extracts a file, passing its content to the given sink callback as soon as it is decoded,
+         * without buffering it in memory.
+         *
+         * @note If the sink returns false, the extraction is stopped and a BitException is thrown
+         * (like when the progress callback returns false); exceptions thrown by the sink are propagated as they are.
+         *
+         * @param sink   the callback receiving the chunks of the extracted content.
+         * @param index  the index of the file to be extracted.
+         */
+        void extract( const SinkCallback& sink, uint32_t index = 0 ) const;
+
         /**
          * @brief Extracts the content of the archive to a map of memory buffers, where the keys are the paths
          * of the files (inside the archive), and the values are their decompressed contents.
@@ -202,6 +343,48 @@ class BitInputArchive {
          */
         void extract( std::map< tstring, std::vector< byte_t > >& out_map ) const;
 
+        /**
+         * @brief Extracts the specified files into a single contiguous memory arena.
+         *
+         * The arena memory is reserved in advance using the sizes of the items, and the extracted items are described
+         * by a compact table of entries, so that no memory allocation per item is needed.
+         *
+         * @note The previous content of the arena is discarded; folders are not included in the arena.
+         * An item whose extracted content is larger than its Size property makes the extraction fail
+         * (BitError::InvalidOutputBufferSize), while a smaller item gets an entry with the size actually extracted.
+         *
+         * @param arena     the arena where the content of the files will be put.
+         * @param indices   the indices of the files to be extracted (if empty, all the files are extracted).
+         */
+        void extract( BitItemsArena& arena, const std::vector< uint32_t >& indices = {} ) const;
+
+        /**
+         * @brief Opens a stream for reading the content of the given file at any offset.
+         *
+         * If the archive format handler can provide a seekable stream for the item, the returned stream reads
+         * directly from the archive; otherwise, the item is decoded in memory (see BitItemStream::isDirect()).
+         *
+         * @param index the index of the file in the archive.
+         *
+         * @return the stream of the file.
+         */
+        BIT7Z_NODISCARD std::unique_ptr< BitItemStream > openItemStream( uint32_t index ) const;
+
+        /**
+         * @brief Extracts only the given range of bytes of a file to the pre-allocated output buffer.
+         *
+         * If the archive format handler can provide a seekable stream for the item, the range is read directly;
+         * otherwise, the item is decoded (discarding the bytes before the offset) only until the range is complete.
+         *
+         * @param index   the index of the file to be extracted.
+         * @param offset  the offset (in the unpacked file) of the first byte to be extracted.
+         * @param length  the number of bytes to be extracted (at most the size of the output buffer).
+         * @param buffer  the pre-allocated output buffer.
+         *
+         * @return the number of bytes extracted, which is less than length if the file ends before the range does.
+         */
+        std::size_t extractRange( uint32_t index, uint64_t offset, std::size_t length, byte_t* buffer ) const;
+
         /**
          * @brief Tests the archive without extracting its content.
          *
@@ -212,10 +395,16 @@ class BitInputArchive {
     protected:
         IInArchive* openArchiveStream( const fs::path& name, IInStream* in_stream );
 
+        IInArchive* openArchiveSequentially( ISequentialInStream* in_stream );
+
         HRESULT initUpdatableArchive( IOutArchive** newArc ) const;
 
         BIT7Z_NODISCARD HRESULT close() const noexcept;
 
+        BIT7Z_NODISCARD const std::unordered_map< tstring, uint32_t >& pathIndex() const;
+
+        BIT7Z_NODISCARD const ItemsSnapshot* itemsSnapshot() const noexcept;
+
         friend class BitAbstractArchiveOpener;
 
         friend class BitAbstractArchiveCreator;
@@ -227,6 +416,34 @@ class BitInputArchive {
         const BitInFormat* mDetectedFormat;
         const BitAbstractArchiveHandler& mArchiveHandler;
         tstring mArchivePath;
+        uint64_t mArchiveOffset{ 0 };
+        InputStreamMode mInputStreamMode{ InputStreamMode::Seekable };
+
+        // The archive's stream, if it can record its I/O statistics (nullptr otherwise).
+        IOStatsRecorder* mInStreamStats{ nullptr };
+
+        // Path -> item index map, lazily built on the first lookup by path (see pathIndex()).
+        mutable std::unordered_map< tstring, uint32_t > mPathIndex;
+        mutable std::once_flag mPathIndexFlag;
+
+        std::unique_ptr< ItemsSnapshot > mItemsSnapshot;
+
+        std::unique_ptr< SolidBlockCache > mSolidBlockCache;
+
+        // Properties supported by the format handler, lazily queried (see supportedItemProperties()).
+        mutable std::vector< BitProperty > mSupportedArchiveProperties;
+        mutable std::vector< BitProperty > mSupportedItemProperties;
+        mutable std::once_flag mSupportedPropertiesFlag;
+
+        void loadSupportedProperties() const;
+
+        bool loadSolidBlock( uint32_t index ) const;
+
+        /**
+         * @brief Throws a BitException if the archive was opened from a forward-only stream, hence its items
+         *        are not known until it is extracted.
+         */
+        void requireRandomAccess() const;
 
     public:
         /**
@@ -322,6 +539,10 @@ class BitInputArchive {
         /**
          * @brief Find an item in the archive that has the given path.
          *
+         * @note On the first call, an index of the paths of all the items in the archive is built,
+         * so that the subsequent lookups take constant time. If the archive contains multiple items
+         * with the same path, the one with the lowest index is returned.
+         *
          * @param path the path to be searched in the archive.
          *
          * @return an iterator to the item with the given path, or an iterator equal to the end() iterator
@@ -0,0 +1,86 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITITEMSARENA_HPP
+#define BITITEMSARENA_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief An entry of a BitItemsArena, describing where the path and the content of an extracted item are stored.
+ */
+struct BitArenaEntry {
+    uint32_t index;         ///< The index of the item in the archive.
+    std::size_t pathOffset; ///< The offset of the item path in the paths arena.
+    std::size_t pathSize;   ///< The length of the item path (excluding the null terminator).
+    uint64_t offset;        ///< The offset of the item content in the data arena.
+    uint64_t size;          ///< The size of the item content.
+    uint32_t crc;           ///< The CRC of the item as stored in the archive (0 if not available).
+};
+
+/**
+ * @brief The BitItemsArena class stores the content of many extracted items in a single contiguous buffer
+ * (the data arena), and their paths in a single string (the paths arena), together with a compact table
+ * of entries describing each item.
+ */
+class BitItemsArena final {
+    public:
+        /**
+         * @return the buffer containing the content of all the extracted items.
+         */
+        BIT7Z_NODISCARD const std::vector< byte_t >& data() const noexcept;
+
+        /**
+         * @return the entries describing the extracted items, in extraction order.
+         */
+        BIT7Z_NODISCARD const std::vector< BitArenaEntry >& entries() const noexcept;
+
+        /**
+         * @param entry an entry of this arena.
+         *
+         * @return the null-terminated path of the item described by the given entry.
+         */
+        BIT7Z_NODISCARD const tchar* path( const BitArenaEntry& entry ) const noexcept;
+
+        /**
+         * @param entry an entry of this arena.
+         *
+         * @return a pointer to the content of the item described by the given entry.
+         */
+        BIT7Z_NODISCARD const byte_t* content( const BitArenaEntry& entry ) const noexcept;
+
+        /**
+         * @brief Moves the data arena out of this object, leaving it empty (together with the paths and entries).
+         *
+         * @return the buffer containing the content of all the extracted items.
+         */
+        std::vector< byte_t > releaseData() noexcept;
+
+        /**
+         * @brief Removes all the items from the arena.
+         */
+        void clear() noexcept;
+
+    private:
+        std::vector< byte_t > mData;
+        tstring mPaths;
+        std::vector< BitArenaEntry > mEntries;
+
+        friend class ArenaExtractCallback;
+};
+
+}  // namespace bit7z
+
+#endif //BITITEMSARENA_HPP
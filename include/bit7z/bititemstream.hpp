@@ -0,0 +1,97 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITITEMSTREAM_HPP
+#define BITITEMSTREAM_HPP
+
+#include <cstdint>
+#include <ios>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+struct IInStream;
+struct IInArchive;
+
+namespace bit7z {
+
+class BitInputArchive;
+
+/**
+ * @brief The BitItemStream class allows reading the content of a single item of an archive at any offset.
+ *
+ * If the format handler of the archive provides a seekable stream for the item (e.g., tar, iso, wim, vhd, and
+ * uncompressed zip entries), the stream reads directly from the archive, and only the requested data is read.
+ * Otherwise, the item is decoded in memory when the stream is opened, and the reads are served from memory.
+ *
+ * @note A BitItemStream must not outlive the BitInputArchive object it was opened from, and it must not be used
+ * while the archive is being extracted.
+ */
+class BitItemStream final {
+    public:
+        BitItemStream( const BitItemStream& ) = delete;
+
+        BitItemStream( BitItemStream&& ) = delete;
+
+        BitItemStream& operator=( const BitItemStream& ) = delete;
+
+        BitItemStream& operator=( BitItemStream&& ) = delete;
+
+        ~BitItemStream();
+
+        /**
+         * @brief Reads at most size bytes from the current position of the stream.
+         *
+         * @param buffer    the buffer where to put the read data.
+         * @param size      the number of bytes to be read.
+         *
+         * @return the number of bytes actually read (less than size only if the end of the item was reached).
+         */
+        std::size_t read( byte_t* buffer, std::size_t size );
+
+        /**
+         * @brief Moves the current position of the stream.
+         *
+         * @param offset    the offset, relative to the given origin.
+         * @param origin    the origin of the seek operation.
+         *
+         * @return the new position in the stream.
+         */
+        uint64_t seek( int64_t offset, std::ios_base::seekdir origin = std::ios_base::beg );
+
+        /**
+         * @return the current position in the stream.
+         */
+        BIT7Z_NODISCARD uint64_t position() const;
+
+        /**
+         * @return the size of the item.
+         */
+        BIT7Z_NODISCARD uint64_t size() const noexcept;
+
+        /**
+         * @return true if the stream reads directly from the archive, false if it reads from the item decoded in memory.
+         */
+        BIT7Z_NODISCARD bool isDirect() const noexcept;
+
+    private:
+        IInStream* mStream;
+        std::vector< byte_t > mBuffer;
+        uint64_t mSize;
+        bool mIsDirect;
+
+        BitItemStream( const BitInputArchive& archive, IInArchive* in_archive, uint32_t index );
+
+        friend class BitInputArchive;
+};
+
+}  // namespace bit7z
+
+#endif //BITITEMSTREAM_HPP
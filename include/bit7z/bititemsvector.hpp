@@ -10,23 +10,31 @@
 #ifndef BITITEMSVECTOR_HPP
 #define BITITEMSVECTOR_HPP
 
+#include <iterator>
 #include <map>
 #include <memory>
 
 #include "bitfs.hpp"
+#include "bitgenericitem.hpp"
+#include "bitpropvariant.hpp"
 #include "bittypes.hpp"
 
+struct ISequentialInStream;
+
 namespace bit7z {
 
 using std::vector;
 using std::map;
 using std::unique_ptr;
+using std::shared_ptr;
 
 namespace filesystem {
 class FSItem;
+class FSItemsStore;
 } // namespace filesystem
 
 using filesystem::FSItem;
+using filesystem::FSItemsStore;
 
 struct GenericInputItem;
 using GenericInputItemPtr = std::unique_ptr< GenericInputItem >;
@@ -37,26 +45,82 @@ struct IndexingOptions {
     bool recursive = true;
     bool retain_folder_structure = false;
     bool only_files = false;
+    uint32_t threads = 1;
+    bool sort_entries = false; // Sort the entries of each directory by name (instead of the filesystem order).
 };
 /** @endcond **/
 
+class BitItemsVector;
+
+/**
+ * @brief The BitInputItem class represents an item of a BitItemsVector, but doesn't store its properties.
+ */
+class BitInputItem final : public BitGenericItem {
+    public:
+        BitInputItem& operator++() noexcept;
+
+        BitInputItem operator++( int ) noexcept; // NOLINT(cert-dcl21-cpp)
+
+        bool operator==( const BitInputItem& other ) const noexcept;
+
+        bool operator!=( const BitInputItem& other ) const noexcept;
+
+        /**
+         * @return the index of the item in the vector.
+         */
+        BIT7Z_NODISCARD std::size_t index() const noexcept;
+
+        BIT7Z_NODISCARD bool isDir() const override;
+
+        BIT7Z_NODISCARD uint64_t size() const override;
+
+        BIT7Z_NODISCARD tstring name() const override;
+
+        /**
+         * @return the path of the item on the filesystem (or the name of the buffer or stream).
+         */
+        BIT7Z_NODISCARD tstring path() const override;
+
+        /**
+         * @return the path of the item inside archives.
+         */
+        BIT7Z_NODISCARD fs::path inArchivePath() const;
+
+        BIT7Z_NODISCARD uint32_t attributes() const override;
+
+        BIT7Z_NODISCARD BitPropVariant itemProperty( BitProperty property ) const override;
+
+    private:
+        std::size_t mIndex;
+
+        // Note: a pointer, instead of a reference, allows this class (and BitItemsVector::const_iterator) to be copied.
+        const BitItemsVector* mItems;
+
+        BitInputItem( std::size_t index, const BitItemsVector& items ) noexcept;
+
+        friend class BitItemsVector;
+};
+
 /**
  * @brief The BitItemsVector class represents a vector of generic input items, i.e., items that can come
  * from the filesystem, from memory buffers, or from standard streams.
+ *
+ * @note Since the indexed files are kept in a compact store, the items are accessed through BitInputItem objects
+ * (e.g., when iterating the vector), which read the item properties from the store when requested.
  */
 class BitItemsVector final {
     public:
         using value_type = GenericInputItemPtr;
 
-        BitItemsVector() = default;
+        BitItemsVector();
 
-        BitItemsVector( const BitItemsVector& ) = default;
+        BitItemsVector( const BitItemsVector& other );
 
-        BitItemsVector( BitItemsVector&& ) = default;
+        BitItemsVector( BitItemsVector&& ) noexcept;
 
-        BitItemsVector& operator=( const BitItemsVector& ) = default;
+        BitItemsVector& operator=( const BitItemsVector& other );
 
-        BitItemsVector& operator=( BitItemsVector&& ) = default;
+        BitItemsVector& operator=( BitItemsVector&& ) noexcept;
 
         /**
          * @brief Indexes the given directory, adding to the vector all the files that match the wildcard filter.
@@ -124,40 +188,136 @@ class BitItemsVector final {
 
         /**
          * @param index the index of the desired item in the vector.
-         * @return a constant reference to the GenericInputItem at the given index.
+         * @return the path of the item on the filesystem (or the name of the buffer or stream).
+         */
+        BIT7Z_NODISCARD tstring itemPath( std::size_t index ) const;
+
+        /**
+         * @param index the index of the desired item in the vector.
+         * @return the path of the item inside archives.
+         */
+        BIT7Z_NODISCARD fs::path inArchivePath( std::size_t index ) const;
+
+        /**
+         * @param index the index of the desired item in the vector.
+         * @return the size of the item.
+         */
+        BIT7Z_NODISCARD uint64_t itemSize( std::size_t index ) const;
+
+        /**
+         * @param index     the index of the desired item in the vector.
+         * @param property  the property to be retrieved.
+         * @return the value of the property of the item (empty if the item doesn't have it).
+         */
+        BIT7Z_NODISCARD BitPropVariant itemProperty( std::size_t index, BitProperty property ) const;
+
+        /**
+         * @brief Opens an input stream for reading the content of the item at the given index.
+         *
+         * @param index     the index of the desired item in the vector.
+         * @param inStream  the output parameter where the stream is returned (unchanged for directories).
+         * @return the result of the operation.
+         */
+        BIT7Z_NODISCARD HRESULT itemStream( std::size_t index, ISequentialInStream** inStream ) const;
+
+        /**
+         * @param index the index of the desired item in the vector.
+         * @return the item at the given index.
+         */
+        BIT7Z_NODISCARD BitInputItem operator[]( std::size_t index ) const noexcept;
+
+        /**
+         * @brief A read-only iterator for the items of the vector.
          */
-        const GenericInputItem& operator[]( GenericInputItemVector::size_type index ) const;
+        class const_iterator {
+            public:
+                // iterator traits
+                using iterator_category BIT7Z_MAYBE_UNUSED = std::input_iterator_tag;
+                using value_type BIT7Z_MAYBE_UNUSED = BitInputItem;
+                using reference = const BitInputItem&;
+                using pointer = const BitInputItem*;
+                using difference_type BIT7Z_MAYBE_UNUSED = std::ptrdiff_t;
+
+                /**
+                 * @brief Advances the iterator to the next item in the vector.
+                 *
+                 * @return the iterator pointing to the next item in the vector.
+                 */
+                const_iterator& operator++() noexcept;
+
+                /**
+                 * @brief Advances the iterator to the next item in the vector.
+                 *
+                 * @return the iterator before the advancement.
+                 */
+                const_iterator operator++( int ) noexcept; // NOLINT(cert-dcl21-cpp)
+
+                bool operator==( const const_iterator& other ) const noexcept;
+
+                bool operator!=( const const_iterator& other ) const noexcept;
+
+                /**
+                 * @return a reference to the pointed-to item.
+                 */
+                reference operator*() const noexcept;
+
+                /**
+                 * @return a pointer to the pointed-to item.
+                 */
+                pointer operator->() const noexcept;
+
+            private:
+                BitInputItem mItem;
+
+                explicit const_iterator( BitInputItem item ) noexcept;
+
+                friend class BitItemsVector;
+        };
 
         /**
-         * @return an iterator to the first element of the vector. If the vector is empty,
+         * @return an iterator to the first item of the vector. If the vector is empty,
          *         the returned iterator will be equal to the end() iterator.
          */
-        BIT7Z_NODISCARD GenericInputItemVector::const_iterator begin() const noexcept;
+        BIT7Z_NODISCARD const_iterator begin() const noexcept;
 
         /**
-         * @return an iterator to the element following the last element of the vector.
-         *         This element acts as a placeholder; attempting to access it results in undefined behavior.
+         * @return an iterator to the element following the last item of the vector.
          */
-        BIT7Z_NODISCARD GenericInputItemVector::const_iterator end() const noexcept;
+        BIT7Z_NODISCARD const_iterator end() const noexcept;
 
         /**
-         * @return an iterator to the first element of the vector. If the vector is empty,
+         * @return an iterator to the first item of the vector. If the vector is empty,
          *         the returned iterator will be equal to the end() iterator.
          */
-        BIT7Z_NODISCARD GenericInputItemVector::const_iterator cbegin() const noexcept;
+        BIT7Z_NODISCARD const_iterator cbegin() const noexcept;
 
         /**
-         * @return an iterator to the element following the last element of the vector.
-         *         This element acts as a placeholder; attempting to access it results in undefined behavior.
+         * @return an iterator to the element following the last item of the vector.
          */
-        BIT7Z_NODISCARD GenericInputItemVector::const_iterator cend() const noexcept;
+        BIT7Z_NODISCARD const_iterator cend() const noexcept;
 
         ~BitItemsVector();
 
     private:
-        GenericInputItemVector mItems;
+        /* Note: the items found while indexing directories (possibly millions) are kept in a compact store,
+         *       while all the other items (e.g., buffers, streams, and files given by the user) are stored
+         *       as generic items, along with their position among all the items.
+         *       Generic items are never modified once added, so copies of the vector share them. */
+        std::vector< shared_ptr< const GenericInputItem > > mItems;
+        std::vector< std::size_t > mItemsPositions;
+        unique_ptr< FSItemsStore > mIndexedItems;
 
         void indexItem( const FSItem& item, IndexingOptions options );
+
+        void addItem( GenericInputItemPtr item );
+
+        FSItemsStore& indexedItems();
+
+        /**
+         * @return the generic item at the given index, or nullptr if the item is in the compact store
+         *         (in which case, indexed_item is set to the index of the item in the store).
+         */
+        const GenericInputItem* genericItem( std::size_t index, std::size_t& indexed_item ) const;
 };
 
 }  // namespace bit7z
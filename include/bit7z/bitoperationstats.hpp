@@ -0,0 +1,57 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITOPERATIONSTATS_HPP
+#define BITOPERATIONSTATS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace bit7z {
+
+/**
+ * @brief The number of buckets of the seek distance histogram of a BitOperationStats object.
+ */
+constexpr std::size_t kSeekDistanceBuckets = 6;
+
+/**
+ * @brief The I/O statistics of the streams used by an extraction, test, or compression operation.
+ *
+ * The statistics include both the archive stream and the streams of the single items
+ * (e.g., the output files of an extraction, or the input files of a compression).
+ *
+ * @note Multi-volume archives are accounted as a single stream: the accesses to the single volume files
+ * are not counted separately.
+ */
+struct BitOperationStats {
+    uint64_t readCalls = 0; ///< The number of Read calls.
+    uint64_t readBytes = 0; ///< The number of bytes read.
+    std::chrono::nanoseconds readTime{ 0 }; ///< The total time spent reading.
+
+    uint64_t writeCalls = 0; ///< The number of Write calls.
+    uint64_t writeBytes = 0; ///< The number of bytes written.
+    std::chrono::nanoseconds writeTime{ 0 }; ///< The total time spent writing.
+
+    uint64_t seekCalls = 0; ///< The number of Seek calls.
+    std::chrono::nanoseconds seekTime{ 0 }; ///< The total time spent seeking.
+
+    /**
+     * @brief Histogram of the distances (in bytes) between the stream position before and after each Seek call.
+     *
+     * The buckets are, in order: 0 (no movement), up to 4 KiB, up to 64 KiB, up to 1 MiB, up to 16 MiB,
+     * and more than 16 MiB.
+     */
+    std::array< uint64_t, kSeekDistanceBuckets > seekDistances{};
+};
+
+}  // namespace bit7z
+
+#endif //BITOPERATIONSTATS_HPP
@@ -0,0 +1,104 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITPROGRESSMONITOR_HPP
+#define BITPROGRESSMONITOR_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "bitdefines.hpp"
+
+namespace bit7z {
+
+class Callback;
+class ParallelExtractionState;
+
+/**
+ * @brief A set of atomic counters describing the progress of the ongoing operation of an archive handler.
+ *
+ * The counters are updated by the handler while extracting or compressing, and they can be read from any
+ * thread without locks and without the need of setting any callback.
+ * Copies of a monitor share the same counters: a copy of the monitor of a handler (see
+ * BitAbstractArchiveHandler::progressMonitor) can be polled, e.g., by a UI thread.
+ *
+ * @note The counters are reset at the beginning of each operation; each counter is read independently,
+ * so two values read one after the other might belong to slightly different moments of the operation.
+ */
+class BitProgressMonitor final {
+    public:
+        /**
+         * @brief Constructs a new monitor, with all the counters set to zero.
+         */
+        BitProgressMonitor();
+
+        /**
+         * @return the total size (in bytes) of the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t totalSize() const noexcept;
+
+        /**
+         * @return the size (in bytes) processed so far by the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t processedSize() const noexcept;
+
+        /**
+         * @return the number of items to be processed by the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t totalItems() const noexcept;
+
+        /**
+         * @return the number of items processed so far by the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t processedItems() const noexcept;
+
+        /**
+         * @return the index of the item currently being processed.
+         */
+        BIT7Z_NODISCARD uint32_t currentItem() const noexcept;
+
+        /**
+         * @return the input size (in bytes) processed so far by the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t inputSize() const noexcept;
+
+        /**
+         * @return the output size (in bytes) produced so far by the ongoing operation.
+         */
+        BIT7Z_NODISCARD uint64_t outputSize() const noexcept;
+
+    private:
+        struct Counters;
+
+        std::shared_ptr< Counters > mCounters;
+
+        // The counters can be updated only by the library's callbacks.
+        friend class Callback;
+        friend class ParallelExtractionState;
+
+        void reset( uint64_t total_items ) const noexcept;
+
+        void setTotalSize( uint64_t total_size ) const noexcept;
+
+        void setProcessedSize( uint64_t processed_size ) const noexcept;
+
+        void setProcessedItems( uint64_t processed_items ) const noexcept;
+
+        void addProcessed( uint64_t processed_size, uint64_t processed_items ) const noexcept;
+
+        void setCurrentItem( uint32_t index ) const noexcept;
+
+        void itemCompleted() const noexcept;
+
+        void setRatioInfo( uint64_t input_size, uint64_t output_size ) const noexcept;
+};
+
+}  // namespace bit7z
+
+#endif //BITPROGRESSMONITOR_HPP
@@ -0,0 +1,42 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BITTRACE_HPP
+#define BITTRACE_HPP
+
+#ifdef BIT7Z_ENABLE_TRACING
+
+#include <ostream>
+
+namespace bit7z {
+
+/**
+ * @brief Writes the spans recorded so far (e.g., opening the archive, creating the output files,
+ * extracting each item, reading and writing the streams) as a Chrome trace-event JSON document,
+ * which can be loaded in chrome://tracing or Perfetto.
+ *
+ * @note Available only when bit7z is compiled with the `BIT7Z_ENABLE_TRACING` option.
+ * Each thread keeps only its most recent spans (the oldest are overwritten).
+ *
+ * @param out   the output stream where the JSON document is written.
+ */
+void writeChromeTrace( std::ostream& out );
+
+/**
+ * @brief Discards the spans recorded so far by all the threads.
+ *
+ * @note Available only when bit7z is compiled with the `BIT7Z_ENABLE_TRACING` option.
+ */
+void clearTrace();
+
+}  // namespace bit7z
+
+#endif
+
+#endif //BITTRACE_HPP
@@ -12,6 +12,9 @@
 
 #include "bitabstractarchivecreator.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include "biterror.hpp"
 #include "bitexception.hpp"
 #include "internal/archiveproperties.hpp"
@@ -123,7 +126,9 @@ BitAbstractArchiveCreator::BitAbstractArchiveCreator( const Bit7zLibrary& lib,
       mCryptHeaders( false ),
       mSolidMode( false ),
       mVolumeSize( 0 ),
-      mThreadsCount( 0 ) {
+      mThreadsCount( 0 ),
+      mIndexingThreads( 1 ),
+      mSortedIndexing( false ) {
     setRetainDirectories( false );
 }
 
@@ -171,6 +176,14 @@ uint32_t BitAbstractArchiveCreator::threadsCount() const noexcept {
     return mThreadsCount;
 }
 
+uint32_t BitAbstractArchiveCreator::indexingThreads() const noexcept {
+    return mIndexingThreads;
+}
+
+bool BitAbstractArchiveCreator::sortedIndexing() const noexcept {
+    return mSortedIndexing;
+}
+
 void BitAbstractArchiveCreator::setPassword( const tstring& password ) {
     setPassword( password, mCryptHeaders );
 }
@@ -244,6 +257,18 @@ void BitAbstractArchiveCreator::setThreadsCount( uint32_t threads_count ) noexce
     mThreadsCount = threads_count;
 }
 
+void BitAbstractArchiveCreator::setIndexingThreads( uint32_t threads_count ) noexcept {
+    if ( threads_count == 0 ) {
+        // Note: hardware_concurrency() may return 0 if the value is not computable.
+        threads_count = std::max( std::thread::hardware_concurrency(), 1u );
+    }
+    mIndexingThreads = threads_count;
+}
+
+void BitAbstractArchiveCreator::setSortedIndexing( bool sorted ) noexcept {
+    mSortedIndexing = sorted;
+}
+
 const wchar_t* dictionaryPropertyName( const BitInOutFormat& format, BitCompressionMethod method ) {
     if ( format == BitFormat::SevenZip ) {
         return ( method == BitCompressionMethod::Ppmd ? L"0mem" : L"0d" );
@@ -38,30 +38,42 @@ bool BitAbstractArchiveHandler::isPasswordDefined() const noexcept {
     return !mPassword.empty();
 }
 
-TotalCallback BitAbstractArchiveHandler::totalCallback() const {
+const TotalCallback& BitAbstractArchiveHandler::totalCallback() const noexcept {
     return mTotalCallback;
 }
 
-ProgressCallback BitAbstractArchiveHandler::progressCallback() const {
+const ProgressCallback& BitAbstractArchiveHandler::progressCallback() const noexcept {
     return mProgressCallback;
 }
 
-RatioCallback BitAbstractArchiveHandler::ratioCallback() const {
+const RatioCallback& BitAbstractArchiveHandler::ratioCallback() const noexcept {
     return mRatioCallback;
 }
 
-FileCallback BitAbstractArchiveHandler::fileCallback() const {
+const FileCallback& BitAbstractArchiveHandler::fileCallback() const noexcept {
     return mFileCallback;
 }
 
-PasswordCallback BitAbstractArchiveHandler::passwordCallback() const {
+const PasswordCallback& BitAbstractArchiveHandler::passwordCallback() const noexcept {
     return mPasswordCallback;
 }
 
+const OperationStatsCallback& BitAbstractArchiveHandler::operationStatsCallback() const noexcept {
+    return mOperationStatsCallback;
+}
+
 OverwriteMode BitAbstractArchiveHandler::overwriteMode() const {
     return mOverwriteMode;
 }
 
+const BitCancellationToken& BitAbstractArchiveHandler::cancellationToken() const noexcept {
+    return mCancellationToken;
+}
+
+const BitProgressMonitor& BitAbstractArchiveHandler::progressMonitor() const noexcept {
+    return mProgressMonitor;
+}
+
 void BitAbstractArchiveHandler::setPassword( const tstring& password ) {
     mPassword = password;
 }
@@ -94,6 +106,18 @@ void BitAbstractArchiveHandler::setPasswordCallback( const PasswordCallback& cal
     mPasswordCallback = callback;
 }
 
+void BitAbstractArchiveHandler::setOperationStatsCallback( const OperationStatsCallback& callback ) {
+    mOperationStatsCallback = callback;
+}
+
 void BitAbstractArchiveHandler::setOverwriteMode( OverwriteMode mode ) {
     mOverwriteMode = mode;
 }
+
+void BitAbstractArchiveHandler::setCancellationToken( const BitCancellationToken& token ) {
+    mCancellationToken = token;
+}
+
+void BitAbstractArchiveHandler::setProgressMonitor( const BitProgressMonitor& monitor ) {
+    mProgressMonitor = monitor;
+}
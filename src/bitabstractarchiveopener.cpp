@@ -12,12 +12,15 @@
 
 #include "bitabstractarchiveopener.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using namespace bit7z;
 
 BitAbstractArchiveOpener::BitAbstractArchiveOpener( const Bit7zLibrary& lib,
                                                     const BitInFormat& format,
                                                     const tstring& password )
-    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite }, mFormat{ format } {}
+    : BitAbstractArchiveHandler{ lib, password, OverwriteMode::Overwrite }, mFormat{ format }, mExtractionThreads{ 1 } {}
 
 const BitInFormat& BitAbstractArchiveOpener::format() const noexcept {
     return mFormat;
@@ -26,3 +29,15 @@ const BitInFormat& BitAbstractArchiveOpener::format() const noexcept {
 const BitInFormat& BitAbstractArchiveOpener::extractionFormat() const noexcept {
     return mFormat;
 }
+
+uint32_t BitAbstractArchiveOpener::extractionThreads() const noexcept {
+    return mExtractionThreads;
+}
+
+void BitAbstractArchiveOpener::setExtractionThreads( uint32_t threads_count ) noexcept {
+    if ( threads_count == 0 ) {
+        // Note: hardware_concurrency() may return 0 if the value is not computable.
+        threads_count = std::max( std::thread::hardware_concurrency(), 1u );
+    }
+    mExtractionThreads = threads_count;
+}
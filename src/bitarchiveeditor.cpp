@@ -98,18 +98,13 @@ void BitArchiveEditor::deleteItem( uint32_t index ) {
 }
 
 void BitArchiveEditor::deleteItem( const tstring& item_path ) {
-    auto res = std::find_if( inputArchive()->cbegin(), inputArchive()->cend(), [ & ]( const auto& archiveItem ) {
-        if ( archiveItem.path() == item_path ) {
-            mEditedItems.erase( archiveItem.index() );
-            setDeletedIndex( archiveItem.index() );
-            return true;
-        }
-        return false;
-    } );
-    if ( res == inputArchive()->cend() ) {
+    auto archive_item = inputArchive()->find( item_path );
+    if ( archive_item == inputArchive()->cend() ) {
         throw BitException( "Could not mark the item as deleted",
                             std::make_error_code( std::errc::no_such_file_or_directory ), item_path );
     }
+    mEditedItems.erase( archive_item->index() );
+    setDeletedIndex( archive_item->index() );
 }
 
 void BitArchiveEditor::setUpdateMode( UpdateMode mode ) {
@@ -128,6 +123,7 @@ void BitArchiveEditor::applyChanges() {
     auto archive_path = inputArchive()->archivePath();
     compressTo( archive_path );
     mEditedItems.clear();
+    // Note: the new input archive starts with an empty path index, so the one of the old archive is discarded.
     setInputArchive( std::make_unique< BitInputArchive >( *this, archive_path ) );
 }
 
@@ -15,7 +15,7 @@
 #include <algorithm>
 #include <numeric>
 
-#include <7zip/PropID.h>
+#include "internal/itemssnapshot.hpp"
 
 using namespace bit7z;
 
@@ -25,6 +25,13 @@ BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
                                     const tstring& password )
     : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, in_archive ) {}
 
+BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
+                                    const tstring& in_archive,
+                                    uint64_t offset,
+                                    const BitInFormat& format,
+                                    const tstring& password )
+    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, in_archive, offset ) {}
+
 BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
                                     const std::vector< byte_t >& in_archive,
                                     const BitInFormat& format,
@@ -37,11 +44,16 @@ BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
                                     const tstring& password )
     : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, in_archive ) {}
 
+BitArchiveReader::BitArchiveReader( const Bit7zLibrary& lib,
+                                    std::istream& in_archive,
+                                    InputStreamMode mode,
+                                    const BitInFormat& format,
+                                    const tstring& password )
+    : BitAbstractArchiveOpener( lib, format, password ), BitInputArchive( *this, in_archive, mode ) {}
+
 map< BitProperty, BitPropVariant > BitArchiveReader::archiveProperties() const {
     map< BitProperty, BitPropVariant > result;
-    for ( uint32_t i = kpidNoProperty; i <= kpidCopyLink; ++i ) {
-        // Yeah, I know, I cast property twice (here and in archiveProperty), but the code is easier to read!
-        const auto property = static_cast< BitProperty >( i );
+    for ( const auto property : supportedArchiveProperties() ) {
         const BitPropVariant property_value = archiveProperty( property );
         if ( !property_value.isEmpty() ) {
             result[ property ] = property_value;
@@ -51,12 +63,24 @@ map< BitProperty, BitPropVariant > BitArchiveReader::archiveProperties() const {
 }
 
 vector< BitArchiveItemInfo > BitArchiveReader::items() const {
+    return items( supportedItemProperties() );
+}
+
+vector< BitArchiveItemInfo > BitArchiveReader::items( const vector< BitProperty >& properties_mask ) const {
+    const auto& supported_properties = supportedItemProperties();
+    vector< BitProperty > properties;
+    for ( const auto property : properties_mask ) {
+        if ( std::binary_search( supported_properties.cbegin(), supported_properties.cend(), property ) ) {
+            properties.push_back( property );
+        }
+    }
+
+    const uint32_t items_count = itemsCount();
     vector< BitArchiveItemInfo > result;
-    for ( uint32_t i = 0; i < itemsCount(); ++i ) {
+    result.reserve( items_count );
+    for ( uint32_t i = 0; i < items_count; ++i ) {
         BitArchiveItemInfo item( i );
-        for ( uint32_t j = kpidNoProperty; j <= kpidCopyLink; ++j ) {
-            // Yeah, I know, I cast property twice (here and in itemProperty), but the code is easier to read!
-            const auto property = static_cast< BitProperty >( j );
+        for ( const auto property : properties ) {
             const auto property_value = itemProperty( i, property );
             if ( !property_value.isEmpty() ) {
                 item.setProperty( property, property_value );
@@ -68,6 +92,10 @@ vector< BitArchiveItemInfo > BitArchiveReader::items() const {
 }
 
 uint32_t BitArchiveReader::foldersCount() const {
+    const ItemsSnapshot* snapshot = itemsSnapshot();
+    if ( snapshot != nullptr ) {
+        return snapshot->foldersCount();
+    }
     return std::count_if( cbegin(), cend(), []( const BitArchiveItem& item ) {
         return item.isDir();
     } );
@@ -78,12 +106,20 @@ uint32_t BitArchiveReader::filesCount() const {
 }
 
 uint64_t BitArchiveReader::size() const {
+    const ItemsSnapshot* snapshot = itemsSnapshot();
+    if ( snapshot != nullptr ) {
+        return snapshot->totalSize();
+    }
     return std::accumulate( cbegin(), cend(), 0ull, []( uint64_t accumulator, const BitArchiveItem& item ) {
         return item.isDir() ? accumulator : accumulator + item.size();
     } );
 }
 
 uint64_t BitArchiveReader::packSize() const {
+    const ItemsSnapshot* snapshot = itemsSnapshot();
+    if ( snapshot != nullptr ) {
+        return snapshot->totalPackSize();
+    }
     return std::accumulate( cbegin(), cend(), 0ull, []( uint64_t accumulator, const BitArchiveItem& item ) {
         return item.isDir() ? accumulator : accumulator + item.packSize();
     } );
@@ -92,6 +128,10 @@ uint64_t BitArchiveReader::packSize() const {
 bool BitArchiveReader::hasEncryptedItems() const {
     /* Note: simple encryption (i.e., not including the archive headers) can be detected only reading
      *       the properties of the files in the archive, so we search for any encrypted file inside the archive! */
+    const ItemsSnapshot* snapshot = itemsSnapshot();
+    if ( snapshot != nullptr ) {
+        return snapshot->hasEncryptedItems();
+    }
     return std::any_of( cbegin(), cend(), []( const BitArchiveItem& item ) {
         return !item.isDir() && item.isEncrypted();
     } );
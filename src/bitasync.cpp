@@ -0,0 +1,29 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitasync.hpp"
+
+#include <memory>
+
+std::future< void > bit7z::runAsync( const BitExecutor& executor, std::function< void() > task ) {
+    if ( !executor ) {
+        return std::async( std::launch::async, std::move( task ) );
+    }
+
+    // Note: std::function requires a copyable callable, so the (move-only) packaged task is shared.
+    auto packaged_task = std::make_shared< std::packaged_task< void() > >( std::move( task ) );
+    std::future< void > result = packaged_task->get_future();
+    executor( [ packaged_task ]() {
+        ( *packaged_task )();
+    } );
+    return result;
+}
@@ -0,0 +1,29 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitcancellationtoken.hpp"
+
+using namespace bit7z;
+
+BitCancellationToken::BitCancellationToken() : mCancelled{ std::make_shared< std::atomic< bool > >( false ) } {}
+
+void BitCancellationToken::cancel() const noexcept {
+    mCancelled->store( true, std::memory_order_relaxed );
+}
+
+bool BitCancellationToken::isCancelled() const noexcept {
+    return mCancelled->load( std::memory_order_relaxed );
+}
+
+void BitCancellationToken::reset() const noexcept {
+    mCancelled->store( false, std::memory_order_relaxed );
+}
@@ -0,0 +1,288 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef BIT7Z_AUTO_FORMAT
+
+#include "bitformatprober.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "bitexception.hpp"
+#include "internal/formatdetect.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/windows.hpp"
+
+using namespace bit7z;
+
+namespace {
+BitProbeConfidence signature_confidence( uint32_t signature_size ) noexcept {
+    constexpr auto kMaxLowSignatureSize = 2U;
+    constexpr auto kMaxMediumSignatureSize = 4U;
+    if ( signature_size <= kMaxLowSignatureSize ) {
+        return BitProbeConfidence::Low;
+    }
+    return signature_size <= kMaxMediumSignatureSize ? BitProbeConfidence::Medium : BitProbeConfidence::High;
+}
+
+// Reads (at most) the first size bytes of the given file using a single positional read.
+std::size_t read_file_prefix( fs::path file_path, byte_t* buffer, std::size_t size ) {
+#ifdef _WIN32
+#ifdef BIT7Z_AUTO_PREFIX_LONG_PATHS
+    if ( filesystem::fsutil::should_format_long_path( file_path ) ) {
+        file_path = filesystem::fsutil::format_long_path( file_path );
+    }
+#endif
+    HANDLE file = CreateFileW( file_path.c_str(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr );
+    if ( file == INVALID_HANDLE_VALUE ) {
+        throw BitException( "Failed to open the file", last_error_code(), file_path.string< tchar >() );
+    }
+    DWORD read_size = 0;
+    const BOOL result = ReadFile( file, buffer, static_cast< DWORD >( size ), &read_size, nullptr );
+    const auto error = last_error_code();
+    CloseHandle( file );
+    if ( result == FALSE ) {
+        throw BitException( "Failed to read the file", error, file_path.string< tchar >() );
+    }
+    return read_size;
+#else
+    const int file = open( file_path.c_str(), O_RDONLY | O_CLOEXEC ); // NOLINT(*-vararg)
+    if ( file < 0 ) {
+        throw BitException( "Failed to open the file", last_error_code(), file_path.string< tchar >() );
+    }
+    const ssize_t read_size = pread( file, buffer, size, 0 );
+    const auto error = last_error_code();
+    close( file );
+    if ( read_size < 0 ) {
+        throw BitException( "Failed to read the file", error, file_path.string< tchar >() );
+    }
+    return static_cast< std::size_t >( read_size );
+#endif
+}
+
+// Scans the positions [begin, end) of the given file, reading it in chunks.
+void scan_file_range( const fs::path& file_path,
+                      uint64_t file_size,
+                      uint64_t begin,
+                      uint64_t end,
+                      std::vector< SignatureCandidate >& candidates ) {
+    constexpr std::size_t kScanChunkSize = 1024 * 1024;
+
+    // Each chunk is read together with the few following bytes needed for checking the signatures
+    // starting at the end of the chunk.
+    const SignatureScanner scanner{};
+    std::vector< byte_t > chunk( kScanChunkSize + SignatureScanner::maxSignatureSize() - 1 );
+
+    fs::ifstream file_stream;
+    file_stream.rdbuf()->pubsetbuf( nullptr, 0 ); // Chunks are read directly into our buffer.
+    file_stream.open( file_path, std::ios::in | std::ios::binary );
+    if ( file_stream.fail() ) {
+        throw BitException( "Failed to open the file",
+                            make_hresult_code( HRESULT_FROM_WIN32( ERROR_OPEN_FAILED ) ),
+                            file_path.string< tchar >() );
+    }
+
+    for ( uint64_t position = begin; position < end; position += kScanChunkSize ) {
+        const auto read_size = static_cast< std::size_t >( std::min< uint64_t >( chunk.size(), file_size - position ) );
+        file_stream.seekg( static_cast< std::streamoff >( position ) );
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        file_stream.read( reinterpret_cast< char* >( chunk.data() ), static_cast< std::streamsize >( read_size ) );
+        if ( file_stream.gcount() != static_cast< std::streamsize >( read_size ) ) {
+            throw BitException( "Failed to read the file",
+                                make_hresult_code( HRESULT_FROM_WIN32( ERROR_READ_FAULT ) ),
+                                file_path.string< tchar >() );
+        }
+        const auto scan_size = static_cast< std::size_t >( std::min< uint64_t >( kScanChunkSize, end - position ) );
+        scanner.scan( chunk.data(), read_size, scan_size, position, candidates );
+    }
+}
+
+std::vector< BitEmbeddedArchive > to_embedded_archives( std::vector< SignatureCandidate >& candidates ) {
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      []( const SignatureCandidate& first, const SignatureCandidate& second ) {
+                          return first.offset < second.offset;
+                      } );
+    std::vector< BitEmbeddedArchive > result;
+    result.reserve( candidates.size() );
+    for ( const auto& candidate : candidates ) {
+        result.emplace_back( candidate.offset, *candidate.format );
+    }
+    return result;
+}
+} // namespace
+
+BitEmbeddedArchive::BitEmbeddedArchive( uint64_t offset, const BitInFormat& format ) noexcept
+    : mOffset{ offset }, mFormat{ &format } {}
+
+uint64_t BitEmbeddedArchive::offset() const noexcept {
+    return mOffset;
+}
+
+const BitInFormat& BitEmbeddedArchive::format() const noexcept {
+    return *mFormat;
+}
+
+BitProbeResult::BitProbeResult() noexcept
+    : mFormat{ &BitFormat::Auto }, mConfidence{ BitProbeConfidence::None } {}
+
+BitProbeResult::BitProbeResult( const BitInFormat& format, BitProbeConfidence confidence ) noexcept
+    : mFormat{ &format }, mConfidence{ confidence } {}
+
+const BitInFormat& BitProbeResult::format() const noexcept {
+    return *mFormat;
+}
+
+BitProbeConfidence BitProbeResult::confidence() const noexcept {
+    return mConfidence;
+}
+
+bool BitProbeResult::detected() const noexcept {
+    return mConfidence != BitProbeConfidence::None;
+}
+
+BitFormatProber::BitFormatProber( uint32_t threads_count ) noexcept
+    // Note: hardware_concurrency() may return 0 if the value is not computable.
+    : mThreadsCount{ threads_count != 0 ? threads_count : std::max( std::thread::hardware_concurrency(), 1u ) } {}
+
+uint32_t BitFormatProber::threadsCount() const noexcept {
+    return mThreadsCount;
+}
+
+BitProbeResult BitFormatProber::probe( const tstring& in_file ) const {
+    std::vector< byte_t > window( kSignatureWindowSize );
+    const std::size_t window_size = read_file_prefix( fs::path{ in_file }, window.data(), window.size() );
+    return probe( window.data(), window_size );
+}
+
+BitProbeResult BitFormatProber::probe( const byte_t* data, std::size_t size ) const noexcept {
+    uint32_t signature_size = 0;
+    const BitInFormat* format = detectFormatFromBuffer( data, size, signature_size );
+    if ( format == nullptr ) {
+        return {};
+    }
+    return { *format, signature_confidence( signature_size ) };
+}
+
+std::vector< BitProbeResult > BitFormatProber::probe( const std::vector< tstring >& in_files ) const {
+    std::vector< BitProbeResult > results( in_files.size() );
+    std::atomic< std::size_t > next_file{ 0 };
+
+    // Each worker takes the next file to be probed, reusing the same window buffer for all its files.
+    auto run_worker = [ & ]() {
+        std::vector< byte_t > window( kSignatureWindowSize );
+        for ( std::size_t file_index = next_file++; file_index < in_files.size(); file_index = next_file++ ) {
+            try {
+                const std::size_t window_size = read_file_prefix( fs::path{ in_files[ file_index ] },
+                                                                  window.data(),
+                                                                  window.size() );
+                results[ file_index ] = probe( window.data(), window_size );
+            } catch ( const BitException& ) {
+                results[ file_index ] = BitProbeResult{};
+            }
+        }
+    };
+
+    const auto workers_count = std::min< std::size_t >( mThreadsCount, in_files.size() );
+    std::vector< std::thread > workers;
+    if ( workers_count > 1 ) {
+        workers.reserve( workers_count - 1 );
+        try {
+            for ( std::size_t worker_index = 1; worker_index < workers_count; ++worker_index ) {
+                workers.emplace_back( run_worker );
+            }
+        } catch ( const std::system_error& ) {
+            // Could not create more threads: the files will be probed by the workers already running.
+        }
+    }
+    run_worker(); // The calling thread is a worker too.
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+    return results;
+}
+
+std::vector< BitEmbeddedArchive > BitFormatProber::scan( const tstring& in_file ) const {
+    const fs::path file_path{ in_file };
+    std::error_code error;
+    const uint64_t file_size = fs::file_size( file_path, error );
+    if ( error ) {
+        throw BitException( "Failed to get the size of the file", error, in_file );
+    }
+
+    // Small files are not worth splitting among many threads.
+    constexpr uint64_t kMinRangeSize = 16 * 1024 * 1024;
+    const auto workers_count = static_cast< std::size_t >(
+        std::max< uint64_t >( std::min< uint64_t >( mThreadsCount, file_size / kMinRangeSize ), 1 )
+    );
+    const uint64_t range_size = ( file_size + workers_count - 1 ) / workers_count;
+
+    std::vector< std::vector< SignatureCandidate > > workers_candidates( workers_count );
+    std::vector< std::exception_ptr > workers_errors( workers_count );
+    auto run_worker = [ & ]( std::size_t worker_index ) {
+        try {
+            const uint64_t begin = worker_index * range_size;
+            const uint64_t end = std::min( begin + range_size, file_size );
+            scan_file_range( file_path, file_size, begin, end, workers_candidates[ worker_index ] );
+        } catch ( ... ) {
+            workers_errors[ worker_index ] = std::current_exception();
+        }
+    };
+
+    std::vector< std::thread > workers;
+    workers.reserve( workers_count - 1 );
+    try {
+        for ( std::size_t worker_index = 1; worker_index < workers_count; ++worker_index ) {
+            workers.emplace_back( run_worker, worker_index );
+        }
+    } catch ( const std::system_error& ) {
+        // Could not create more threads: the remaining ranges are scanned by the calling thread.
+    }
+    run_worker( 0 );
+    for ( std::size_t worker_index = workers.size() + 1; worker_index < workers_count; ++worker_index ) {
+        run_worker( worker_index );
+    }
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+
+    std::vector< SignatureCandidate > candidates;
+    for ( std::size_t worker_index = 0; worker_index < workers_count; ++worker_index ) {
+        if ( workers_errors[ worker_index ] ) {
+            std::rethrow_exception( workers_errors[ worker_index ] );
+        }
+        candidates.insert( candidates.end(),
+                           workers_candidates[ worker_index ].cbegin(),
+                           workers_candidates[ worker_index ].cend() );
+    }
+    return to_embedded_archives( candidates );
+}
+
+std::vector< BitEmbeddedArchive > BitFormatProber::scan( const byte_t* data, std::size_t size ) const {
+    std::vector< SignatureCandidate > candidates;
+    SignatureScanner{}.scan( data, size, size, 0, candidates );
+    return to_embedded_archives( candidates );
+}
+
+#endif
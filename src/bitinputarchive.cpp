@@ -16,14 +16,33 @@
 
 #include "bitinputarchive.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <7zip/PropID.h>
+
+#include "bitabstractarchiveopener.hpp"
 #include "biterror.hpp"
 #include "bitexception.hpp"
+#include "internal/arenaextractcallback.hpp"
+#include "internal/blockbufferextractcallback.hpp"
 #include "internal/bufferextractcallback.hpp"
 #include "internal/cbufferinstream.hpp"
-#include "internal/cfileinstream.hpp"
+#include "internal/clookaheadinstream.hpp"
+#include "internal/cmappedinstream.hpp"
+#include "internal/csubinstream.hpp"
 #include "internal/fileextractcallback.hpp"
 #include "internal/fixedbufferextractcallback.hpp"
+#include "internal/iostats.hpp"
+#include "internal/itemproperties.hpp"
+#include "internal/itemssnapshot.hpp"
+#include "internal/itemstreamutil.hpp"
+#include "internal/parallelextraction.hpp"
+#include "internal/sinkextractcallback.hpp"
+#include "internal/solidblockcache.hpp"
 #include "internal/streamextractcallback.hpp"
+#include "internal/tracing.hpp"
 #include "internal/opencallback.hpp"
 #include "internal/util.hpp"
 #include "internal/cmultivolumeinstream.hpp"
@@ -47,12 +66,31 @@ CMyComPtr< IInArchive > initArchiveObject( const Bit7zLibrary& lib, const GUID*
     return arc_object;
 }
 
-void extractArc( IInArchive* in_archive, const vector< uint32_t >& indices, ExtractCallback* extract_callback ) {
+uint32_t archiveItemsCount( IInArchive* in_archive ) {
+    uint32_t items_count = 0;
+    if ( in_archive->GetNumberOfItems( &items_count ) != S_OK ) {
+        return 0;
+    }
+    // Note: archives opened from forward-only streams may report an unknown ((UInt32)-1) number of items.
+    return items_count != std::numeric_limits< uint32_t >::max() ? items_count : 0;
+}
+
+void extractArc( IInArchive* in_archive,
+                 const vector< uint32_t >& indices,
+                 ExtractCallback* extract_callback,
+                 IOStatsRecorder* in_stream_stats ) {
     const uint32_t* item_indices = indices.empty() ? nullptr : indices.data();
     const uint32_t num_items = indices.empty() ?
                                std::numeric_limits< uint32_t >::max() : static_cast< uint32_t >( indices.size() );
+    extract_callback->beginOperation( indices.empty() ? archiveItemsCount( in_archive ) : num_items );
 
-    const HRESULT res = in_archive->Extract( item_indices, num_items, NExtract::NAskMode::kExtract, extract_callback );
+    HRESULT res;
+    {
+        const IOStatsAttachment stats_attachment{ in_stream_stats, extract_callback->ioStatsCollector() };
+        BIT7Z_TRACE_SCOPE( "IInArchive::Extract" );
+        res = in_archive->Extract( item_indices, num_items, NExtract::NAskMode::kExtract, extract_callback );
+    }
+    extract_callback->reportOperationStats();
     if ( res != S_OK ) {
         const auto& errorException = extract_callback->errorException();
         if ( errorException ) {
@@ -63,11 +101,18 @@ void extractArc( IInArchive* in_archive, const vector< uint32_t >& indices, Extr
     }
 }
 
-void testArc( IInArchive* in_archive, ExtractCallback* extract_callback ) {
-    const HRESULT res = in_archive->Extract( nullptr,
-                                             static_cast< uint32_t >( -1 ),
-                                             NExtract::NAskMode::kTest,
-                                             extract_callback );
+void testArc( IInArchive* in_archive, ExtractCallback* extract_callback, IOStatsRecorder* in_stream_stats ) {
+    extract_callback->beginOperation( archiveItemsCount( in_archive ) );
+    HRESULT res;
+    {
+        const IOStatsAttachment stats_attachment{ in_stream_stats, extract_callback->ioStatsCollector() };
+        BIT7Z_TRACE_SCOPE( "IInArchive::Extract (test)" );
+        res = in_archive->Extract( nullptr,
+                                   static_cast< uint32_t >( -1 ),
+                                   NExtract::NAskMode::kTest,
+                                   extract_callback );
+    }
+    extract_callback->reportOperationStats();
     if ( res != S_OK ) {
         const auto& errorException = extract_callback->errorException();
         if ( errorException ) {
@@ -79,6 +124,8 @@ void testArc( IInArchive* in_archive, ExtractCallback* extract_callback ) {
 }
 
 IInArchive* BitInputArchive::openArchiveStream( const fs::path& name, IInStream* in_stream ) {
+    BIT7Z_TRACE_SCOPE( "BitInputArchive::openArchiveStream" );
+    mInStreamStats = dynamic_cast< IOStatsRecorder* >( in_stream );
 #ifdef BIT7Z_AUTO_FORMAT
     bool detected_by_signature = false;
     if ( *mDetectedFormat == BitFormat::Auto ) {
@@ -151,11 +198,29 @@ BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, cons
     if ( *mDetectedFormat != BitFormat::Split && arc_path.extension() == ".001" ) {
         file_stream = bit7z::make_com< CMultiVolumeInStream, IInStream >( arc_path );
     } else {
-        file_stream = bit7z::make_com< CFileInStream, IInStream >( arc_path );
+        file_stream = openFileInStream( arc_path );
     }
     mInArchive = openArchiveStream( arc_path, file_stream );
 }
 
+BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const tstring& in_file, uint64_t offset )
+    : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
+      mArchiveHandler{ handler },
+      mArchivePath{ in_file },
+      mArchiveOffset{ offset } {
+    fs::path arc_path{ in_file };
+#if defined( _WIN32 ) && defined( BIT7Z_AUTO_PREFIX_LONG_PATHS )
+    if ( filesystem::fsutil::should_format_long_path( arc_path ) ) {
+        arc_path = filesystem::fsutil::format_long_path( arc_path );
+    }
+#endif
+    const CMyComPtr< IInStream > file_stream = openFileInStream( arc_path );
+    auto sub_stream = bit7z::make_com< CSubInStream, IInStream >( file_stream, offset );
+    mInArchive = openArchiveStream( arc_path, sub_stream );
+    // Note: the I/O statistics are recorded by the file stream underlying the sub-stream.
+    mInStreamStats = dynamic_cast< IOStatsRecorder* >( static_cast< IInStream* >( file_stream ) );
+}
+
 BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, const std::vector< byte_t >& in_buffer )
     : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
       mArchiveHandler{ handler } {
@@ -170,6 +235,59 @@ BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler, std:
     mInArchive = openArchiveStream( BIT7Z_STRING( "." ), std_stream );
 }
 
+BitInputArchive::BitInputArchive( const BitAbstractArchiveHandler& handler,
+                                  std::istream& in_stream,
+                                  InputStreamMode mode )
+    : mDetectedFormat{ &handler.format() }, // if auto, detect the format from content, otherwise try the passed format.
+      mArchiveHandler{ handler },
+      mInputStreamMode{ mode } {
+    if ( mode == InputStreamMode::Seekable ) {
+        auto std_stream = bit7z::make_com< CStdInStream, IInStream >( in_stream );
+        mInArchive = openArchiveStream( BIT7Z_STRING( "." ), std_stream );
+        return;
+    }
+
+#ifdef BIT7Z_AUTO_FORMAT
+    // Note: the look-ahead buffer is needed only for detecting the format.
+    const std::size_t look_ahead_size = *mDetectedFormat == BitFormat::Auto ? kSignatureWindowSize : 0;
+#else
+    const std::size_t look_ahead_size = 0;
+#endif
+    auto look_ahead_stream = bit7z::make_com< CLookAheadInStream >( in_stream, look_ahead_size );
+#ifdef BIT7Z_AUTO_FORMAT
+    if ( *mDetectedFormat == BitFormat::Auto ) {
+        const auto& look_ahead = look_ahead_stream->lookAhead();
+        uint32_t signature_size = 0;
+        mDetectedFormat = detectFormatFromBuffer( look_ahead.data(), look_ahead.size(), signature_size );
+        if ( mDetectedFormat == nullptr ) {
+            throw BitException( "Failed to detect the format of the stream",
+                                make_error_code( BitError::NoMatchingSignature ) );
+        }
+    }
+#endif
+    mInArchive = openArchiveSequentially( look_ahead_stream );
+}
+
+IInArchive* BitInputArchive::openArchiveSequentially( ISequentialInStream* in_stream ) {
+    BIT7Z_TRACE_SCOPE( "BitInputArchive::openArchiveSequentially" );
+    const GUID format_GUID = formatGUID( *mDetectedFormat );
+    CMyComPtr< IInArchive > in_archive = initArchiveObject( mArchiveHandler.library(), &format_GUID );
+
+    CMyComPtr< IArchiveOpenSeq > open_seq;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if ( in_archive->QueryInterface( ::IID_IArchiveOpenSeq, reinterpret_cast< void** >( &open_seq ) ) != S_OK ||
+         open_seq == nullptr ) {
+        throw BitException( "The archive format cannot be read from a forward-only stream",
+                            make_error_code( BitError::FormatFeatureNotSupported ) );
+    }
+
+    const HRESULT res = open_seq->OpenSeq( in_stream );
+    if ( res != S_OK ) {
+        throw BitException( "Failed to open the archive", make_hresult_code( res ) );
+    }
+    return in_archive.Detach();
+}
+
 BitPropVariant BitInputArchive::archiveProperty( BitProperty property ) const {
     BitPropVariant archive_property;
     const HRESULT res = mInArchive->GetArchiveProperty( static_cast<PROPID>( property ), &archive_property );
@@ -180,6 +298,9 @@ BitPropVariant BitInputArchive::archiveProperty( BitProperty property ) const {
 }
 
 BitPropVariant BitInputArchive::itemProperty( uint32_t index, BitProperty property ) const {
+    if ( mItemsSnapshot != nullptr && index < mItemsSnapshot->itemsCount() && ItemsSnapshot::covers( property ) ) {
+        return mItemsSnapshot->itemProperty( index, property );
+    }
     BitPropVariant item_property;
     const HRESULT res = mInArchive->GetProperty( index, static_cast<PROPID>( property ), &item_property );
     if ( res != S_OK ) {
@@ -189,7 +310,90 @@ BitPropVariant BitInputArchive::itemProperty( uint32_t index, BitProperty proper
     return item_property;
 }
 
+/* Archive properties that handlers may return even if they don't list them among the supported ones
+ * (for the item properties, see kCommonItemProperties). */
+constexpr std::array< BitProperty, 11 > kAlwaysQueriedArchiveProperties = { { BitProperty::MainSubfile,
+                                                                            BitProperty::Offset,
+                                                                            BitProperty::PhySize,
+                                                                            BitProperty::HeadersSize,
+                                                                            BitProperty::Error,
+                                                                            BitProperty::ErrorFlags,
+                                                                            BitProperty::WarningFlags,
+                                                                            BitProperty::Warning,
+                                                                            BitProperty::IsNotArcType,
+                                                                            BitProperty::TailSize,
+                                                                            BitProperty::EmbeddedStubSize } };
+
+template< std::size_t N, typename NumberGetter, typename InfoGetter >
+vector< BitProperty > queryProperties( const std::array< BitProperty, N >& always_queried,
+                                       NumberGetter get_number_of_properties,
+                                       InfoGetter get_property_info ) {
+    vector< BitProperty > result;
+    uint32_t number_of_properties = 0;
+    if ( get_number_of_properties( &number_of_properties ) != S_OK ) {
+        // The handler cannot tell us which properties it supports, so we must try all of them.
+        for ( uint32_t property = kpidNoProperty; property <= kpidCopyLink; ++property ) {
+            result.push_back( static_cast< BitProperty >( property ) );
+        }
+        return result;
+    }
+
+    result.assign( always_queried.cbegin(), always_queried.cend() );
+    for ( uint32_t i = 0; i < number_of_properties; ++i ) {
+        BSTR name = nullptr;
+        PROPID property_id = kpidNoProperty;
+        VARTYPE var_type = VT_EMPTY;
+        const HRESULT res = get_property_info( i, &name, &property_id, &var_type );
+        if ( name != nullptr ) {
+            ::SysFreeString( name );
+        }
+        // Note: handler-specific properties (i.e., having an ID greater than kpidCopyLink) have no BitProperty value.
+        if ( res == S_OK && property_id != kpidNoProperty &&
+             property_id <= static_cast< PROPID >( BitProperty::CopyLink ) ) {
+            result.push_back( static_cast< BitProperty >( property_id ) );
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique( result.begin(), result.end() ), result.end() );
+    return result;
+}
+
+void BitInputArchive::loadSupportedProperties() const {
+    std::call_once( mSupportedPropertiesFlag, [ this ]() {
+        mSupportedArchiveProperties = queryProperties(
+            kAlwaysQueriedArchiveProperties,
+            [ this ]( uint32_t* number ) { return mInArchive->GetNumberOfArchiveProperties( number ); },
+            [ this ]( uint32_t index, BSTR* name, PROPID* property_id, VARTYPE* var_type ) {
+                return mInArchive->GetArchivePropertyInfo( index, name, property_id, var_type );
+            } );
+        mSupportedItemProperties = queryProperties(
+            kCommonItemProperties,
+            [ this ]( uint32_t* number ) { return mInArchive->GetNumberOfProperties( number ); },
+            [ this ]( uint32_t index, BSTR* name, PROPID* property_id, VARTYPE* var_type ) {
+                return mInArchive->GetPropertyInfo( index, name, property_id, var_type );
+            } );
+    } );
+}
+
+const vector< BitProperty >& BitInputArchive::supportedArchiveProperties() const {
+    loadSupportedProperties();
+    return mSupportedArchiveProperties;
+}
+
+const vector< BitProperty >& BitInputArchive::supportedItemProperties() const {
+    loadSupportedProperties();
+    return mSupportedItemProperties;
+}
+
+void BitInputArchive::requireRandomAccess() const {
+    if ( mInputStreamMode == InputStreamMode::ForwardOnly ) {
+        throw BitException( "Archives opened from forward-only streams can only be extracted or tested as a whole",
+                            make_error_code( BitError::FormatFeatureNotSupported ) );
+    }
+}
+
 uint32_t BitInputArchive::itemsCount() const {
+    requireRandomAccess();
     uint32_t items_count{};
     const HRESULT res = mInArchive->GetNumberOfItems( &items_count );
     if ( res != S_OK ) {
@@ -199,15 +403,111 @@ uint32_t BitInputArchive::itemsCount() const {
 }
 
 bool BitInputArchive::isItemFolder( uint32_t index ) const {
+    if ( mItemsSnapshot != nullptr && index < mItemsSnapshot->itemsCount() ) {
+        return mItemsSnapshot->isDir( index );
+    }
     const BitPropVariant is_item_folder = itemProperty( index, BitProperty::IsDir );
     return !is_item_folder.isEmpty() && is_item_folder.getBool();
 }
 
 bool BitInputArchive::isItemEncrypted( uint32_t index ) const {
+    if ( mItemsSnapshot != nullptr && index < mItemsSnapshot->itemsCount() ) {
+        return mItemsSnapshot->isEncrypted( index );
+    }
     const BitPropVariant is_item_encrypted = itemProperty( index, BitProperty::Encrypted );
     return is_item_encrypted.isBool() && is_item_encrypted.getBool();
 }
 
+void BitInputArchive::loadItemsSnapshot() {
+    if ( mItemsSnapshot == nullptr ) {
+        mItemsSnapshot = std::make_unique< ItemsSnapshot >( *this );
+    }
+}
+
+bool BitInputArchive::hasItemsSnapshot() const noexcept {
+    return mItemsSnapshot != nullptr;
+}
+
+const ItemsSnapshot* BitInputArchive::itemsSnapshot() const noexcept {
+    return mItemsSnapshot.get();
+}
+
+void BitInputArchive::setSolidBlockCacheSize( uint64_t max_memory ) {
+    mSolidBlockCache = max_memory > 0 ? std::make_unique< SolidBlockCache >( max_memory ) : nullptr;
+}
+
+bool BitInputArchive::loadSolidBlock( uint32_t index ) const {
+    if ( mSolidBlockCache == nullptr ) {
+        return false;
+    }
+
+    const BitPropVariant is_solid = archiveProperty( BitProperty::Solid );
+    if ( !is_solid.isBool() || !is_solid.getBool() ) {
+        return false;
+    }
+
+    const BitPropVariant item_block = itemProperty( index, BitProperty::Block );
+    if ( !item_block.isUInt64() ) {
+        return false;
+    }
+    const uint64_t block = item_block.getUInt64();
+
+    // The items of a solid block have contiguous indices, except for the items not belonging to any block
+    // (e.g., folders and empty files), which are skipped.
+    enum struct BlockItem { Added, Skipped, EndOfBlock, UnknownSize };
+
+    uint64_t block_size = 0;
+    vector< uint32_t > block_indices;
+    auto add_item = [ & ]( uint32_t item_index ) -> BlockItem {
+        const BitPropVariant other_block = itemProperty( item_index, BitProperty::Block );
+        if ( !other_block.isUInt64() ) {
+            return BlockItem::Skipped; // Not in any block.
+        }
+        if ( other_block.getUInt64() != block ) {
+            return BlockItem::EndOfBlock;
+        }
+        const BitPropVariant item_size = itemProperty( item_index, BitProperty::Size );
+        if ( !item_size.isUInt64() ) {
+            return BlockItem::UnknownSize;
+        }
+        block_size += item_size.getUInt64();
+        block_indices.push_back( item_index );
+        return BlockItem::Added;
+    };
+
+    BlockItem result = BlockItem::Added;
+    for ( uint32_t item_index = index; item_index > 0 && block_size <= mSolidBlockCache->maxMemory(); ) {
+        result = add_item( --item_index );
+        if ( result == BlockItem::EndOfBlock || result == BlockItem::UnknownSize ) {
+            break;
+        }
+    }
+    std::reverse( block_indices.begin(), block_indices.end() );
+    const uint32_t number_items = itemsCount();
+    for ( uint32_t item_index = index;
+          result != BlockItem::UnknownSize && item_index < number_items; ++item_index ) {
+        result = add_item( item_index );
+        if ( result == BlockItem::EndOfBlock || block_size > mSolidBlockCache->maxMemory() ) {
+            break;
+        }
+    }
+    if ( result == BlockItem::UnknownSize ) {
+        return false; // We cannot tell whether the whole block fits in the cache, so we don't cache it.
+    }
+    if ( block_size > mSolidBlockCache->maxMemory() ||
+         std::find( block_indices.cbegin(), block_indices.cend(), index ) == block_indices.cend() ) {
+        return false; // The block doesn't fit in the cache, so we fall back to extracting the single item.
+    }
+
+    map< uint32_t, vector< byte_t > > block_items;
+    auto extract_callback = bit7z::make_com< BlockBufferExtractCallback, ExtractCallback >( *this,
+                                                                                         index,
+                                                                                         block_items );
+    extractArc( mInArchive, block_indices, extract_callback, mInStreamStats );
+    mSolidBlockCache->insert( std::move( block_items ) );
+    return true;
+}
+
 HRESULT BitInputArchive::initUpdatableArchive( IOutArchive** newArc ) const {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
     return mInArchive->QueryInterface( ::IID_IOutArchive, reinterpret_cast< void** >( newArc ) );
@@ -227,13 +527,71 @@ const tstring& BitInputArchive::archivePath() const noexcept {
     return mArchivePath;
 }
 
+uint64_t BitInputArchive::archiveOffset() const noexcept {
+    return mArchiveOffset;
+}
+
 const BitAbstractArchiveHandler& BitInputArchive::handler() const noexcept {
     return mArchiveHandler;
 }
 
 void BitInputArchive::extract( const tstring& out_dir, const std::vector< uint32_t >& indices ) const {
+    if ( !indices.empty() ) {
+        requireRandomAccess(); // Archives opened from forward-only streams can be extracted only as a whole.
+    }
+    const auto* opener = dynamic_cast< const BitAbstractArchiveOpener* >( &mArchiveHandler );
+    const uint32_t threads_count = opener != nullptr ? opener->extractionThreads() : 1;
+    if ( threads_count > 1 && !mArchivePath.empty() ) {
+        const BitPropVariant is_solid = archiveProperty( BitProperty::Solid );
+        if ( !is_solid.isBool() || !is_solid.getBool() ) {
+            vector< uint32_t > items_indices = indices;
+            if ( items_indices.empty() ) {
+                items_indices.resize( itemsCount() );
+                std::iota( items_indices.begin(), items_indices.end(), 0 );
+            }
+
+            // Note: the folders are extracted separately, after all the files have been written into them.
+            vector< uint32_t > files_indices;
+            vector< uint32_t > folders_indices;
+            vector< uint64_t > files_sizes;
+            files_indices.reserve( items_indices.size() );
+            files_sizes.reserve( items_indices.size() );
+            for ( const auto index : items_indices ) {
+                if ( isItemFolder( index ) ) {
+                    folders_indices.push_back( index );
+                    continue;
+                }
+                const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+                files_indices.push_back( index );
+                files_sizes.push_back( item_size.isEmpty() ? 0 : item_size.getUInt64() );
+            }
+
+            const auto groups = partitionBySize( files_indices, files_sizes, threads_count );
+            if ( groups.size() > 1 ) {
+                const uint64_t total_size = std::accumulate( files_sizes.cbegin(), files_sizes.cend(), uint64_t{ 0 } );
+                extractInParallel( *this, out_dir, groups, folders_indices, total_size );
+                return;
+            }
+        }
+    }
+
+    /* Note: IInArchive::Extract requires the indices to be sorted in ascending order; since the solid blocks
+     *       (e.g., the folders of 7z archives) cover contiguous ranges of indices, this order also guarantees
+     *       that each solid block is decoded only once. */
+    std::vector< uint32_t > sorted_indices = indices;
+    std::sort( sorted_indices.begin(), sorted_indices.end() );
+    sorted_indices.erase( std::unique( sorted_indices.begin(), sorted_indices.end() ), sorted_indices.end() );
+
     auto callback = bit7z::make_com< FileExtractCallback, ExtractCallback >( *this, out_dir );
-    extractArc( mInArchive, indices, callback );
+    extractArc( mInArchive, sorted_indices, callback, mInStreamStats );
+}
+
+std::future< void > BitInputArchive::extractAsync( const tstring& out_dir,
+                                                  const std::vector< uint32_t >& indices,
+                                                  const BitExecutor& executor ) const {
+    return runAsync( executor, [ this, out_dir, indices ]() {
+        extract( out_dir, indices );
+    } );
 }
 
 void BitInputArchive::extract( std::vector< byte_t >& out_buffer, uint32_t index ) const {
@@ -248,10 +606,19 @@ void BitInputArchive::extract( std::vector< byte_t >& out_buffer, uint32_t index
                             make_error_code( BitError::ItemIsAFolder ) );
     }
 
+    if ( mSolidBlockCache != nullptr ) {
+        if ( mSolidBlockCache->get( index, out_buffer ) ) {
+            return;
+        }
+        if ( loadSolidBlock( index ) && mSolidBlockCache->get( index, out_buffer ) ) {
+            return;
+        }
+    }
+
     const vector< uint32_t > indices( 1, index );
     map< tstring, vector< byte_t > > buffers_map;
     auto extract_callback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, buffers_map );
-    extractArc( mInArchive, indices, extract_callback );
+    extractArc( mInArchive, indices, extract_callback, mInStreamStats );
     out_buffer = std::move( buffers_map.begin()->second );
 }
 
@@ -269,7 +636,31 @@ void BitInputArchive::extract( std::ostream& out_stream, uint32_t index ) const
 
     const vector< uint32_t > indices( 1, index );
     auto extract_callback = bit7z::make_com< StreamExtractCallback, ExtractCallback >( *this, out_stream );
-    extractArc( mInArchive, indices, extract_callback );
+    extractArc( mInArchive, indices, extract_callback, mInStreamStats );
+}
+
+void BitInputArchive::extract( const SinkCallback& sink, uint32_t index ) const {
+    const uint32_t number_items = itemsCount();
+    if ( index >= number_items ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    if ( isItemFolder( index ) ) { //Consider only files, not folders
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ) + " to the sink",
+                            make_error_code( BitError::ItemIsAFolder ) );
+    }
+
+    const vector< uint32_t > indices( 1, index );
+    auto extract_callback = bit7z::make_com< SinkExtractCallback >( *this, sink );
+    try {
+        extractArc( mInArchive, indices, extract_callback, mInStreamStats );
+    } catch ( const BitException& ) {
+        if ( extract_callback->sinkError() ) {
+            std::rethrow_exception( extract_callback->sinkError() );
+        }
+        throw;
+    }
 }
 
 void BitInputArchive::extract( byte_t* buffer, std::size_t size, uint32_t index ) const {
@@ -290,9 +681,21 @@ void BitInputArchive::extract( byte_t* buffer, std::size_t size, uint32_t index
                             make_error_code( BitError::InvalidOutputBufferSize ) );
     }
 
+    if ( mSolidBlockCache != nullptr ) {
+        if ( mSolidBlockCache->get( index, buffer, size ) ) {
+            return;
+        }
+        // Note: if the item is cached but with a different size, reloading its block wouldn't help,
+        // so we directly fall back to extracting the single item.
+        if ( !mSolidBlockCache->contains( index ) && loadSolidBlock( index ) &&
+             mSolidBlockCache->get( index, buffer, size ) ) {
+            return;
+        }
+    }
+
     const vector< uint32_t > indices( 1, index );
     auto extract_callback = bit7z::make_com< FixedBufferExtractCallback, ExtractCallback >( *this, buffer, size );
-    extractArc( mInArchive, indices, extract_callback );
+    extractArc( mInArchive, indices, extract_callback, mInStreamStats );
 }
 
 void BitInputArchive::extract( std::map< tstring, std::vector< byte_t > >& out_map ) const {
@@ -305,13 +708,120 @@ void BitInputArchive::extract( std::map< tstring, std::vector< byte_t > >& out_m
     }
 
     auto extract_callback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, out_map );
-    extractArc( mInArchive, files_indices, extract_callback );
+    extractArc( mInArchive, files_indices, extract_callback, mInStreamStats );
+}
+
+void BitInputArchive::extract( BitItemsArena& arena, const std::vector< uint32_t >& indices ) const {
+    const uint32_t number_items = itemsCount();
+    vector< uint32_t > files_indices;
+    if ( indices.empty() ) {
+        for ( uint32_t index = 0; index < number_items; ++index ) {
+            if ( !isItemFolder( index ) ) {
+                files_indices.push_back( index );
+            }
+        }
+    } else {
+        for ( const auto index : indices ) {
+            if ( index >= number_items ) {
+                throw BitException( "Cannot extract item at the index " + std::to_string( index ),
+                                    make_error_code( BitError::InvalidIndex ) );
+            }
+            if ( !isItemFolder( index ) ) {
+                files_indices.push_back( index );
+            }
+        }
+        std::sort( files_indices.begin(), files_indices.end() );
+        files_indices.erase( std::unique( files_indices.begin(), files_indices.end() ), files_indices.end() );
+    }
+
+    arena.clear();
+    if ( files_indices.empty() ) {
+        return;
+    }
+
+    auto extract_callback = bit7z::make_com< ArenaExtractCallback >( *this, arena );
+    extract_callback->reserve( files_indices );
+    try {
+        extractArc( mInArchive, files_indices, extract_callback, mInStreamStats );
+    } catch ( const BitException& ) {
+        if ( extract_callback->sinkError() ) {
+            std::rethrow_exception( extract_callback->sinkError() );
+        }
+        throw;
+    }
+}
+
+std::unique_ptr< BitItemStream > BitInputArchive::openItemStream( uint32_t index ) const {
+    if ( index >= itemsCount() ) {
+        throw BitException( "Cannot open the stream of the item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    if ( isItemFolder( index ) ) {
+        throw BitException( "Cannot open the stream of the item at the index " + std::to_string( index ),
+                            make_error_code( BitError::ItemIsAFolder ) );
+    }
+
+    // Note: we cannot use std::make_unique since the constructor of BitItemStream is private.
+    return std::unique_ptr< BitItemStream >( new BitItemStream( *this, mInArchive, index ) );
+}
+
+std::size_t BitInputArchive::extractRange( uint32_t index,
+                                           uint64_t offset,
+                                           std::size_t length,
+                                           byte_t* buffer ) const {
+    if ( index >= itemsCount() ) {
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ),
+                            make_error_code( BitError::InvalidIndex ) );
+    }
+
+    if ( isItemFolder( index ) ) { //Consider only files, not folders
+        throw BitException( "Cannot extract item at the index " + std::to_string( index ) + " to the buffer",
+                            make_error_code( BitError::ItemIsAFolder ) );
+    }
+
+    if ( length == 0 ) {
+        return 0;
+    }
+
+    if ( offset <= static_cast< uint64_t >( std::numeric_limits< Int64 >::max() ) ) {
+        CMyComPtr< IInStream > item_stream = getSeekableItemStream( mInArchive, index );
+        if ( item_stream != nullptr &&
+             item_stream->Seek( static_cast< Int64 >( offset ), STREAM_SEEK_SET, nullptr ) == S_OK ) {
+            return readStream( item_stream, buffer, length );
+        }
+    }
+
+    // Decoding the item from the start, discarding the bytes before the offset; as soon as the range is complete,
+    // the sink stops the extraction (i.e., the output stream returns E_ABORT to the decoder).
+    uint64_t skipped_size = 0;
+    std::size_t copied_size = 0;
+    const SinkCallback range_sink = [ & ]( const byte_t* data, std::size_t size ) -> bool {
+        if ( skipped_size < offset ) {
+            const auto skip_size = static_cast< std::size_t >( std::min< uint64_t >( offset - skipped_size, size ) );
+            skipped_size += skip_size;
+            data += skip_size;
+            size -= skip_size;
+        }
+        const std::size_t copy_size = std::min( size, length - copied_size );
+        std::copy_n( data, copy_size, buffer + copied_size );
+        copied_size += copy_size;
+        return copied_size < length;
+    };
+    try {
+        extract( range_sink, index );
+    } catch ( const BitException& ) {
+        if ( copied_size < length ) { // The extraction failed before completing the range.
+            throw;
+        }
+    }
+    return copied_size;
 }
 
 void BitInputArchive::test() const {
     map< tstring, vector< byte_t > > dummy_map; //output map (not used since we are testing!)
     auto extract_callback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( *this, dummy_map );
-    testArc( mInArchive, extract_callback );
+    testArc( mInArchive, extract_callback, mInStreamStats );
 }
 
 HRESULT BitInputArchive::close() const noexcept {
@@ -330,7 +840,11 @@ BitInputArchive::const_iterator BitInputArchive::begin() const noexcept {
 }
 
 BitInputArchive::const_iterator BitInputArchive::end() const noexcept {
-    //Note: we do not use itemsCount() since it can throw an exception and end() is marked as noexcept!
+    if ( mInputStreamMode == InputStreamMode::ForwardOnly ) {
+        // The items of forward-only archives are not known in advance: iterating them results in an empty range.
+        return const_iterator{ 0, *this };
+    }
+    //Note: we do not use itemsCount() since the iterators have always been usable even if the handler fails.
     uint32_t items_count = 0;
     mInArchive->GetNumberOfItems( &items_count );
     return const_iterator{ items_count, *this };
@@ -344,10 +858,37 @@ BitInputArchive::const_iterator BitInputArchive::cend() const noexcept {
     return end();
 }
 
-BitInputArchive::const_iterator BitInputArchive::find( const tstring& path ) const noexcept {
-    return std::find_if( begin(), end(), [ &path ]( auto& old_item ) {
-        return old_item.path() == path;
+const std::unordered_map< tstring, uint32_t >& BitInputArchive::pathIndex() const {
+    std::call_once( mPathIndexFlag, [ this ]() {
+        std::unordered_map< tstring, uint32_t > path_index;
+        path_index.reserve( itemsCount() );
+        for ( const auto& item : *this ) {
+            // Note: emplace doesn't overwrite existing keys, so duplicate paths map to the first matching item.
+            path_index.emplace( item.path(), item.index() );
+        }
+        mPathIndex = std::move( path_index );
     } );
+    return mPathIndex;
+}
+
+BitInputArchive::const_iterator BitInputArchive::find( const tstring& path ) const noexcept {
+    if ( mInputStreamMode == InputStreamMode::ForwardOnly ) {
+        return end();
+    }
+    try {
+        const auto& path_index = pathIndex();
+        const auto res = path_index.find( path );
+        return res != path_index.end() ? const_iterator{ res->second, *this } : end();
+    } catch ( const std::exception& ) {
+        // The index could not be built (e.g., some item property could not be read): falling back to a linear search.
+    }
+    try {
+        return std::find_if( begin(), end(), [ &path ]( auto& old_item ) {
+            return old_item.path() == path;
+        } );
+    } catch ( const std::exception& ) {
+        return end();
+    }
 }
 
 bool BitInputArchive::contains( const tstring& path ) const noexcept {
@@ -0,0 +1,45 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bititemsarena.hpp"
+
+#include <utility>
+
+using namespace bit7z;
+
+const std::vector< byte_t >& BitItemsArena::data() const noexcept {
+    return mData;
+}
+
+const std::vector< BitArenaEntry >& BitItemsArena::entries() const noexcept {
+    return mEntries;
+}
+
+const tchar* BitItemsArena::path( const BitArenaEntry& entry ) const noexcept {
+    return mPaths.c_str() + entry.pathOffset;
+}
+
+const byte_t* BitItemsArena::content( const BitArenaEntry& entry ) const noexcept {
+    return mData.data() + entry.offset;
+}
+
+std::vector< byte_t > BitItemsArena::releaseData() noexcept {
+    std::vector< byte_t > data = std::move( mData );
+    clear();
+    return data;
+}
+
+void BitItemsArena::clear() noexcept {
+    mData.clear();
+    mPaths.clear();
+    mEntries.clear();
+}
@@ -0,0 +1,95 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bititemstream.hpp"
+
+#include "bitexception.hpp"
+#include "bitinputarchive.hpp"
+#include "internal/cbufferinstream.hpp"
+#include "internal/itemstreamutil.hpp"
+#include "internal/util.hpp"
+
+using namespace bit7z;
+
+namespace {
+uint32_t seek_origin( std::ios_base::seekdir origin ) {
+    switch ( origin ) {
+        case std::ios_base::beg:
+            return STREAM_SEEK_SET;
+        case std::ios_base::cur:
+            return STREAM_SEEK_CUR;
+        case std::ios_base::end:
+            return STREAM_SEEK_END;
+        default:
+            throw BitException( "Invalid seek origin", make_hresult_code( STG_E_INVALIDFUNCTION ) );
+    }
+}
+} // namespace
+
+BitItemStream::BitItemStream( const BitInputArchive& archive, IInArchive* in_archive, uint32_t index )
+    : mStream{ nullptr }, mSize{ 0 }, mIsDirect{ false } {
+    CMyComPtr< IInStream > item_stream = getSeekableItemStream( in_archive, index );
+    if ( item_stream != nullptr ) {
+        UInt64 stream_size = 0;
+        if ( item_stream->Seek( 0, STREAM_SEEK_END, &stream_size ) == S_OK &&
+             item_stream->Seek( 0, STREAM_SEEK_SET, nullptr ) == S_OK ) {
+            mSize = stream_size;
+            mIsDirect = true;
+        } else {
+            item_stream.Release();
+        }
+    }
+
+    if ( !mIsDirect ) {
+        // Falling back to decoding the whole item in memory.
+        archive.extract( mBuffer, index );
+        mSize = mBuffer.size();
+        item_stream = bit7z::make_com< CBufferInStream, IInStream >( mBuffer );
+    }
+    mStream = item_stream.Detach();
+}
+
+BitItemStream::~BitItemStream() {
+    if ( mStream != nullptr ) {
+        mStream->Release();
+    }
+}
+
+std::size_t BitItemStream::read( byte_t* buffer, std::size_t size ) {
+    return readStream( mStream, buffer, size );
+}
+
+uint64_t BitItemStream::seek( int64_t offset, std::ios_base::seekdir origin ) {
+    UInt64 new_position = 0;
+    const HRESULT res = mStream->Seek( offset, seek_origin( origin ), &new_position );
+    if ( res != S_OK ) {
+        throw BitException( "Could not seek the item stream", make_hresult_code( res ) );
+    }
+    return new_position;
+}
+
+uint64_t BitItemStream::position() const {
+    UInt64 current_position = 0;
+    const HRESULT res = mStream->Seek( 0, STREAM_SEEK_CUR, &current_position );
+    if ( res != S_OK ) {
+        throw BitException( "Could not get the position in the item stream", make_hresult_code( res ) );
+    }
+    return current_position;
+}
+
+uint64_t BitItemStream::size() const noexcept {
+    return mSize;
+}
+
+bool BitItemStream::isDirect() const noexcept {
+    return mIsDirect;
+}
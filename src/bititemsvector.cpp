@@ -12,23 +12,45 @@
 
 #include "bititemsvector.hpp"
 
+#include <algorithm>
+
 #include "bitexception.hpp"
 #include "internal/bufferitem.hpp"
 #include "internal/fsindexer.hpp"
+#include "internal/fsitemsstore.hpp"
 #include "internal/stdinputitem.hpp"
 
 using namespace bit7z;
 using filesystem::FSItem;
 using filesystem::FSIndexer;
 
+BitItemsVector::BitItemsVector() = default;
+
+BitItemsVector::BitItemsVector( const BitItemsVector& other )
+    : mItems{ other.mItems },
+      mItemsPositions{ other.mItemsPositions },
+      mIndexedItems{ other.mIndexedItems ? std::make_unique< FSItemsStore >( *other.mIndexedItems ) : nullptr } {}
+
+BitItemsVector::BitItemsVector( BitItemsVector&& ) noexcept = default;
+
+BitItemsVector& BitItemsVector::operator=( const BitItemsVector& other ) {
+    if ( this != &other ) {
+        BitItemsVector copy{ other };
+        *this = std::move( copy );
+    }
+    return *this;
+}
+
+BitItemsVector& BitItemsVector::operator=( BitItemsVector&& ) noexcept = default;
+
 void BitItemsVector::indexDirectory( const fs::path& in_dir, const tstring& filter, IndexingOptions options ) {
     //Note: if in_dir is an invalid path, FSItem constructor throws a BitException!
     const FSItem dir_item{ in_dir, options.retain_folder_structure ? in_dir : fs::path{} };
     if ( filter.empty() && !dir_item.inArchivePath().empty() ) {
-        mItems.emplace_back( std::make_unique< FSItem >( dir_item ) );
+        addItem( std::make_unique< FSItem >( dir_item ) );
     }
-    FSIndexer indexer{ dir_item, filter, options.only_files };
-    indexer.listDirectoryItems( mItems, options.recursive );
+    FSIndexer indexer{ dir_item, filter, options.only_files, options.sort_entries };
+    indexer.listDirectoryItems( indexedItems(), options.recursive, options.threads );
 }
 
 void BitItemsVector::indexPaths( const std::vector< tstring >& in_paths, IndexingOptions options ) {
@@ -47,13 +69,13 @@ void BitItemsVector::indexPathsMap( const std::map< tstring, tstring >& in_paths
 
 void BitItemsVector::indexItem( const FSItem& item, IndexingOptions options ) {
     if ( !item.isDir() ) {
-        mItems.emplace_back( std::make_unique< FSItem >( item ) );
+        addItem( std::make_unique< FSItem >( item ) );
     } else if ( options.recursive ) { // The item is a directory
         if ( !item.inArchivePath().empty() ) {
-            mItems.emplace_back( std::make_unique< FSItem >( item ) );
+            addItem( std::make_unique< FSItem >( item ) );
         }
-        FSIndexer indexer{ item, {}, options.only_files };
-        indexer.listDirectoryItems( mItems, true );
+        FSIndexer indexer{ item, {}, options.only_files, options.sort_entries };
+        indexer.listDirectoryItems( indexedItems(), true, options.threads );
     } else {
         // No action needed
     }
@@ -64,42 +86,180 @@ void BitItemsVector::indexFile( const tstring& in_file, const tstring& name ) {
         throw BitException( "Input path points to a directory, not a file",
                             std::make_error_code( std::errc::invalid_argument ), in_file );
     }
-    mItems.emplace_back( std::make_unique< FSItem >( in_file, name ) );
+    addItem( std::make_unique< FSItem >( in_file, name ) );
 }
 
 void BitItemsVector::indexBuffer( const vector< byte_t >& in_buffer, const tstring& name ) {
-    mItems.emplace_back( std::make_unique< BufferItem >( in_buffer, name ) );
+    addItem( std::make_unique< BufferItem >( in_buffer, name ) );
 }
 
 void BitItemsVector::indexStream( std::istream& in_stream, const tstring& name ) {
-    mItems.emplace_back( std::make_unique< StdInputItem >( in_stream, name ) );
+    addItem( std::make_unique< StdInputItem >( in_stream, name ) );
 }
 
 size_t BitItemsVector::size() const {
-    return mItems.size();
+    return mItems.size() + ( mIndexedItems ? mIndexedItems->size() : 0 );
 }
 
-const GenericInputItem& BitItemsVector::operator[]( GenericInputItemVector::size_type index ) const {
+tstring BitItemsVector::itemPath( std::size_t index ) const {
+    std::size_t indexed_item = 0;
+    const GenericInputItem* item = genericItem( index, indexed_item );
+    return item != nullptr ? item->path() : mIndexedItems->path( indexed_item ).string< tchar >();
+}
+
+fs::path BitItemsVector::inArchivePath( std::size_t index ) const {
+    std::size_t indexed_item = 0;
+    const GenericInputItem* item = genericItem( index, indexed_item );
+    return item != nullptr ? item->inArchivePath() : mIndexedItems->inArchivePath( indexed_item );
+}
+
+uint64_t BitItemsVector::itemSize( std::size_t index ) const {
+    std::size_t indexed_item = 0;
+    const GenericInputItem* item = genericItem( index, indexed_item );
+    return item != nullptr ? item->size() : mIndexedItems->itemSize( indexed_item );
+}
+
+BitPropVariant BitItemsVector::itemProperty( std::size_t index, BitProperty property ) const {
+    std::size_t indexed_item = 0;
+    const GenericInputItem* item = genericItem( index, indexed_item );
+    return item != nullptr ? item->itemProperty( property ) : mIndexedItems->itemProperty( indexed_item, property );
+}
+
+HRESULT BitItemsVector::itemStream( std::size_t index, ISequentialInStream** inStream ) const {
+    std::size_t indexed_item = 0;
+    const GenericInputItem* item = genericItem( index, indexed_item );
+    return item != nullptr ? item->getStream( inStream ) : mIndexedItems->itemStream( indexed_item, inStream );
+}
+
+BitInputItem BitItemsVector::operator[]( std::size_t index ) const noexcept {
     // Note: here index is expected to be correct!
-    return *mItems[ index ];
+    return BitInputItem{ index, *this };
+}
+
+BitItemsVector::const_iterator BitItemsVector::begin() const noexcept {
+    return const_iterator{ BitInputItem{ 0, *this } };
+}
+
+BitItemsVector::const_iterator BitItemsVector::end() const noexcept {
+    return const_iterator{ BitInputItem{ size(), *this } };
+}
+
+BitItemsVector::const_iterator BitItemsVector::cbegin() const noexcept {
+    return begin();
+}
+
+BitItemsVector::const_iterator BitItemsVector::cend() const noexcept {
+    return end();
+}
+
+void BitItemsVector::addItem( GenericInputItemPtr item ) {
+    mItemsPositions.push_back( size() );
+    mItems.emplace_back( std::move( item ) );
 }
 
-GenericInputItemVector::const_iterator BitItemsVector::begin() const noexcept {
-    return mItems.cbegin();
+FSItemsStore& BitItemsVector::indexedItems() {
+    if ( !mIndexedItems ) {
+        mIndexedItems = std::make_unique< FSItemsStore >();
+    }
+    return *mIndexedItems;
 }
 
-GenericInputItemVector::const_iterator BitItemsVector::end() const noexcept {
-    return mItems.cend();
+const GenericInputItem* BitItemsVector::genericItem( std::size_t index, std::size_t& indexed_item ) const {
+    // Note: here index is expected to be correct!
+    const auto position = std::lower_bound( mItemsPositions.cbegin(), mItemsPositions.cend(), index );
+    const auto generic_items_before = static_cast< std::size_t >( position - mItemsPositions.cbegin() );
+    if ( position != mItemsPositions.cend() && *position == index ) {
+        return mItems[ generic_items_before ].get();
+    }
+    indexed_item = index - generic_items_before;
+    return nullptr;
 }
 
-GenericInputItemVector::const_iterator BitItemsVector::cbegin() const noexcept {
-    return mItems.cbegin();
+/* Note: separate declaration/definition of the default destructor (and move operations) is needed to use
+ *       incomplete types for the unique_ptr objects stored in the vector. */
+BitItemsVector::~BitItemsVector() = default;
+
+BitItemsVector::const_iterator& BitItemsVector::const_iterator::operator++() noexcept {
+    ++mItem;
+    return *this;
 }
 
-GenericInputItemVector::const_iterator BitItemsVector::cend() const noexcept {
-    return mItems.cend();
+BitItemsVector::const_iterator BitItemsVector::const_iterator::operator++( int ) noexcept { // NOLINT(cert-dcl21-cpp)
+    const_iterator incremented = *this;
+    ++( *this );
+    return incremented;
 }
 
-/* Note: separate declaration/definition of the default destructor is needed to use an incomplete type
- *       for the unique_ptr objects stored in the vector. */
-BitItemsVector::~BitItemsVector() = default;
\ No newline at end of file
+bool BitItemsVector::const_iterator::operator==( const BitItemsVector::const_iterator& other ) const noexcept {
+    return mItem == other.mItem;
+}
+
+bool BitItemsVector::const_iterator::operator!=( const BitItemsVector::const_iterator& other ) const noexcept {
+    return !( *this == other );
+}
+
+BitItemsVector::const_iterator::reference BitItemsVector::const_iterator::operator*() const noexcept {
+    return mItem;
+}
+
+BitItemsVector::const_iterator::pointer BitItemsVector::const_iterator::operator->() const noexcept {
+    return &mItem;
+}
+
+BitItemsVector::const_iterator::const_iterator( BitInputItem item ) noexcept : mItem{ std::move( item ) } {}
+
+BitInputItem::BitInputItem( std::size_t index, const BitItemsVector& items ) noexcept
+    : mIndex{ index }, mItems{ &items } {}
+
+BitInputItem& BitInputItem::operator++() noexcept {
+    ++mIndex;
+    return *this;
+}
+
+BitInputItem BitInputItem::operator++( int ) noexcept { // NOLINT(cert-dcl21-cpp)
+    BitInputItem incremented = *this;
+    ++( *this );
+    return incremented;
+}
+
+bool BitInputItem::operator==( const BitInputItem& other ) const noexcept {
+    return mIndex == other.mIndex && mItems == other.mItems;
+}
+
+bool BitInputItem::operator!=( const BitInputItem& other ) const noexcept {
+    return !( *this == other );
+}
+
+std::size_t BitInputItem::index() const noexcept {
+    return mIndex;
+}
+
+bool BitInputItem::isDir() const {
+    const BitPropVariant is_dir = itemProperty( BitProperty::IsDir );
+    return !is_dir.isEmpty() && is_dir.getBool();
+}
+
+uint64_t BitInputItem::size() const {
+    return mItems->itemSize( mIndex );
+}
+
+tstring BitInputItem::name() const {
+    return fs::path{ path() }.filename().string< tchar >();
+}
+
+tstring BitInputItem::path() const {
+    return mItems->itemPath( mIndex );
+}
+
+fs::path BitInputItem::inArchivePath() const {
+    return mItems->inArchivePath( mIndex );
+}
+
+uint32_t BitInputItem::attributes() const {
+    const BitPropVariant attributes = itemProperty( BitProperty::Attrib );
+    return attributes.isEmpty() ? 0 : attributes.getUInt32();
+}
+
+BitPropVariant BitInputItem::itemProperty( BitProperty property ) const {
+    return mItems->itemProperty( mIndex, property );
+}
@@ -12,6 +12,8 @@
 
 #include "bitoutputarchive.hpp"
 
+#include <unordered_set>
+
 #include "biterror.hpp"
 #include "bitexception.hpp"
 #include "internal/archiveproperties.hpp"
@@ -19,6 +21,8 @@
 #include "internal/cmultivolumeoutstream.hpp"
 #include "internal/fsutil.hpp"
 #include "internal/genericinputitem.hpp"
+#include "internal/iostats.hpp"
+#include "internal/tracing.hpp"
 #include "internal/updatecallback.hpp"
 #include "internal/util.hpp"
 
@@ -90,6 +94,8 @@ BitOutputArchive::BitOutputArchive( const BitAbstractArchiveCreator& creator, st
 void BitOutputArchive::addItems( const std::vector< tstring >& in_paths ) {
     IndexingOptions options{};
     options.retain_folder_structure = mArchiveCreator.retainDirectories();
+    options.threads = mArchiveCreator.indexingThreads();
+    options.sort_entries = mArchiveCreator.sortedIndexing();
     mNewItemsVector.indexPaths( in_paths, options );
 }
 
@@ -113,6 +119,8 @@ void BitOutputArchive::addFiles( const std::vector< tstring >& in_files ) {
     IndexingOptions options{};
     options.recursive = false;
     options.retain_folder_structure = mArchiveCreator.retainDirectories();
+    options.threads = mArchiveCreator.indexingThreads();
+    options.sort_entries = mArchiveCreator.sortedIndexing();
     options.only_files = true;
     mNewItemsVector.indexPaths( in_files, options );
 }
@@ -121,6 +129,8 @@ void BitOutputArchive::addFiles( const tstring& in_dir, const tstring& filter, b
     IndexingOptions options{};
     options.recursive = recursive;
     options.retain_folder_structure = mArchiveCreator.retainDirectories();
+    options.threads = mArchiveCreator.indexingThreads();
+    options.sort_entries = mArchiveCreator.sortedIndexing();
     options.only_files = true;
     mNewItemsVector.indexDirectory( in_dir, filter, options );
 }
@@ -128,6 +138,8 @@ void BitOutputArchive::addFiles( const tstring& in_dir, const tstring& filter, b
 void BitOutputArchive::addDirectory( const tstring& in_dir ) {
     IndexingOptions options{};
     options.retain_folder_structure = mArchiveCreator.retainDirectories();
+    options.threads = mArchiveCreator.indexingThreads();
+    options.sort_entries = mArchiveCreator.sortedIndexing();
     mNewItemsVector.indexDirectory( in_dir, BIT7Z_STRING( "" ), options );
 }
 
@@ -162,21 +174,46 @@ void BitOutputArchive::compressOut( IOutArchive* out_arc,
                                     IOutStream* out_stream,
                                     UpdateCallback* update_callback ) {
     if ( mInputArchive != nullptr && mArchiveCreator.updateMode() == UpdateMode::Update ) {
-        for ( const auto& new_item : mNewItemsVector ) {
-            auto updated_item = mInputArchive->find( new_item->inArchivePath().string< tchar >() );
-            if ( updated_item != mInputArchive->cend() ) {
-                setDeletedIndex( updated_item->index() );
+        /* Note: instead of searching each new item in the input archive, we collect the paths of the new items
+         *       and then walk the old items only once, so that the cost is linear in the number of items. */
+        std::unordered_set< tstring > new_items_paths;
+        new_items_paths.reserve( mNewItemsVector.size() );
+        for ( std::size_t new_item = 0; new_item < mNewItemsVector.size(); ++new_item ) {
+            new_items_paths.insert( mNewItemsVector.inArchivePath( new_item ).string< tchar >() );
+        }
+        if ( !new_items_paths.empty() ) {
+            for ( const auto& old_item : *mInputArchive ) {
+                if ( new_items_paths.find( old_item.path() ) != new_items_paths.end() ) {
+                    setDeletedIndex( old_item.index() );
+                }
             }
         }
     }
     updateInputIndices();
 
-    const HRESULT result = out_arc->UpdateItems( out_stream, itemsCount(), update_callback );
+    // Note: only the new items are processed (and hence counted) by the update callback.
+    update_callback->beginOperation( mNewItemsVector.size() );
+    HRESULT result;
+    {
+        // Note: when updating an archive, the old items are copied from the input archive's stream.
+        IOStatsCollector* stats_collector = update_callback->ioStatsCollector();
+        const IOStatsAttachment in_stats_attachment{ mInputArchive != nullptr ? mInputArchive->mInStreamStats : nullptr,
+                                                     stats_collector };
+        const IOStatsAttachment out_stats_attachment{ dynamic_cast< IOStatsRecorder* >( out_stream ),
+                                                      stats_collector };
+        BIT7Z_TRACE_SCOPE( "IOutArchive::UpdateItems" );
+        result = out_arc->UpdateItems( out_stream, itemsCount(), update_callback );
+    }
+    update_callback->reportOperationStats();
 
     if ( result == E_NOTIMPL ) {
         throw BitException( bit7z::kUnsupportedOperation, bit7z::make_hresult_code( result ) );
     }
 
+    if ( result == E_ABORT && mArchiveCreator.cancellationToken().isCancelled() ) {
+        throw BitException( kOperationCancelled, make_error_code( BitError::OperationCancelled ) );
+    }
+
     if ( result != S_OK ) {
         throw BitException( "Error while compressing files", make_hresult_code( result ), std::move( mFailedFiles ) );
     }
@@ -253,8 +290,22 @@ void BitOutputArchive::compressTo( std::vector< byte_t >& out_buffer ) {
         }
     }
 
+    /* Estimating the size of the output archive, so that the buffer capacity can be reserved in advance:
+     * the items of the input archive (if any) are copied as they are, while the new items are stored
+     * as they are only in copy mode (otherwise, we cannot know in advance their compressed size). */
+    uint64_t estimated_size = 0;
+    for ( uint32_t index = 0; index < mInputArchiveItemsCount; ++index ) {
+        const BitPropVariant pack_size = mInputArchive->itemProperty( index, BitProperty::PackSize );
+        estimated_size += pack_size.isUInt64() ? pack_size.getUInt64() : 0;
+    }
+    if ( mArchiveCreator.compressionLevel() == BitCompressionLevel::None ) {
+        for ( std::size_t new_item = 0; new_item < mNewItemsVector.size(); ++new_item ) {
+            estimated_size += mNewItemsVector.itemSize( new_item );
+        }
+    }
+
     const CMyComPtr< IOutArchive > new_arc = initOutArchive();
-    auto out_mem_stream = bit7z::make_com< CBufferOutStream, IOutStream >( out_buffer );
+    auto out_mem_stream = bit7z::make_com< CBufferOutStream, IOutStream >( out_buffer, estimated_size );
     auto update_callback = bit7z::make_com< UpdateCallback >( *this );
     compressOut( new_arc, out_mem_stream, update_callback );
 }
@@ -312,17 +363,14 @@ uint32_t BitOutputArchive::itemsCount() const {
 
 BitPropVariant BitOutputArchive::itemProperty( input_index index, BitProperty propID ) const {
     const auto new_item_index = static_cast< size_t >( index ) - static_cast< size_t >( mInputArchiveItemsCount );
-    const GenericInputItem& new_item = mNewItemsVector[ new_item_index ];
-    return new_item.itemProperty( propID );
+    return mNewItemsVector.itemProperty( new_item_index, propID );
 }
 
 HRESULT BitOutputArchive::itemStream( input_index index, ISequentialInStream** inStream ) const {
     const auto new_item_index = static_cast< size_t >( index ) - static_cast< size_t >( mInputArchiveItemsCount );
-    const GenericInputItem& new_item = mNewItemsVector[ new_item_index ];
-
-    const HRESULT res = new_item.getStream( inStream );
+    const HRESULT res = mNewItemsVector.itemStream( new_item_index, inStream );
     if ( FAILED( res ) ) {
-        auto path = new_item.path();
+        auto path = mNewItemsVector.itemPath( new_item_index );
         std::error_code error;
         if ( fs::exists( path, error ) ) {
             error = std::make_error_code( std::errc::file_exists );
@@ -0,0 +1,98 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "bitprogressmonitor.hpp"
+
+#include <atomic>
+
+using namespace bit7z;
+
+// Note: the counters are independent of each other, so relaxed atomic operations are enough.
+struct BitProgressMonitor::Counters {
+    std::atomic< uint64_t > totalSize{ 0 };
+    std::atomic< uint64_t > processedSize{ 0 };
+    std::atomic< uint64_t > totalItems{ 0 };
+    std::atomic< uint64_t > processedItems{ 0 };
+    std::atomic< uint32_t > currentItem{ 0 };
+    std::atomic< uint64_t > inputSize{ 0 };
+    std::atomic< uint64_t > outputSize{ 0 };
+};
+
+BitProgressMonitor::BitProgressMonitor() : mCounters{ std::make_shared< Counters >() } {}
+
+uint64_t BitProgressMonitor::totalSize() const noexcept {
+    return mCounters->totalSize.load( std::memory_order_relaxed );
+}
+
+uint64_t BitProgressMonitor::processedSize() const noexcept {
+    return mCounters->processedSize.load( std::memory_order_relaxed );
+}
+
+uint64_t BitProgressMonitor::totalItems() const noexcept {
+    return mCounters->totalItems.load( std::memory_order_relaxed );
+}
+
+uint64_t BitProgressMonitor::processedItems() const noexcept {
+    return mCounters->processedItems.load( std::memory_order_relaxed );
+}
+
+uint32_t BitProgressMonitor::currentItem() const noexcept {
+    return mCounters->currentItem.load( std::memory_order_relaxed );
+}
+
+uint64_t BitProgressMonitor::inputSize() const noexcept {
+    return mCounters->inputSize.load( std::memory_order_relaxed );
+}
+
+uint64_t BitProgressMonitor::outputSize() const noexcept {
+    return mCounters->outputSize.load( std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::reset( uint64_t total_items ) const noexcept {
+    mCounters->totalSize.store( 0, std::memory_order_relaxed );
+    mCounters->processedSize.store( 0, std::memory_order_relaxed );
+    mCounters->totalItems.store( total_items, std::memory_order_relaxed );
+    mCounters->processedItems.store( 0, std::memory_order_relaxed );
+    mCounters->currentItem.store( 0, std::memory_order_relaxed );
+    mCounters->inputSize.store( 0, std::memory_order_relaxed );
+    mCounters->outputSize.store( 0, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::setTotalSize( uint64_t total_size ) const noexcept {
+    mCounters->totalSize.store( total_size, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::setProcessedSize( uint64_t processed_size ) const noexcept {
+    mCounters->processedSize.store( processed_size, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::setProcessedItems( uint64_t processed_items ) const noexcept {
+    mCounters->processedItems.store( processed_items, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::addProcessed( uint64_t processed_size, uint64_t processed_items ) const noexcept {
+    mCounters->processedSize.fetch_add( processed_size, std::memory_order_relaxed );
+    mCounters->processedItems.fetch_add( processed_items, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::setCurrentItem( uint32_t index ) const noexcept {
+    mCounters->currentItem.store( index, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::itemCompleted() const noexcept {
+    mCounters->processedItems.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void BitProgressMonitor::setRatioInfo( uint64_t input_size, uint64_t output_size ) const noexcept {
+    mCounters->inputSize.store( input_size, std::memory_order_relaxed );
+    mCounters->outputSize.store( output_size, std::memory_order_relaxed );
+}
@@ -0,0 +1,59 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef BIT7Z_ENABLE_TRACING
+
+#include "bittrace.hpp"
+
+#include <algorithm>
+
+#include "internal/tracing.hpp"
+
+using namespace bit7z;
+
+namespace {
+
+// Writes the given nanoseconds as microseconds (the time unit of trace-event files).
+void writeMicroseconds( std::ostream& out, uint64_t nanoseconds ) {
+    const uint64_t fraction = nanoseconds % 1000;
+    out << ( nanoseconds / 1000 ) << '.' << ( fraction / 100 ) << ( ( fraction / 10 ) % 10 ) << ( fraction % 10 );
+}
+
+} // namespace
+
+void bit7z::writeChromeTrace( std::ostream& out ) {
+    std::vector< TraceEvent > events = collectTraceEvents();
+    std::stable_sort( events.begin(), events.end(), []( const TraceEvent& first, const TraceEvent& second ) {
+        return first.start < second.start;
+    } );
+
+    out << "{\"traceEvents\":[";
+    bool first_event = true;
+    for ( const auto& event : events ) {
+        // Note: the span names are string literals of the library, so they never need escaping.
+        out << ( first_event ? "\n" : ",\n" )
+            << R"({"name":")" << event.name << R"(","cat":"bit7z","ph":"X","pid":1,"tid":)" << event.threadIndex
+            << R"(,"ts":)";
+        writeMicroseconds( out, event.start );
+        out << R"(,"dur":)";
+        writeMicroseconds( out, event.duration );
+        out << '}';
+        first_event = false;
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void bit7z::clearTrace() {
+    clearTraceEvents();
+}
+
+#endif
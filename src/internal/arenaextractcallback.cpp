@@ -0,0 +1,106 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/arenaextractcallback.hpp"
+
+#include <limits>
+
+#include "biterror.hpp"
+#include "bitexception.hpp"
+#include "internal/ccallbackoutstream.hpp"
+#include "internal/fs.hpp"
+#include "internal/util.hpp"
+
+using namespace bit7z;
+
+ArenaExtractCallback::ArenaExtractCallback( const BitInputArchive& inputArchive, BitItemsArena& arena )
+    : ExtractCallback( inputArchive ),
+      mArena( arena ),
+      mItemSizeLimit{ ( std::numeric_limits< uint64_t >::max )() },
+      mArenaSink{ [ this ]( const byte_t* data, std::size_t size ) -> bool {
+          // Note: the arena space is reserved using the items' sizes, so we do not let an item grow beyond its size.
+          if ( size > mItemSizeLimit - mArena.mEntries.back().size ) {
+              throw BitException( "The extracted item is larger than its declared size",
+                                  make_error_code( BitError::InvalidOutputBufferSize ) );
+          }
+          mArena.mData.insert( mArena.mData.end(), data, data + size );
+          mArena.mEntries.back().size += size;
+          return true;
+      } } {}
+
+void ArenaExtractCallback::reserve( const vector< uint32_t >& indices ) {
+    uint64_t total_size = 0;
+    for ( const auto index : indices ) {
+        const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+        total_size += item_size.isUInt64() ? item_size.getUInt64() : 0;
+    }
+    if ( total_size > mArena.mData.max_size() - mArena.mData.size() ) {
+        return;
+    }
+    try {
+        mArena.mData.reserve( mArena.mData.size() + static_cast< std::size_t >( total_size ) );
+        mArena.mEntries.reserve( mArena.mEntries.size() + indices.size() );
+    } catch ( const std::bad_alloc& ) {
+        // The reservation is just an optimization: if it fails, the arena will grow as needed.
+    }
+}
+
+const std::exception_ptr& ArenaExtractCallback::sinkError() const noexcept {
+    return mSinkError;
+}
+
+void ArenaExtractCallback::releaseStream() {
+    mArenaOutStream.Release();
+}
+
+HRESULT ArenaExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    // Get Name
+    const BitPropVariant prop = itemProperty( index, BitProperty::Path );
+    tstring fullPath;
+
+    if ( prop.isEmpty() ) {
+        fullPath = kEmptyFileAlias;
+    } else if ( prop.isString() ) {
+        fullPath = prop.getString();
+        if ( !mHandler.retainDirectories() ) {
+            fullPath = fs::path{ fullPath }.filename().string< tchar >();
+        }
+    } else {
+        return E_FAIL;
+    }
+
+    if ( mHandler.fileCallback() ) {
+        mHandler.fileCallback()( fullPath );
+    }
+
+    const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+    mItemSizeLimit = item_size.isUInt64() ? item_size.getUInt64() : ( std::numeric_limits< uint64_t >::max )();
+
+    const BitPropVariant crc = itemProperty( index, BitProperty::CRC );
+    mArena.mEntries.push_back( BitArenaEntry{ index,
+                                              mArena.mPaths.size(),
+                                              fullPath.size(),
+                                              mArena.mData.size(),
+                                              0,
+                                              crc.isUInt32() ? crc.getUInt32() : 0 } );
+    mArena.mPaths.append( fullPath );
+    mArena.mPaths.push_back( BIT7Z_STRING( '\0' ) ); // Paths in the arena are null-terminated.
+
+    auto outStreamLoc = bit7z::make_com< CCallbackOutStream, ISequentialOutStream >( mArenaSink, mSinkError );
+    mArenaOutStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
@@ -0,0 +1,61 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ARENAEXTRACTCALLBACK_HPP
+#define ARENAEXTRACTCALLBACK_HPP
+
+#include <exception>
+
+#include "bititemsarena.hpp"
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief Extract callback appending the content of each extracted item to the data arena of a BitItemsArena.
+ */
+class ArenaExtractCallback final : public ExtractCallback {
+    public:
+        ArenaExtractCallback( const BitInputArchive& inputArchive, BitItemsArena& arena );
+
+        ArenaExtractCallback( const ArenaExtractCallback& ) = delete;
+
+        ArenaExtractCallback( ArenaExtractCallback&& ) = delete;
+
+        ArenaExtractCallback& operator=( const ArenaExtractCallback& ) = delete;
+
+        ArenaExtractCallback& operator=( ArenaExtractCallback&& ) = delete;
+
+        ~ArenaExtractCallback() override = default;
+
+        /**
+         * @brief Reserves the arena memory for the given items, using their sizes.
+         */
+        void reserve( const vector< uint32_t >& indices );
+
+        /**
+         * @return the exception thrown while appending data to the arena (e.g., std::bad_alloc), if any.
+         */
+        BIT7Z_NODISCARD const std::exception_ptr& sinkError() const noexcept;
+
+    private:
+        BitItemsArena& mArena;
+        uint64_t mItemSizeLimit; // The Size property of the item being extracted, if any.
+        SinkCallback mArenaSink;
+        std::exception_ptr mSinkError;
+        CMyComPtr< ISequentialOutStream > mArenaOutStream;
+
+        void releaseStream() override;
+
+        HRESULT getOutStream( uint32_t index, ISequentialOutStream** outStream ) override;
+};
+
+}  // namespace bit7z
+
+#endif // ARENAEXTRACTCALLBACK_HPP
@@ -0,0 +1,58 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/blockbufferextractcallback.hpp"
+
+#include "internal/cbufferoutstream.hpp"
+#include "internal/util.hpp"
+
+using namespace bit7z;
+
+BlockBufferExtractCallback::BlockBufferExtractCallback( const BitInputArchive& inputArchive,
+                                                        uint32_t targetIndex,
+                                                        map< uint32_t, vector< byte_t > >& buffersMap )
+    : ExtractCallback( inputArchive ),
+      mTargetIndex( targetIndex ),
+      mBuffersMap( buffersMap ) {}
+
+void BlockBufferExtractCallback::releaseStream() {
+    mOutMemStream.Release();
+}
+
+HRESULT BlockBufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) {
+    if ( isItemFolder( index ) ) {
+        return S_OK;
+    }
+
+    if ( index == mTargetIndex && mHandler.fileCallback() ) {
+        const BitPropVariant prop = itemProperty( index, BitProperty::Path );
+        if ( prop.isEmpty() ) {
+            mHandler.fileCallback()( kEmptyFileAlias );
+        } else if ( prop.isString() ) {
+            mHandler.fileCallback()( prop.getString() );
+        } else {
+            return E_FAIL;
+        }
+    }
+
+    //Note: using [] operator it creates the buffer if it does not already exist!
+    auto& out_buffer = mBuffersMap[ index ];
+    out_buffer.clear();
+
+    const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+    auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >(
+        out_buffer, item_size.isUInt64() ? item_size.getUInt64() : 0
+    );
+    mOutMemStream = outStreamLoc;
+    *outStream = outStreamLoc.Detach();
+    return S_OK;
+}
@@ -0,0 +1,55 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BLOCKBUFFEREXTRACTCALLBACK_HPP
+#define BLOCKBUFFEREXTRACTCALLBACK_HPP
+
+#include <vector>
+#include <map>
+
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+using std::vector;
+using std::map;
+
+/**
+ * @brief Extract callback used to decode all the items of a solid block into memory buffers (indexed by item index).
+ *
+ * Only the item explicitly requested by the user (the target item) is notified to the file callback.
+ */
+class BlockBufferExtractCallback final : public ExtractCallback {
+    public:
+        BlockBufferExtractCallback( const BitInputArchive& inputArchive,
+                                    uint32_t targetIndex,
+                                    map< uint32_t, vector< byte_t > >& buffersMap );
+
+        BlockBufferExtractCallback( const BlockBufferExtractCallback& ) = delete;
+
+        BlockBufferExtractCallback( BlockBufferExtractCallback&& ) = delete;
+
+        BlockBufferExtractCallback& operator=( const BlockBufferExtractCallback& ) = delete;
+
+        BlockBufferExtractCallback& operator=( BlockBufferExtractCallback&& ) = delete;
+
+        ~BlockBufferExtractCallback() override = default;
+
+    private:
+        uint32_t mTargetIndex;
+        map< uint32_t, vector< byte_t > >& mBuffersMap;
+        CMyComPtr< ISequentialOutStream > mOutMemStream;
+
+        void releaseStream() override;
+
+        HRESULT getOutStream( uint32_t index, ISequentialOutStream** outStream ) override;
+};
+
+}  // namespace bit7z
+#endif // BLOCKBUFFEREXTRACTCALLBACK_HPP
@@ -72,7 +72,10 @@ HRESULT BufferExtractCallback::getOutStream( uint32_t index, ISequentialOutStrea
         }
     }
 
-    auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >( out_buffer );
+    const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+    auto outStreamLoc = bit7z::make_com< CBufferOutStream, ISequentialOutStream >(
+        out_buffer, item_size.isUInt64() ? item_size.getUInt64() : 0
+    );
     mOutMemStream = outStreamLoc;
     *outStream = outStreamLoc.Detach();
     return S_OK;
@@ -0,0 +1,118 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/bufferpool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace bit7z;
+
+PooledBuffer::PooledBuffer( std::unique_ptr< char[] > buffer, std::size_t size ) noexcept // NOLINT(*-avoid-c-arrays)
+    : mBuffer{ std::move( buffer ) }, mSize{ size } {}
+
+PooledBuffer::~PooledBuffer() {
+    if ( mBuffer ) {
+        BufferPool::instance().release( std::move( mBuffer ), mSize );
+    }
+}
+
+char* PooledBuffer::data() const noexcept {
+    return mBuffer.get();
+}
+
+std::size_t PooledBuffer::size() const noexcept {
+    return mSize;
+}
+
+BufferPool::BufferPool() : mStats{} {}
+
+BufferPool& BufferPool::instance() {
+    static BufferPool pool;
+    return pool;
+}
+
+std::size_t BufferPool::bufferSize( uint64_t stream_size ) noexcept {
+    if ( stream_size >= kMaxBufferSize ) { // Note: this includes kUnknownStreamSize.
+        return kMaxBufferSize;
+    }
+    std::size_t size = kMinBufferSize;
+    while ( size < stream_size ) {
+        size *= 2;
+    }
+    return size;
+}
+
+std::size_t BufferPool::sizeClass( std::size_t size ) noexcept {
+    std::size_t size_class = 0;
+    for ( std::size_t class_size = kMinBufferSize; class_size < size; class_size *= 2 ) {
+        ++size_class;
+    }
+    return size_class;
+}
+
+PooledBuffer BufferPool::acquire( uint64_t stream_size ) {
+    const std::size_t size = bufferSize( stream_size );
+    {
+        const std::lock_guard< std::mutex > lock( mMutex );
+        ++mStats.acquiredBuffers;
+        mStats.bytesInUse += size;
+        mStats.peakBytesInUse = std::max( mStats.peakBytesInUse, mStats.bytesInUse );
+
+        auto& free_buffers = mFreeBuffers[ sizeClass( size ) ];
+        if ( !free_buffers.empty() ) {
+            std::unique_ptr< char[] > buffer = std::move( free_buffers.back() ); // NOLINT(*-avoid-c-arrays)
+            free_buffers.pop_back();
+            ++mStats.reusedBuffers;
+            mStats.cachedBytes -= size;
+            return PooledBuffer{ std::move( buffer ), size };
+        }
+        mStats.allocatedBytes += size;
+    }
+    // Note: the buffer is allocated outside the lock, and it is not zero-initialized.
+    return PooledBuffer{ std::unique_ptr< char[] >( new char[ size ] ), size }; // NOLINT(*-avoid-c-arrays)
+}
+
+void BufferPool::release( std::unique_ptr< char[] > buffer, std::size_t size ) noexcept { // NOLINT(*-avoid-c-arrays)
+    const std::lock_guard< std::mutex > lock( mMutex );
+    mStats.bytesInUse -= size;
+    if ( mStats.cachedBytes + size > kMaxCachedBytes ) {
+        return; // The pool is full, so the buffer is freed.
+    }
+    try {
+        mFreeBuffers[ sizeClass( size ) ].push_back( std::move( buffer ) );
+        mStats.cachedBytes += size;
+    } catch ( const std::bad_alloc& ) {
+        // Could not cache the buffer: it is simply freed.
+    }
+}
+
+BitBufferPoolStats BufferPool::stats() const {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    return mStats;
+}
+
+void BufferPool::trim() {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    for ( auto& free_buffers : mFreeBuffers ) {
+        free_buffers.clear();
+    }
+    mStats.cachedBytes = 0;
+}
+
+BitBufferPoolStats bit7z::bufferPoolStats() {
+    return BufferPool::instance().stats();
+}
+
+void bit7z::trimBufferPool() {
+    BufferPool::instance().trim();
+}
@@ -0,0 +1,97 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef BUFFERPOOL_HPP
+#define BUFFERPOOL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bitbufferpool.hpp"
+
+namespace bit7z {
+
+constexpr auto kUnknownStreamSize = std::numeric_limits< uint64_t >::max();
+
+class BufferPool;
+
+/**
+ * @brief An (uninitialized) I/O buffer borrowed from the BufferPool, and given back to it on destruction.
+ */
+class PooledBuffer final {
+    public:
+        PooledBuffer( std::unique_ptr< char[] > buffer, std::size_t size ) noexcept; // NOLINT(*-avoid-c-arrays)
+
+        PooledBuffer( const PooledBuffer& ) = delete;
+
+        PooledBuffer( PooledBuffer&& other ) noexcept = default;
+
+        PooledBuffer& operator=( const PooledBuffer& ) = delete;
+
+        PooledBuffer& operator=( PooledBuffer&& other ) noexcept = delete;
+
+        ~PooledBuffer();
+
+        BIT7Z_NODISCARD char* data() const noexcept;
+
+        BIT7Z_NODISCARD std::size_t size() const noexcept;
+
+    private:
+        std::unique_ptr< char[] > mBuffer; // NOLINT(*-avoid-c-arrays)
+        std::size_t mSize;
+};
+
+/**
+ * @brief Process-wide pool of reusable I/O buffers, whose sizes are powers of two
+ * between kMinBufferSize and kMaxBufferSize.
+ */
+class BufferPool final {
+    public:
+        static constexpr std::size_t kMinBufferSize = 4 * 1024; // 4 KiB
+        static constexpr std::size_t kMaxBufferSize = 1024 * 1024; // 1 MiB
+        static constexpr std::size_t kMaxCachedBytes = 16 * kMaxBufferSize;
+
+        static BufferPool& instance();
+
+        /**
+         * @return the size of the buffers used for streams having the given size.
+         */
+        BIT7Z_NODISCARD static std::size_t bufferSize( uint64_t stream_size ) noexcept;
+
+        /**
+         * @brief Borrows a buffer suitable for a stream having the given size (if known).
+         */
+        BIT7Z_NODISCARD PooledBuffer acquire( uint64_t stream_size = kUnknownStreamSize );
+
+        void release( std::unique_ptr< char[] > buffer, std::size_t size ) noexcept; // NOLINT(*-avoid-c-arrays)
+
+        BIT7Z_NODISCARD BitBufferPoolStats stats() const;
+
+        void trim();
+
+    private:
+        static constexpr std::size_t kSizeClasses = 9; // From 4 KiB (2^12) to 1 MiB (2^20).
+
+        mutable std::mutex mMutex;
+        std::array< std::vector< std::unique_ptr< char[] > >, kSizeClasses > mFreeBuffers; // NOLINT(*-avoid-c-arrays)
+        BitBufferPoolStats mStats;
+
+        BufferPool();
+
+        static std::size_t sizeClass( std::size_t size ) noexcept;
+};
+
+}  // namespace bit7z
+
+#endif //BUFFERPOOL_HPP
@@ -14,4 +14,50 @@
 
 using namespace bit7z;
 
-Callback::Callback( const BitAbstractArchiveHandler& handler ) : mHandler( handler ) {}
\ No newline at end of file
+Callback::Callback( const BitAbstractArchiveHandler& handler )
+    : mHandler( handler ),
+      mIOStats{ handler.operationStatsCallback() ? std::make_unique< IOStatsCollector >() : nullptr } {}
+
+void Callback::beginOperation( uint64_t items_count ) const noexcept {
+    mHandler.progressMonitor().reset( items_count );
+}
+
+IOStatsCollector* Callback::ioStatsCollector() const noexcept {
+    return mIOStats.get();
+}
+
+void Callback::reportOperationStats() const {
+    if ( mIOStats ) {
+        mHandler.operationStatsCallback()( mIOStats->stats() );
+    }
+}
+
+void Callback::notifyTotal( uint64_t total_size ) const {
+    mHandler.progressMonitor().setTotalSize( total_size );
+    const auto& total_callback = mHandler.totalCallback();
+    if ( total_callback ) {
+        total_callback( total_size );
+    }
+}
+
+bool Callback::notifyProgress( uint64_t processed_size ) const {
+    mHandler.progressMonitor().setProcessedSize( processed_size );
+    const auto& progress_callback = mHandler.progressCallback();
+    return !progress_callback || progress_callback( processed_size );
+}
+
+void Callback::notifyRatio( uint64_t input_size, uint64_t output_size ) const {
+    mHandler.progressMonitor().setRatioInfo( input_size, output_size );
+    const auto& ratio_callback = mHandler.ratioCallback();
+    if ( ratio_callback ) {
+        ratio_callback( input_size, output_size );
+    }
+}
+
+void Callback::notifyCurrentItem( uint32_t index ) const noexcept {
+    mHandler.progressMonitor().setCurrentItem( index );
+}
+
+void Callback::notifyItemCompleted() const noexcept {
+    mHandler.progressMonitor().itemCompleted();
+}
\ No newline at end of file
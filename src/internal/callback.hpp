@@ -10,14 +10,17 @@
 #ifndef CALLBACK_HPP
 #define CALLBACK_HPP
 
+#include <memory>
 #include <string>
 
 #include "bitabstractarchivehandler.hpp"
 #include "internal/guids.hpp"
+#include "internal/iostats.hpp"
 
 #include <Common/MyCom.h>
 
 constexpr auto kPasswordNotDefined = "Password is not defined";
+constexpr auto kOperationCancelled = "The operation was cancelled";
 constexpr auto kEmptyFileAlias = BIT7Z_STRING( "[Content]" );
 
 namespace bit7z {
@@ -46,10 +49,42 @@ class Callback : protected CMyUnknownImp {
 
         CALLBACK_DESTRUCTOR( ~Callback() ) = default;
 
+        /**
+         * @brief Resets the handler's progress monitor before starting an operation on the given number of items.
+         */
+        void beginOperation( uint64_t items_count ) const noexcept;
+
+        /**
+         * @return the collector of the I/O statistics of the operation, or nullptr if the handler
+         *         has no operation stats callback.
+         */
+        BIT7Z_NODISCARD IOStatsCollector* ioStatsCollector() const noexcept;
+
+        /**
+         * @brief Calls the handler's operation stats callback (if any) with the statistics collected so far.
+         */
+        void reportOperationStats() const;
+
     protected:
         explicit Callback( const BitAbstractArchiveHandler& handler ); // Abstract class
 
+        // Note: the following functions update the handler's progress monitor and then call the user callbacks
+        // (if any), without copying them.
+
+        void notifyTotal( uint64_t total_size ) const;
+
+        BIT7Z_NODISCARD bool notifyProgress( uint64_t processed_size ) const;
+
+        void notifyRatio( uint64_t input_size, uint64_t output_size ) const;
+
+        void notifyCurrentItem( uint32_t index ) const noexcept;
+
+        void notifyItemCompleted() const noexcept;
+
         const BitAbstractArchiveHandler& mHandler;
+
+    private:
+        std::unique_ptr< IOStatsCollector > mIOStats;
 };
 
 }  // namespace bit7z
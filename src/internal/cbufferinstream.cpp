@@ -29,6 +29,7 @@ CBufferInStream::CBufferInStream( const vector< byte_t >& in_buffer )
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Read };
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -52,6 +53,7 @@ STDMETHODIMP CBufferInStream::Read( void* data, UInt32 size, UInt32* processedSi
     /* Note: here remaining is > 0 */
     std::copy_n( mCurrentPosition, remaining, static_cast< byte_t* >( data ) );
     std::advance( mCurrentPosition, remaining );
+    stats_record.setBytes( remaining );
 
     if ( processedSize != nullptr ) {
         /* Note: even though on 64-bit systems "remaining" will be a 64-bit unsigned integer (size_t),
@@ -63,6 +65,8 @@ STDMETHODIMP CBufferInStream::Read( void* data, UInt32 size, UInt32* processedSi
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
+    const auto old_index = static_cast< uint64_t >( mCurrentPosition - mBuffer.cbegin() );
     int64_t new_index{};
     const HRESULT res = seek( mBuffer, mCurrentPosition, offset, seekOrigin, new_index );
 
@@ -73,6 +77,7 @@ STDMETHODIMP CBufferInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* new
 
     // Note: new_index can be equal to mBuffer.size(); in this case, mCurrentPosition == mBuffer.cend()
     mCurrentPosition = mBuffer.cbegin() + static_cast< index_t >( new_index );
+    stats_record.setSeek( old_index, static_cast< uint64_t >( new_index ) );
 
     if ( newPosition != nullptr ) {
         // Safe cast, since new_index >= 0
@@ -12,6 +12,7 @@
 
 #include "bittypes.hpp"
 #include "internal/guids.hpp"
+#include "internal/iostats.hpp"
 #include "internal/macros.hpp"
 
 #include <7zip/IStream.h>
@@ -21,7 +22,7 @@ namespace bit7z {
 
 using std::vector;
 
-class CBufferInStream final : public IInStream, public CMyUnknownImp {
+class CBufferInStream final : public IInStream, public CMyUnknownImp, public IOStatsRecorder {
     public:
         explicit CBufferInStream( const vector< byte_t >& in_buffer );
 
@@ -18,21 +18,40 @@
 
 using namespace bit7z;
 
-CBufferOutStream::CBufferOutStream( vector< byte_t >& out_buffer )
-    : mBuffer( out_buffer ), mCurrentPosition{ mBuffer.begin() } {}
+CBufferOutStream::CBufferOutStream( vector< byte_t >& out_buffer, uint64_t size_hint )
+    : mBuffer( out_buffer ), mCurrentPosition{ mBuffer.begin() } {
+    if ( size_hint > mBuffer.capacity() && size_hint <= mBuffer.max_size() ) {
+        try {
+            mBuffer.reserve( static_cast< vector< byte_t >::size_type >( size_hint ) );
+        } catch ( ... ) {
+            // The size hint is just an optimization: if we cannot reserve the memory, the buffer will grow as needed.
+        }
+        mCurrentPosition = mBuffer.begin(); // reserve may have invalidated the old mCurrentPosition iterator
+    }
+}
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferOutStream::SetSize( UInt64 newSize ) {
+    if ( newSize > mBuffer.max_size() ) {
+        return E_OUTOFMEMORY;
+    }
+
+    const auto current_index = static_cast< vector< byte_t >::size_type >( mCurrentPosition - mBuffer.begin() );
     try {
         mBuffer.resize( static_cast< vector< byte_t >::size_type >( newSize ) );
-        return S_OK;
     } catch ( ... ) {
         return E_OUTOFMEMORY;
     }
+    // Note: resize may have invalidated the old mCurrentPosition iterator; moreover, the buffer stream cannot
+    // be positioned past the end of the buffer, so if the buffer was shrunk, the position is moved to the new end.
+    mCurrentPosition = mBuffer.begin() + static_cast< index_t >( std::min( current_index, mBuffer.size() ) );
+    return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
+    const auto old_index = static_cast< uint64_t >( mCurrentPosition - mBuffer.begin() );
     int64_t new_index{};
     const HRESULT res = seek( mBuffer, mCurrentPosition, offset, seekOrigin, new_index );
 
@@ -43,6 +62,7 @@ STDMETHODIMP CBufferOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* ne
 
     // Note: new_index can be equal to mBuffer.size(); in this case, mCurrentPosition == mBuffer.cend()
     mCurrentPosition = mBuffer.begin() + static_cast< index_t >( new_index );
+    stats_record.setSeek( old_index, static_cast< uint64_t >( new_index ) );
 
     if ( newPosition != nullptr ) {
         // Safe cast, since new_index >=0 0
@@ -54,6 +74,7 @@ STDMETHODIMP CBufferOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* ne
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CBufferOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Write };
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -62,25 +83,33 @@ STDMETHODIMP CBufferOutStream::Write( const void* data, UInt32 size, UInt32* pro
         return E_FAIL;
     }
 
-    auto old_pos = ( mCurrentPosition - mBuffer.begin() );
+    // Note: thanks to CBufferOutStream::Seek, the current position is never past the end of the buffer.
+    const auto old_pos = static_cast< size_t >( mCurrentPosition - mBuffer.begin() );
     const size_t new_pos = old_pos + size;
-    if ( new_pos > mBuffer.size() ) {
-        try {
-            mBuffer.resize( new_pos );
-        } catch ( ... ) {
-            return E_OUTOFMEMORY;
-        }
-        mCurrentPosition = mBuffer.begin() + old_pos; //resize invalidated the old mCurrentPosition iterator
+    if ( new_pos > mBuffer.max_size() ) {
+        return E_OUTOFMEMORY;
     }
 
     const auto* byte_data = static_cast< const byte_t* >( data );
     try {
-        std::copy_n( byte_data, size, mCurrentPosition );
+        if ( new_pos > mBuffer.capacity() ) {
+            // Growing the buffer capacity geometrically, so that the amortized cost of each write is constant.
+            mBuffer.reserve( std::max( new_pos, std::min( 2 * mBuffer.capacity(), mBuffer.max_size() ) ) );
+        }
+
+        // Overwriting the bytes already in the buffer, and appending the remaining ones.
+        // Note: differently from resizing the buffer, appending doesn't zero-initialize the new bytes first.
+        const size_t overwritten_size = std::min( static_cast< size_t >( size ), mBuffer.size() - old_pos );
+        std::copy_n( byte_data, overwritten_size, mBuffer.begin() + static_cast< index_t >( old_pos ) );
+        mBuffer.insert( mBuffer.end(), byte_data + overwritten_size, byte_data + size );
     } catch ( ... ) {
+        mCurrentPosition = mBuffer.begin() + static_cast< index_t >( old_pos ); // The buffer may have been reallocated.
         return E_OUTOFMEMORY;
     }
 
-    std::advance( mCurrentPosition, size );
+    //Note: the writes may have invalidated the old mCurrentPosition iterator
+    mCurrentPosition = mBuffer.begin() + static_cast< index_t >( new_pos );
+    stats_record.setBytes( size );
 
     if ( processedSize != nullptr ) {
         *processedSize = size;
@@ -12,6 +12,7 @@
 
 #include "bittypes.hpp"
 #include "internal/guids.hpp"
+#include "internal/iostats.hpp"
 #include "internal/macros.hpp"
 
 #include <7zip/IStream.h>
@@ -21,9 +22,14 @@ namespace bit7z {
 
 using std::vector;
 
-class CBufferOutStream final : public IOutStream, public CMyUnknownImp {
+class CBufferOutStream final : public IOutStream, public CMyUnknownImp, public IOStatsRecorder {
     public:
-        explicit CBufferOutStream( vector< byte_t >& out_buffer );
+        /**
+         * @param out_buffer    the output buffer.
+         * @param size_hint     the expected size of the output data (if known, 0 otherwise),
+         *                      used to reserve the buffer capacity in advance.
+         */
+        explicit CBufferOutStream( vector< byte_t >& out_buffer, uint64_t size_hint = 0 );
 
         CBufferOutStream( const CBufferOutStream& ) = delete;
 
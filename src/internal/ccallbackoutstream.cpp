@@ -0,0 +1,43 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/ccallbackoutstream.hpp"
+
+using namespace bit7z;
+
+CCallbackOutStream::CCallbackOutStream( const SinkCallback& sink, std::exception_ptr& sink_error )
+    : mSink( sink ), mSinkError( sink_error ) {}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CCallbackOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    try {
+        if ( !mSink( static_cast< const byte_t* >( data ), static_cast< std::size_t >( size ) ) ) {
+            return E_ABORT;
+        }
+    } catch ( ... ) {
+        mSinkError = std::current_exception();
+        return E_ABORT;
+    }
+
+    if ( processedSize != nullptr ) {
+        *processedSize = size;
+    }
+    return S_OK;
+}
@@ -0,0 +1,57 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CCALLBACKOUTSTREAM_HPP
+#define CCALLBACKOUTSTREAM_HPP
+
+#include <exception>
+
+#include "bitinputarchive.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+#include <Common/MyCom.h>
+
+namespace bit7z {
+
+/**
+ * @brief Output stream passing the written data directly to a user-provided sink callback, without buffering it.
+ */
+class CCallbackOutStream final : public ISequentialOutStream, public CMyUnknownImp {
+    public:
+        /**
+         * @param sink          the callback receiving the written data.
+         * @param sink_error    where to store the exception eventually thrown by the sink.
+         */
+        CCallbackOutStream( const SinkCallback& sink, std::exception_ptr& sink_error );
+
+        CCallbackOutStream( const CCallbackOutStream& ) = delete;
+
+        CCallbackOutStream( CCallbackOutStream&& ) = delete;
+
+        CCallbackOutStream& operator=( const CCallbackOutStream& ) = delete;
+
+        CCallbackOutStream& operator=( CCallbackOutStream&& ) = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CCallbackOutStream() ) = default;
+
+        MY_UNKNOWN_IMP1( ISequentialOutStream ) // NOLINT(modernize-use-noexcept)
+
+        // ISequentialOutStream
+        BIT7Z_STDMETHOD( Write, const void* data, UInt32 size, UInt32* processedSize );
+
+    private:
+        const SinkCallback& mSink;
+        std::exception_ptr& mSinkError;
+};
+
+}  // namespace bit7z
+
+#endif // CCALLBACKOUTSTREAM_HPP
@@ -16,14 +16,17 @@
 
 using namespace bit7z;
 
-CFileInStream::CFileInStream( const fs::path& filePath ) : CStdInStream( mFileStream ), mBuffer{} {
-    open( filePath );
-
+CFileInStream::CFileInStream( const fs::path& filePath, uint64_t fileSize )
+    : CStdInStream( mFileStream ), mBuffer{ BufferPool::instance().acquire( fileSize ) } {
     /* By default, file stream performance is relatively poor due to the default buffer size used
      * (e.g., GCC uses a small 1024 bytes buffer).
      * This is a known problem (see https://stackoverflow.com/questions/26095160/why-are-stdfstreams-so-slow).
-     * We make the underlying file stream use a bigger buffer (1 MiB) for optimizing the reading of big files.  */
-    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), buffer_size );
+     * We make the underlying file stream use a bigger buffer (up to 1 MiB, depending on the file size, if known)
+     * borrowed from the buffers pool, for optimizing the reading of big files.
+     * Note: the buffer must be set before opening the file, otherwise some implementations (e.g., libstdc++)
+     * ignore it. */
+    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), static_cast< std::streamsize >( mBuffer.size() ) );
+    open( filePath );
 }
 
 void CFileInStream::open( const fs::path& filePath ) {
@@ -10,9 +10,8 @@
 #ifndef CFILEINSTREAM_HPP
 #define CFILEINSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
+#include "internal/bufferpool.hpp"
 #include "internal/cstdinstream.hpp"
 #include "internal/fs.hpp"
 
@@ -20,14 +19,14 @@ namespace bit7z {
 
 class CFileInStream : public CStdInStream {
     public:
-        explicit CFileInStream( const fs::path& filePath );
+        explicit CFileInStream( const fs::path& filePath, uint64_t fileSize = kUnknownStreamSize );
 
         void open( const fs::path& filePath );
 
     private:
+        // Note: the buffer must be declared before the file stream, so that it is destroyed after it.
+        PooledBuffer mBuffer;
         fs::ifstream mFileStream;
-        static constexpr auto buffer_size = 1024 * 1024; // 1 MiB
-        std::array< char, buffer_size > mBuffer;
 };
 
 }  // namespace bit7z
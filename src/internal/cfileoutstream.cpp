@@ -18,8 +18,10 @@
 
 using namespace bit7z;
 
-CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways )
-    : CStdOutStream( mFileStream ), mFilePath{ std::move( filePath ) }, mBuffer{} {
+CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways, uint64_t fileSize )
+    : CStdOutStream( mFileStream ),
+      mFilePath{ std::move( filePath ) },
+      mBuffer{ BufferPool::instance().acquire( fileSize ) } {
     std::error_code error;
     if ( !createAlways && fs::exists( mFilePath, error ) ) {
         if ( !error ) {
@@ -28,14 +30,15 @@ CFileOutStream::CFileOutStream( fs::path filePath, bool createAlways )
         }
         throw BitException( "Failed to create the output file", error, mFilePath.string< tchar >() );
     }
+    // Note: the buffer must be set before opening the file, otherwise some implementations (e.g., libstdc++)
+    // ignore it.
+    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), static_cast< std::streamsize >( mBuffer.size() ) );
     mFileStream.open( mFilePath, std::ios::binary | std::ios::trunc );
     if ( mFileStream.fail() ) {
         throw BitException( "Failed to open the output file",
                             make_hresult_code( HRESULT_FROM_WIN32( ERROR_OPEN_FAILED ) ),
                             mFilePath.string< tchar >() );
     }
-
-    mFileStream.rdbuf()->pubsetbuf( mBuffer.data(), buffer_size );
 }
 
 bool CFileOutStream::fail() const {
@@ -10,9 +10,8 @@
 #ifndef CFILEOUTSTREAM_HPP
 #define CFILEOUTSTREAM_HPP
 
-#include <array>
-
 #include "bitdefines.hpp"
+#include "internal/bufferpool.hpp"
 #include "internal/cstdoutstream.hpp"
 #include "internal/fs.hpp"
 
@@ -20,7 +19,9 @@ namespace bit7z {
 
 class CFileOutStream : public CStdOutStream {
     public:
-        explicit CFileOutStream( fs::path filePath, bool createAlways = false );
+        explicit CFileOutStream( fs::path filePath,
+                                 bool createAlways = false,
+                                 uint64_t fileSize = kUnknownStreamSize );
 
         BIT7Z_NODISCARD const fs::path& path() const;
 
@@ -30,10 +31,11 @@ class CFileOutStream : public CStdOutStream {
 
     private:
         fs::path mFilePath;
-        fs::ofstream mFileStream;
 
-        static constexpr auto buffer_size = 1024 * 1024; // 1 MiB
-        std::array< char, buffer_size > mBuffer;
+        // Note: the buffer must be declared before the file stream, so that it is destroyed after the stream
+        // has flushed its content to the file.
+        PooledBuffer mBuffer;
+        fs::ofstream mFileStream;
 };
 
 }  // namespace bit7z
@@ -0,0 +1,68 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/clookaheadinstream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "bitexception.hpp"
+
+using namespace bit7z;
+
+CLookAheadInStream::CLookAheadInStream( std::istream& inputStream, std::size_t lookAheadSize )
+    : mInputStream{ inputStream }, mLookAhead( lookAheadSize ), mLookAheadPosition{ 0 } {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    mInputStream.read( reinterpret_cast< char* >( mLookAhead.data() ), static_cast< std::streamsize >( lookAheadSize ) );
+    if ( mInputStream.bad() ) {
+        throw BitException( "Failed to read the input stream", make_hresult_code( HRESULT_FROM_WIN32( ERROR_READ_FAULT ) ) );
+    }
+    mLookAhead.resize( static_cast< std::size_t >( mInputStream.gcount() ) );
+}
+
+const std::vector< byte_t >& CLookAheadInStream::lookAhead() const noexcept {
+    return mLookAhead;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CLookAheadInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 ) {
+        return S_OK;
+    }
+
+    if ( mLookAheadPosition < mLookAhead.size() ) {
+        const auto read_size = static_cast< UInt32 >( std::min< std::size_t >( size,
+                                                                              mLookAhead.size() - mLookAheadPosition ) );
+        std::memcpy( data, mLookAhead.data() + mLookAheadPosition, read_size );
+        mLookAheadPosition += read_size;
+        if ( mLookAheadPosition == mLookAhead.size() ) { // The look-ahead buffer is not needed anymore.
+            mLookAhead.clear();
+            mLookAhead.shrink_to_fit();
+            mLookAheadPosition = 0;
+        }
+        if ( processedSize != nullptr ) {
+            *processedSize = read_size;
+        }
+        return S_OK;
+    }
+
+    mInputStream.clear();
+    mInputStream.read( static_cast< char* >( data ), size );
+    if ( processedSize != nullptr ) {
+        *processedSize = static_cast< UInt32 >( mInputStream.gcount() );
+    }
+    return mInputStream.bad() ? HRESULT_FROM_WIN32( ERROR_READ_FAULT ) : S_OK;
+}
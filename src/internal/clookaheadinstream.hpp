@@ -0,0 +1,65 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLOOKAHEADINSTREAM_HPP
+#define CLOOKAHEADINSTREAM_HPP
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+#include "bittypes.hpp"
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+#include <Common/MyCom.h>
+
+namespace bit7z {
+
+/**
+ * @brief Forward-only input stream reading a std::istream without ever seeking it (e.g., a pipe or a socket).
+ *
+ * The first bytes of the stream are read in advance into a bounded look-ahead buffer (e.g., for detecting
+ * the format of the data), and they are then returned by the first reads, before the rest of the stream.
+ */
+class CLookAheadInStream final : public ISequentialInStream, public CMyUnknownImp {
+    public:
+        CLookAheadInStream( std::istream& inputStream, std::size_t lookAheadSize );
+
+        CLookAheadInStream( const CLookAheadInStream& ) = delete;
+
+        CLookAheadInStream( CLookAheadInStream&& ) = delete;
+
+        CLookAheadInStream& operator=( const CLookAheadInStream& ) = delete;
+
+        CLookAheadInStream& operator=( CLookAheadInStream&& ) = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CLookAheadInStream() ) = default;
+
+        MY_UNKNOWN_IMP1( ISequentialInStream ) // NOLINT(modernize-use-noexcept)
+
+        /**
+         * @return the bytes read in advance from the start of the stream (less than the look-ahead size only
+         * if the stream is shorter); the buffer is released once the reads have consumed it.
+         */
+        BIT7Z_NODISCARD const std::vector< byte_t >& lookAhead() const noexcept;
+
+        // ISequentialInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+    private:
+        std::istream& mInputStream;
+        std::vector< byte_t > mLookAhead;
+        std::size_t mLookAheadPosition;
+};
+
+}  // namespace bit7z
+
+#endif //CLOOKAHEADINSTREAM_HPP
@@ -0,0 +1,231 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/cmappedinstream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "bitexception.hpp"
+#include "internal/cfileinstream.hpp"
+#include "internal/tracing.hpp"
+#include "internal/util.hpp"
+
+using namespace bit7z;
+
+namespace {
+#ifdef _WIN32
+class HandleGuard final {
+    public:
+        explicit HandleGuard( HANDLE handle ) : mHandle{ handle } {}
+
+        HandleGuard( const HandleGuard& ) = delete;
+
+        HandleGuard( HandleGuard&& ) = delete;
+
+        HandleGuard& operator=( const HandleGuard& ) = delete;
+
+        HandleGuard& operator=( HandleGuard&& ) = delete;
+
+        ~HandleGuard() {
+            if ( mHandle != nullptr && mHandle != INVALID_HANDLE_VALUE ) {
+                CloseHandle( mHandle );
+            }
+        }
+
+        BIT7Z_NODISCARD HANDLE get() const noexcept {
+            return mHandle;
+        }
+
+    private:
+        HANDLE mHandle;
+};
+#else
+class FileDescriptorGuard final {
+    public:
+        explicit FileDescriptorGuard( int fd ) : mFileDescriptor{ fd } {}
+
+        FileDescriptorGuard( const FileDescriptorGuard& ) = delete;
+
+        FileDescriptorGuard( FileDescriptorGuard&& ) = delete;
+
+        FileDescriptorGuard& operator=( const FileDescriptorGuard& ) = delete;
+
+        FileDescriptorGuard& operator=( FileDescriptorGuard&& ) = delete;
+
+        ~FileDescriptorGuard() {
+            if ( mFileDescriptor >= 0 ) {
+                close( mFileDescriptor );
+            }
+        }
+
+        BIT7Z_NODISCARD int get() const noexcept {
+            return mFileDescriptor;
+        }
+
+    private:
+        int mFileDescriptor;
+};
+
+int access_advice( MappedAccess access ) noexcept {
+    return access == MappedAccess::Sequential ? MADV_SEQUENTIAL : MADV_NORMAL;
+}
+#endif
+
+[[noreturn]] void throw_mapping_error( const fs::path& filePath ) {
+    throw BitException( "Failed to map the file in memory", last_error_code(), filePath.string< tchar >() );
+}
+} // namespace
+
+CMappedInStream::CMappedInStream( const fs::path& filePath, MappedAccess access )
+    : mData{ nullptr }, mSize{ 0 }, mCurrentPosition{ 0 } {
+    // Note: both the file and the mapping object can be closed once the file has been mapped.
+#ifdef _WIN32
+    const HandleGuard file{ CreateFileW( filePath.c_str(),
+                                         GENERIC_READ,
+                                         FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                         nullptr,
+                                         OPEN_EXISTING,
+                                         access == MappedAccess::Sequential ?
+                                         FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL,
+                                         nullptr ) };
+    LARGE_INTEGER file_size{};
+    if ( file.get() == INVALID_HANDLE_VALUE || GetFileSizeEx( file.get(), &file_size ) == FALSE ) {
+        throw_mapping_error( filePath );
+    }
+    mSize = static_cast< uint64_t >( file_size.QuadPart );
+    if ( mSize == 0 || mSize > std::numeric_limits< size_t >::max() ) {
+        throw BitException( "Cannot map the file in memory", make_hresult_code( E_INVALIDARG ), filePath.string< tchar >() );
+    }
+
+    const HandleGuard mapping{ CreateFileMappingW( file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr ) };
+    if ( mapping.get() == nullptr ) {
+        throw_mapping_error( filePath );
+    }
+    mData = static_cast< const byte_t* >( MapViewOfFile( mapping.get(), FILE_MAP_READ, 0, 0, 0 ) );
+    if ( mData == nullptr ) {
+        throw_mapping_error( filePath );
+    }
+#else
+    const FileDescriptorGuard file{ open( filePath.c_str(), O_RDONLY | O_CLOEXEC ) }; // NOLINT(*-vararg)
+    struct stat file_stat{};
+    if ( file.get() < 0 || fstat( file.get(), &file_stat ) != 0 ) {
+        throw_mapping_error( filePath );
+    }
+    mSize = static_cast< uint64_t >( file_stat.st_size );
+    if ( !S_ISREG( file_stat.st_mode ) || mSize == 0 || mSize > std::numeric_limits< size_t >::max() ) {
+        throw BitException( "Cannot map the file in memory", make_hresult_code( E_INVALIDARG ), filePath.string< tchar >() );
+    }
+
+    void* data = mmap( nullptr, static_cast< size_t >( mSize ), PROT_READ, MAP_PRIVATE, file.get(), 0 );
+    if ( data == MAP_FAILED ) { // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        throw_mapping_error( filePath );
+    }
+    // Note: the advice is just a hint for the kernel, so we can safely ignore any error.
+    static_cast< void >( madvise( data, static_cast< size_t >( mSize ), access_advice( access ) ) );
+    mData = static_cast< const byte_t* >( data );
+#endif
+}
+
+CMappedInStream::~CMappedInStream() {
+#ifdef _WIN32
+    UnmapViewOfFile( mData );
+#else
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    munmap( const_cast< byte_t* >( mData ), static_cast< size_t >( mSize ) );
+#endif
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CMappedInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    BIT7Z_TRACE_SCOPE( "CMappedInStream::Read" ); // Includes the page faults on the mapping.
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Read };
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( size == 0 || mCurrentPosition >= mSize ) {
+        return S_OK;
+    }
+
+    const auto read_size = static_cast< UInt32 >( std::min< uint64_t >( size, mSize - mCurrentPosition ) );
+    std::memcpy( data, mData + mCurrentPosition, read_size );
+    mCurrentPosition += read_size;
+    stats_record.setBytes( read_size );
+
+    if ( processedSize != nullptr ) {
+        *processedSize = read_size;
+    }
+    return S_OK;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CMappedInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
+    uint64_t origin; // NOLINT(cppcoreguidelines-init-variables)
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET: {
+            origin = 0;
+            break;
+        }
+        case STREAM_SEEK_CUR: {
+            origin = mCurrentPosition;
+            break;
+        }
+        case STREAM_SEEK_END: {
+            origin = mSize;
+            break;
+        }
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    // Note: mSize fits in a size_t, hence origin can be safely converted to a signed 64-bit integer.
+    if ( check_overflow( static_cast< int64_t >( origin ), offset ) ) {
+        return E_INVALIDARG;
+    }
+
+    const int64_t new_index = static_cast< int64_t >( origin ) + offset;
+    if ( new_index < 0 ) {
+        return HRESULT_WIN32_ERROR_NEGATIVE_SEEK;
+    }
+
+    // Note: like for file streams, seeking beyond the end of the file is allowed (reads will just return 0 bytes).
+    stats_record.setSeek( mCurrentPosition, static_cast< uint64_t >( new_index ) );
+    mCurrentPosition = static_cast< uint64_t >( new_index );
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
+
+CMyComPtr< IInStream > bit7z::openFileInStream( const fs::path& filePath, MappedAccess access ) {
+#ifdef BIT7Z_USE_MAPPED_FILES
+    try {
+        return bit7z::make_com< CMappedInStream, IInStream >( filePath, access );
+    } catch ( const BitException& ) {
+        // Falling back to reading the file through a file stream (which will throw if the file cannot be opened).
+    }
+#else
+    static_cast< void >( access );
+#endif
+    return bit7z::make_com< CFileInStream, IInStream >( filePath );
+}
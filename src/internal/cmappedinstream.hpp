@@ -0,0 +1,79 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CMAPPEDINSTREAM_HPP
+#define CMAPPEDINSTREAM_HPP
+
+#include "bittypes.hpp"
+#include "internal/fs.hpp"
+#include "internal/guids.hpp"
+#include "internal/iostats.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+#include <Common/MyCom.h>
+
+namespace bit7z {
+
+/**
+ * @brief Expected access pattern of a memory-mapped file, used as a hint for the OS.
+ */
+enum struct MappedAccess {
+    Normal,     ///< No particular access pattern (e.g., archive headers parsing followed by items decoding).
+    Sequential  ///< The file is read from start to end (e.g., the volumes of a multi-volume archive).
+};
+
+/**
+ * @brief Input stream reading a file through a read-only memory mapping of the whole file.
+ *
+ * Reads are a single copy from the mapped memory, and seeks only change the current position.
+ */
+class CMappedInStream final : public IInStream, public CMyUnknownImp, public IOStatsRecorder {
+    public:
+        /**
+         * @brief Maps the given file in memory.
+         *
+         * @note A BitException is thrown if the file cannot be opened or mapped (e.g., it is empty).
+         */
+        explicit CMappedInStream( const fs::path& filePath, MappedAccess access = MappedAccess::Normal );
+
+        CMappedInStream( const CMappedInStream& ) = delete;
+
+        CMappedInStream( CMappedInStream&& ) = delete;
+
+        CMappedInStream& operator=( const CMappedInStream& ) = delete;
+
+        CMappedInStream& operator=( CMappedInStream&& ) = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CMappedInStream() );
+
+        MY_UNKNOWN_IMP1( IInStream ) // NOLINT(modernize-use-noexcept)
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD_NOEXCEPT( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+    private:
+        const byte_t* mData;
+        uint64_t mSize;
+        uint64_t mCurrentPosition;
+};
+
+/**
+ * @brief Opens an input stream on the given file.
+ *
+ * If bit7z was built with the BIT7Z_USE_MAPPED_FILES option, the file is memory-mapped (CMappedInStream);
+ * otherwise, or if the mapping fails, the file is read through a CFileInStream.
+ */
+CMyComPtr< IInStream > openFileInStream( const fs::path& filePath, MappedAccess access = MappedAccess::Normal );
+
+}  // namespace bit7z
+
+#endif // CMAPPEDINSTREAM_HPP
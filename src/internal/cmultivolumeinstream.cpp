@@ -57,6 +57,7 @@ const CMyComPtr< CVolumeInStream >& CMultiVolumeInStream::currentVolume() {
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Read };
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -78,6 +79,7 @@ STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* proces
     }
     result = current_volume->Read( data, size, &size );
     mCurrentPosition += size;
+    stats_record.setBytes( size );
 
     if ( processedSize != nullptr ) {
         *processedSize = size;
@@ -87,6 +89,7 @@ STDMETHODIMP CMultiVolumeInStream::Read( void* data, UInt32 size, UInt32* proces
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
     uint64_t origin_position; // NOLINT(cppcoreguidelines-init-variables)
     switch ( seekOrigin ) {
         case STREAM_SEEK_SET:
@@ -115,6 +118,7 @@ STDMETHODIMP CMultiVolumeInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64
             return E_INVALIDARG;
         }
     }
+    stats_record.setSeek( mCurrentPosition, origin_position + offset );
     mCurrentPosition = origin_position + offset;
 
     if ( newPosition != nullptr ) {
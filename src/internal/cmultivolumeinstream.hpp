@@ -11,6 +11,7 @@
 #define CMULTIVOLUMEINSTREAM_HPP
 
 #include "internal/cvolumeinstream.hpp"
+#include "internal/iostats.hpp"
 #include "internal/macros.hpp"
 #include "internal/guiddef.hpp"
 
@@ -19,7 +20,7 @@
 
 namespace bit7z {
 
-class CMultiVolumeInStream : public IInStream, public CMyUnknownImp {
+class CMultiVolumeInStream : public IInStream, public CMyUnknownImp, public IOStatsRecorder {
         uint64_t mCurrentPosition;
         uint64_t mTotalSize;
 
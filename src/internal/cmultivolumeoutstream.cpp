@@ -31,6 +31,7 @@ UInt64 CMultiVolumeOutStream::GetSize() const noexcept { return mFullSize; }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Write };
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -71,6 +72,7 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
     /* Updating the offsets */
     mCurrentVolumeOffset += writtenSize;
     mAbsoluteOffset += writtenSize;
+    stats_record.setBytes( writtenSize );
 
     if ( mAbsoluteOffset > mFullSize ) {
         /* We wrote beyond the old known full size of the output archive, updating it. */
@@ -95,6 +97,8 @@ STDMETHODIMP CMultiVolumeOutStream::Write( const void* data, UInt32 size, UInt32
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CMultiVolumeOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) noexcept {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
+    const uint64_t old_offset = mAbsoluteOffset;
     switch ( seekOrigin ) {
         case STREAM_SEEK_SET:
             mAbsoluteOffset = static_cast< uint64_t >( offset );
@@ -108,6 +112,7 @@ STDMETHODIMP CMultiVolumeOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt6
         default:
             return STG_E_INVALIDFUNCTION;
     }
+    stats_record.setSeek( old_offset, mAbsoluteOffset );
     mCurrentVolumeOffset = mAbsoluteOffset;
     if ( newPosition != nullptr ) {
         *newPosition = mAbsoluteOffset;
@@ -16,6 +16,7 @@
 
 #include "internal/guiddef.hpp"
 #include "internal/cvolumeoutstream.hpp"
+#include "internal/iostats.hpp"
 
 #include <7zip/IStream.h>
 #include <Common/MyCom.h>
@@ -26,7 +27,7 @@ using std::wstring;
 
 namespace bit7z {
 
-class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp {
+class CMultiVolumeOutStream final : public IOutStream, public CMyUnknownImp, public IOStatsRecorder {
         // Size of a single volume.
         uint64_t mMaxVolumeSize;
 
@@ -13,6 +13,7 @@
 #include "internal/cstdinstream.hpp"
 
 #include "internal/streamutil.hpp"
+#include "internal/tracing.hpp"
 
 using namespace bit7z;
 
@@ -20,6 +21,8 @@ CStdInStream::CStdInStream( istream& inputStream ) : mInputStream( inputStream )
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CStdInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    BIT7Z_TRACE_SCOPE( "CStdInStream::Read" );
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Read };
     mInputStream.clear();
 
     if ( processedSize != nullptr ) {
@@ -32,8 +35,10 @@ STDMETHODIMP CStdInStream::Read( void* data, UInt32 size, UInt32* processedSize
 
     mInputStream.read( static_cast< char* >( data ), size );
 
+    const auto read_size = static_cast< uint32_t >( mInputStream.gcount() );
+    stats_record.setBytes( read_size );
     if ( processedSize != nullptr ) {
-        *processedSize = static_cast< uint32_t >( mInputStream.gcount() );
+        *processedSize = read_size;
     }
 
     return mInputStream.bad() ? HRESULT_FROM_WIN32( ERROR_READ_FAULT ) : S_OK;
@@ -41,11 +46,16 @@ STDMETHODIMP CStdInStream::Read( void* data, UInt32 size, UInt32* processedSize
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CStdInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) {
+    BIT7Z_TRACE_SCOPE( "CStdInStream::Seek" );
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
     mInputStream.clear();
 
     std::ios_base::seekdir way; // NOLINT(cppcoreguidelines-init-variables)
     RINOK( to_seekdir( seekOrigin, way ) )
 
+    // Note: the old position is needed only for the seek distance statistics.
+    const auto old_position = stats_record.active() ? static_cast< uint64_t >( mInputStream.tellg() ) : 0;
+
     /*if ( offset < 0 ) { // GZip uses negative offsets!
         return HRESULT_WIN32_ERROR_NEGATIVE_SEEK;
     }*/
@@ -56,8 +66,12 @@ STDMETHODIMP CStdInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPos
         return HRESULT_FROM_WIN32( ERROR_SEEK );
     }
 
-    if ( newPosition != nullptr ) {
-        *newPosition = static_cast< uint64_t >( mInputStream.tellg() );
+    if ( newPosition != nullptr || stats_record.active() ) {
+        const auto new_position = static_cast< uint64_t >( mInputStream.tellg() );
+        stats_record.setSeek( old_position, new_position );
+        if ( newPosition != nullptr ) {
+            *newPosition = new_position;
+        }
     }
 
     return S_OK;
@@ -14,6 +14,7 @@
 #include <istream>
 
 #include "internal/guids.hpp"
+#include "internal/iostats.hpp"
 #include "internal/macros.hpp"
 
 #include <7zip/IStream.h>
@@ -23,7 +24,7 @@ namespace bit7z {
 
 using std::istream;
 
-class CStdInStream : public IInStream, public CMyUnknownImp {
+class CStdInStream : public IInStream, public CMyUnknownImp, public IOStatsRecorder {
     public:
         explicit CStdInStream( istream& inputStream );
 
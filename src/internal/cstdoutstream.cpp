@@ -13,6 +13,7 @@
 #include "internal/cstdoutstream.hpp"
 
 #include "internal/streamutil.hpp"
+#include "internal/tracing.hpp"
 
 #include <iterator>
 
@@ -22,6 +23,8 @@ CStdOutStream::CStdOutStream( std::ostream& outputStream ) : mOutputStream( outp
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CStdOutStream::Write( const void* data, UInt32 size, UInt32* processedSize ) {
+    BIT7Z_TRACE_SCOPE( "CStdOutStream::Write" );
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Write };
     if ( processedSize != nullptr ) {
         *processedSize = 0;
     }
@@ -34,8 +37,10 @@ STDMETHODIMP CStdOutStream::Write( const void* data, UInt32 size, UInt32* proces
 
     mOutputStream.write( static_cast< const char* >( data ), size );
 
+    const auto written_size = static_cast< uint32_t >( mOutputStream.tellp() - old_pos );
+    stats_record.setBytes( written_size );
     if ( processedSize != nullptr ) {
-        *processedSize = static_cast< uint32_t >( mOutputStream.tellp() - old_pos );
+        *processedSize = written_size;
     }
 
     return mOutputStream.bad() ? HRESULT_FROM_WIN32( ERROR_WRITE_FAULT ) : S_OK;
@@ -43,9 +48,13 @@ STDMETHODIMP CStdOutStream::Write( const void* data, UInt32 size, UInt32* proces
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP CStdOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) {
+    IOStatsRecord stats_record{ ioStatsCollector(), IOOperation::Seek };
     std::ios_base::seekdir way; // NOLINT(cppcoreguidelines-init-variables)
     RINOK( to_seekdir( seekOrigin, way ) )
 
+    // Note: the old position is needed only for the seek distance statistics.
+    const auto old_position = stats_record.active() ? static_cast< uint64_t >( mOutputStream.tellp() ) : 0;
+
     /*if ( offset < 0 ) { //Tar sometimes uses negative offsets
         return HRESULT_WIN32_ERROR_NEGATIVE_SEEK;
     }*/
@@ -56,8 +65,12 @@ STDMETHODIMP CStdOutStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPo
         return HRESULT_FROM_WIN32( ERROR_SEEK );
     }
 
-    if ( newPosition != nullptr ) {
-        *newPosition = static_cast< uint64_t >( mOutputStream.tellp() );
+    if ( newPosition != nullptr || stats_record.active() ) {
+        const auto new_position = static_cast< uint64_t >( mOutputStream.tellp() );
+        stats_record.setSeek( old_position, new_position );
+        if ( newPosition != nullptr ) {
+            *newPosition = new_position;
+        }
     }
 
     return S_OK;
@@ -14,6 +14,7 @@
 #include <cstdint>
 
 #include "internal/guids.hpp"
+#include "internal/iostats.hpp"
 #include "internal/macros.hpp"
 
 #include <7zip/IStream.h>
@@ -23,7 +24,7 @@ namespace bit7z {
 
 using std::ostream;
 
-class CStdOutStream : public IOutStream, public CMyUnknownImp {
+class CStdOutStream : public IOutStream, public CMyUnknownImp, public IOStatsRecorder {
     public:
         explicit CStdOutStream( std::ostream& outputStream );
 
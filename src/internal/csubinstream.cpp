@@ -0,0 +1,90 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/csubinstream.hpp"
+
+#include <limits>
+
+#include "internal/util.hpp"
+
+using namespace bit7z;
+
+CSubInStream::CSubInStream( IInStream* base_stream, uint64_t offset )
+    : mBaseStream{ base_stream }, mOffset{ offset }, mCurrentPosition{ 0 }, mIsBaseSynced{ false } {}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CSubInStream::Read( void* data, UInt32 size, UInt32* processedSize ) {
+    if ( processedSize != nullptr ) {
+        *processedSize = 0;
+    }
+
+    if ( !mIsBaseSynced ) {
+        if ( mOffset + mCurrentPosition > static_cast< uint64_t >( std::numeric_limits< Int64 >::max() ) ) {
+            return E_INVALIDARG;
+        }
+        const auto base_position = static_cast< Int64 >( mOffset + mCurrentPosition );
+        RINOK( mBaseStream->Seek( base_position, STREAM_SEEK_SET, nullptr ) )
+        mIsBaseSynced = true;
+    }
+
+    UInt32 read_size = 0;
+    const HRESULT res = mBaseStream->Read( data, size, &read_size );
+    mCurrentPosition += read_size;
+    if ( processedSize != nullptr ) {
+        *processedSize = read_size;
+    }
+    return res;
+}
+
+COM_DECLSPEC_NOTHROW
+STDMETHODIMP CSubInStream::Seek( Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) {
+    uint64_t origin; // NOLINT(cppcoreguidelines-init-variables)
+    switch ( seekOrigin ) {
+        case STREAM_SEEK_SET: {
+            origin = 0;
+            break;
+        }
+        case STREAM_SEEK_CUR: {
+            origin = mCurrentPosition;
+            break;
+        }
+        case STREAM_SEEK_END: {
+            UInt64 base_size = 0;
+            RINOK( mBaseStream->Seek( 0, STREAM_SEEK_END, &base_size ) )
+            mIsBaseSynced = false;
+            origin = base_size > mOffset ? base_size - mOffset : 0;
+            break;
+        }
+        default:
+            return STG_E_INVALIDFUNCTION;
+    }
+
+    if ( origin > static_cast< uint64_t >( std::numeric_limits< Int64 >::max() ) ||
+         check_overflow( static_cast< int64_t >( origin ), offset ) ) {
+        return E_INVALIDARG;
+    }
+
+    const int64_t new_position = static_cast< int64_t >( origin ) + offset;
+    if ( new_position < 0 ) {
+        return HRESULT_WIN32_ERROR_NEGATIVE_SEEK;
+    }
+
+    if ( static_cast< uint64_t >( new_position ) != mCurrentPosition ) {
+        mCurrentPosition = static_cast< uint64_t >( new_position );
+        mIsBaseSynced = false;
+    }
+
+    if ( newPosition != nullptr ) {
+        *newPosition = mCurrentPosition;
+    }
+    return S_OK;
+}
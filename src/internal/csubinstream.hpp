@@ -0,0 +1,59 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CSUBINSTREAM_HPP
+#define CSUBINSTREAM_HPP
+
+#include <cstdint>
+
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+
+#include <7zip/IStream.h>
+#include <Common/MyCom.h>
+
+namespace bit7z {
+
+/**
+ * @brief Input stream exposing the content of another stream starting from a given offset,
+ * e.g., for reading an archive embedded in a larger file.
+ */
+class CSubInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        CSubInStream( IInStream* base_stream, uint64_t offset );
+
+        CSubInStream( const CSubInStream& ) = delete;
+
+        CSubInStream( CSubInStream&& ) = delete;
+
+        CSubInStream& operator=( const CSubInStream& ) = delete;
+
+        CSubInStream& operator=( CSubInStream&& ) = delete;
+
+        MY_UNKNOWN_DESTRUCTOR( ~CSubInStream() ) = default;
+
+        MY_UNKNOWN_IMP1( IInStream ) // NOLINT(modernize-use-noexcept)
+
+        // IInStream
+        BIT7Z_STDMETHOD( Read, void* data, UInt32 size, UInt32* processedSize );
+
+        BIT7Z_STDMETHOD( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition );
+
+    private:
+        CMyComPtr< IInStream > mBaseStream;
+        uint64_t mOffset;
+        uint64_t mCurrentPosition;
+
+        // Whether the position of the base stream corresponds to mCurrentPosition (so no seek is needed for reading).
+        bool mIsBaseSynced;
+};
+
+}  // namespace bit7z
+
+#endif //CSUBINSTREAM_HPP
@@ -15,7 +15,10 @@
 using bit7z::CVolumeInStream;
 
 CVolumeInStream::CVolumeInStream( const fs::path& volume_path, uint64_t global_offset )
-    : CFileInStream{ volume_path }, mSize{ fs::file_size( volume_path ) }, mGlobalOffset{ global_offset } {}
+    : CVolumeInStream{ volume_path, global_offset, fs::file_size( volume_path ) } {}
+
+CVolumeInStream::CVolumeInStream( const fs::path& volume_path, uint64_t global_offset, uint64_t volume_size )
+    : CFileInStream{ volume_path, volume_size }, mSize{ volume_size }, mGlobalOffset{ global_offset } {}
 
 BIT7Z_NODISCARD
 uint64_t CVolumeInStream::globalOffset() const {
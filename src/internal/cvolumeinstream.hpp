@@ -26,6 +26,8 @@ class CVolumeInStream final : public CFileInStream {
         uint64_t mSize;
 
         uint64_t mGlobalOffset;
+
+        CVolumeInStream( const fs::path& volume_path, uint64_t global_offset, uint64_t volume_size );
 };
 
 }  // namespace bit7z
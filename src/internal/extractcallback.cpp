@@ -12,7 +12,10 @@
 
 #include "internal/extractcallback.hpp"
 
+#include "biterror.hpp"
 #include "bitexception.hpp"
+#include "internal/iostats.hpp"
+#include "internal/tracing.hpp"
 #include "internal/util.hpp"
 
 using namespace bit7z;
@@ -29,24 +32,27 @@ HRESULT ExtractCallback::finishOperation( OperationResult operation_result ) {
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetTotal( UInt64 size ) {
-    if ( mHandler.totalCallback() ) {
-        mHandler.totalCallback()( size );
-    }
+    notifyTotal( size );
     return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetCompleted( const UInt64* completeValue ) {
-    if ( mHandler.progressCallback() && completeValue != nullptr ) {
-        return mHandler.progressCallback()( *completeValue ) ? S_OK : E_ABORT;
+    if ( mHandler.cancellationToken().isCancelled() ) {
+        mErrorException = std::make_exception_ptr( BitException( kOperationCancelled,
+                                                                 make_error_code( BitError::OperationCancelled ) ) );
+        return E_ABORT;
+    }
+    if ( completeValue != nullptr ) {
+        return notifyProgress( *completeValue ) ? S_OK : E_ABORT;
     }
     return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::SetRatioInfo( const UInt64* inSize, const UInt64* outSize ) {
-    if ( mHandler.ratioCallback() && inSize != nullptr && outSize != nullptr ) {
-        mHandler.ratioCallback()( *inSize, *outSize );
+    if ( inSize != nullptr && outSize != nullptr ) {
+        notifyRatio( *inSize, *outSize );
     }
     return S_OK;
 }
@@ -63,12 +69,22 @@ COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::GetStream( UInt32 index, ISequentialOutStream** outStream, Int32 askExtractMode ) try {
     *outStream = nullptr;
     releaseStream();
+    BIT7Z_TRACE_BEGIN( mItemTraceStart ); // The item's span ends in SetOperationResult, after the decoding.
+
+    if ( mHandler.cancellationToken().isCancelled() ) {
+        throw BitException( kOperationCancelled, make_error_code( BitError::OperationCancelled ) );
+    }
+    notifyCurrentItem( index );
 
     if ( askExtractMode != NArchive::NExtract::NAskMode::kExtract ) {
         return S_OK;
     }
 
-    return getOutStream( index, outStream );
+    const HRESULT result = getOutStream( index, outStream );
+    if ( result == S_OK ) {
+        attachIOStats( *outStream, ioStatsCollector() );
+    }
+    return result;
 } catch ( const BitException& ex ) {
     mErrorException = std::make_exception_ptr( ex );
     return ex.hresultCode();
@@ -85,6 +101,8 @@ STDMETHODIMP ExtractCallback::SetOperationResult( Int32 operationResult ) {
     constexpr auto kDataError = "Data Error";
     constexpr auto kUnknownError = "Unknown Error";
 
+    BIT7Z_TRACE_END( "ExtractCallback::item", mItemTraceStart );
+    notifyItemCompleted();
     auto result = static_cast< OperationResult >( operationResult );
     if ( result != OperationResult::Success ) {
         switch ( result ) {
@@ -116,8 +134,9 @@ COM_DECLSPEC_NOTHROW
 STDMETHODIMP ExtractCallback::CryptoGetTextPassword( BSTR* password ) {
     std::wstring pass;
     if ( !mHandler.isPasswordDefined() ) {
-        if ( mHandler.passwordCallback() ) {
-            pass = WIDEN( mHandler.passwordCallback()() );
+        const auto& password_callback = mHandler.passwordCallback();
+        if ( password_callback ) {
+            pass = WIDEN( password_callback() );
         }
 
         if ( pass.empty() ) {
@@ -116,6 +116,9 @@ class ExtractCallback : public Callback,
         const BitInputArchive& mInputArchive;
         ExtractMode mExtractMode;
         std::exception_ptr mErrorException;
+#ifdef BIT7Z_ENABLE_TRACING
+        uint64_t mItemTraceStart{ 0 };
+#endif
 };
 
 }  // namespace bit7z
@@ -14,6 +14,7 @@
 
 #include "bitexception.hpp"
 #include "internal/fsutil.hpp"
+#include "internal/tracing.hpp"
 #include "internal/util.hpp"
 
 using namespace std;
@@ -34,6 +35,7 @@ void FileExtractCallback::releaseStream() {
 }
 
 HRESULT FileExtractCallback::finishOperation( OperationResult operation_result ) {
+    BIT7Z_TRACE_SCOPE( "FileExtractCallback::finishOperation" );
     const HRESULT result = operation_result != OperationResult::Success ? E_FAIL : S_OK;
     if ( mFileOutStream == nullptr ) {
         return result;
@@ -72,6 +74,7 @@ fs::path FileExtractCallback::getCurrentItemPath() const {
 }
 
 HRESULT FileExtractCallback::getOutStream( uint32_t index, ISequentialOutStream** outStream ) {
+    BIT7Z_TRACE_SCOPE( "FileExtractCallback::getOutStream" );
     mCurrentItem.loadItemInfo( inputArchive(), index );
 
     auto filePath = getCurrentItemPath();
@@ -115,7 +118,11 @@ HRESULT FileExtractCallback::getOutStream( uint32_t index, ISequentialOutStream*
             }
         }
 
-        auto outStreamLoc = bit7z::make_com< CFileOutStream >( mFilePathOnDisk, true );
+        const BitPropVariant item_size = itemProperty( index, BitProperty::Size );
+        auto outStreamLoc = bit7z::make_com< CFileOutStream >( mFilePathOnDisk,
+                                                               true,
+                                                               item_size.isUInt64() ?
+                                                               item_size.getUInt64() : kUnknownStreamSize );
         mFileOutStream = outStreamLoc;
         *outStream = outStreamLoc.Detach();
     } else if ( mRetainDirectories ) { // Directory, and we must retain it
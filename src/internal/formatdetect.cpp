@@ -13,6 +13,9 @@
 #ifdef BIT7Z_AUTO_FORMAT
 
 #include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "internal/formatdetect.hpp"
 
 #if defined(BIT7Z_USE_NATIVE_STRING) && defined(_WIN32)
@@ -24,6 +27,7 @@
 #include "biterror.hpp"
 #include "bitexception.hpp"
 #include "internal/fsutil.hpp"
+#include "internal/tracing.hpp"
 #ifndef _WIN32
 #include "internal/guiddef.hpp"
 #endif
@@ -49,6 +53,28 @@ static inline uint64_t bswap64 (uint64_t x) {
 }
 #endif
 
+// Note: the SIMD filter of the SignatureScanner is compiled for SSSE3 (checked at runtime) on x86-64,
+//       and for NEON (always available) on ARM64; other architectures use only the scalar loop.
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define BIT7Z_SCAN_SSSE3
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <tmmintrin.h>
+#endif
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define BIT7Z_TARGET_SSSE3 __attribute__(( target( "ssse3" ) ))
+#else
+#define BIT7Z_TARGET_SSSE3
+#endif
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#define BIT7Z_SCAN_NEON
+#include <arm_neon.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 uint64_t constexpr str_hash( bit7z::tchar const* input ) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     return *input != 0 ? static_cast< uint64_t >( *input ) + 33 * str_hash( input + 1 ) : 5381;
@@ -242,10 +268,11 @@ bool findFormatByExtension( const tstring& ext, const BitInFormat** format ) {
     }
 }
 
-/* NOTE 1: For signatures with less than 8 bytes (size of uint64_t), remaining bytes are set to 0
+/* NOTE 1: For signatures with less than 8 bytes (size of uint64_t), remaining bytes are set to 0;
+ *         the actual size of the matched signature is returned through signature_size.
  * NOTE 2: Until v3, a std::unordered_map was used for mapping the signatures and the corresponding
  *         format. However, the switch case is faster and has less memory footprint. */
-bool findFormatBySignature( uint64_t signature, const BitInFormat** format ) noexcept {
+bool findFormatBySignature( uint64_t signature, const BitInFormat** format, uint32_t* signature_size ) noexcept {
     constexpr auto RarSignature = 0x526172211A070000ULL; // R  a  r  !  1A 07 00
     constexpr auto Rar5Signature = 0x526172211A070100ULL; // R  a  r  !  1A 07 01 00
     constexpr auto SevenZipSignature = 0x377ABCAF271C0000ULL; // 7  z  BC AF 27 1C
@@ -296,50 +323,68 @@ bool findFormatBySignature( uint64_t signature, const BitInFormat** format ) noe
     switch ( signature ) {
         case RarSignature:
             *format = &BitFormat::Rar;
+            *signature_size = 7;
             return true;
         case Rar5Signature:
             *format = &BitFormat::Rar5;
+            *signature_size = 8;
             return true;
         case SevenZipSignature:
             *format = &BitFormat::SevenZip;
+            *signature_size = 6;
             return true;
         case BZip2Signature:
             *format = &BitFormat::BZip2;
+            *signature_size = 3;
             return true;
         case GZipSignature:
             *format = &BitFormat::GZip;
+            *signature_size = 3;
             return true;
         case WimSignature:
             *format = &BitFormat::Wim;
+            *signature_size = 8;
             return true;
         case XzSignature:
             *format = &BitFormat::Xz;
+            *signature_size = 6;
             return true;
         case ZipSignature:
             *format = &BitFormat::Zip;
+            *signature_size = 2;
             return true;
         case APMSignature:
             *format = &BitFormat::APM;
+            *signature_size = 2;
             return true;
         case ArjSignature:
             *format = &BitFormat::Arj;
+            *signature_size = 2;
             return true;
         case CabSignature:
             *format = &BitFormat::Cab;
+            *signature_size = 8;
             return true;
         case ChmSignature:
             *format = &BitFormat::Chm;
+            *signature_size = 5;
             return true;
         case CompoundSignature:
             *format = &BitFormat::Compound;
+            *signature_size = 8;
             return true;
         case CpioSignature1:
         case CpioSignature2:
+            *format = &BitFormat::Cpio;
+            *signature_size = 2;
+            return true;
         case CpioSignature3:
             *format = &BitFormat::Cpio;
+            *signature_size = 5;
             return true;
         case DebSignature:
             *format = &BitFormat::Deb;
+            *signature_size = 7;
             return true;
             /* DMG signature detection is not this simple
             case 0x7801730D62626000:
@@ -348,72 +393,95 @@ bool findFormatBySignature( uint64_t signature, const BitInFormat** format ) noe
             */
         case ElfSignature:
             *format = &BitFormat::Elf;
+            *signature_size = 4;
             return true;
         case PeSignature:
             *format = &BitFormat::Pe;
+            *signature_size = 2;
             return true;
         case FlvSignature:
             *format = &BitFormat::Flv;
+            *signature_size = 4;
             return true;
         case LzmaSignature:
             *format = &BitFormat::Lzma;
+            *signature_size = 2;
             return true;
         case Lzma86Signature:
             *format = &BitFormat::Lzma86;
+            *signature_size = 2;
             return true;
         case MachoSignature1:
         case MachoSignature2:
         case MachoSignature3:
         case MachoSignature4:
             *format = &BitFormat::Macho;
+            *signature_size = 4;
             return true;
         case MubSignature1:
+            *format = &BitFormat::Mub;
+            *signature_size = 7;
+            return true;
         case MubSignature2:
             *format = &BitFormat::Mub;
+            *signature_size = 4;
             return true;
         case MslzSignature:
             *format = &BitFormat::Mslz;
+            *signature_size = 8;
             return true;
         case PpmdSignature:
             *format = &BitFormat::Ppmd;
+            *signature_size = 4;
             return true;
         case QCowSignature:
             *format = &BitFormat::QCow;
+            *signature_size = 7;
             return true;
         case RpmSignature:
             *format = &BitFormat::Rpm;
+            *signature_size = 4;
             return true;
         case SquashFSSignature1:
         case SquashFSSignature2:
         case SquashFSSignature3:
         case SquashFSSignature4:
             *format = &BitFormat::SquashFS;
+            *signature_size = 4;
             return true;
         case SwfSignature:
             *format = &BitFormat::Swf;
+            *signature_size = 3;
             return true;
         case SwfcSignature1:
         case SwfcSignature2:
             *format = &BitFormat::Swfc;
+            *signature_size = 3;
             return true;
         case TESignature:
             *format = &BitFormat::TE;
+            *signature_size = 2;
             return true;
         case VMDKSignature: // K  D  M  V
             *format = &BitFormat::VMDK;
+            *signature_size = 3;
             return true;
         case VDISignature: // Alternatively 0x7F10DABE at offset 0x40
             *format = &BitFormat::VDI;
+            *signature_size = 4;
             return true;
         case VhdSignature: // c  o  n  e  c  t  i  x
             *format = &BitFormat::Vhd;
+            *signature_size = 8;
             return true;
         case XarSignature: // x  a  r  !  00 1C
             *format = &BitFormat::Xar;
+            *signature_size = 6;
             return true;
         case ZSignature1: // 1F 9D
         case ZSignature2: // 1F A0
             *format = &BitFormat::Z;
+            *signature_size = 2;
             return true;
         default:
             return false;
@@ -443,46 +511,48 @@ const OffsetSignature common_signatures_with_offset[] = {
     { 0x53EF000000000000, 0x438, 2, BitFormat::Ext }     // S  EF
 };
 
-uint64_t readSignature( IInStream* stream, uint32_t size ) noexcept {
+uint64_t readSignature( const byte_t* data, std::size_t data_size, std::size_t offset, uint32_t size ) noexcept {
     uint64_t signature = 0;
-    stream->Read( &signature, size, nullptr );
+    if ( offset < data_size ) {
+        std::memcpy( &signature, data + offset, std::min< std::size_t >( size, data_size - offset ) );
+    }
     return bswap64( signature );
 }
 
-const BitInFormat& detectFormatFromSig( IInStream* stream ) {
+const BitInFormat* detectFormatFromBuffer( const byte_t* data, std::size_t size, uint32_t& signature_size ) noexcept {
     constexpr auto SIGNATURE_SIZE = 8U;
     constexpr auto BASE_SIGNATURE_MASK = 0xFFFFFFFFFFFFFFFFULL;
     constexpr auto BYTE_SHIFT = 8ULL;
 
-    uint64_t file_signature = readSignature( stream, SIGNATURE_SIZE );
+    uint64_t file_signature = readSignature( data, size, 0, SIGNATURE_SIZE );
     uint64_t signature_mask = BASE_SIGNATURE_MASK;
     for ( auto i = 0U; i < SIGNATURE_SIZE - 1; ++i ) {
         const BitInFormat* format = nullptr;
-        if ( findFormatBySignature( file_signature, &format ) ) {
-            stream->Seek( 0, 0, nullptr );
-            return *format;
+        uint32_t format_signature_size = 0;
+        if ( findFormatBySignature( file_signature, &format, &format_signature_size ) ) {
+            // Note: the trailing zero bytes of the signature might have been masked.
+            signature_size = std::min( format_signature_size, SIGNATURE_SIZE - i );
+            return format;
         }
         signature_mask <<= BYTE_SHIFT;    // left shifting the mask of 1 byte, so that
         file_signature &= signature_mask; // the least significant i bytes are masked (set to 0)
     }
 
     for ( const auto& sig : common_signatures_with_offset ) {
-        stream->Seek( sig.offset, 0, nullptr );
-        file_signature = readSignature( stream, sig.size );
+        file_signature = readSignature( data, size, static_cast< std::size_t >( sig.offset ), sig.size );
         if ( file_signature == sig.signature ) {
-            stream->Seek( 0, 0, nullptr );
-            return sig.format;
+            signature_size = sig.size;
+            return &sig.format;
         }
     }
 
     // Detecting ISO/UDF
     constexpr auto ISO_SIGNATURE = 0x4344303031000000; //CD001
-    constexpr auto ISO_SIGNATURE_SIZE = 5ULL;
+    constexpr auto ISO_SIGNATURE_SIZE = 5U;
     constexpr auto ISO_SIGNATURE_OFFSET = 0x8001;
 
     // Checking for ISO signature
-    stream->Seek( ISO_SIGNATURE_OFFSET, 0, nullptr );
-    file_signature = readSignature( stream, ISO_SIGNATURE_SIZE );
+    file_signature = readSignature( data, size, ISO_SIGNATURE_OFFSET, ISO_SIGNATURE_SIZE );
     if ( file_signature == ISO_SIGNATURE ) {
         constexpr auto MAX_VOLUME_DESCRIPTORS = 16;
         constexpr auto ISO_VOLUME_DESCRIPTOR_SIZE = 0x800; //2048
@@ -492,20 +562,281 @@ const BitInFormat& detectFormatFromSig( IInStream* stream ) {
 
         // The file is ISO, checking if it is also UDF!
         for ( auto descriptor_index = 1; descriptor_index < MAX_VOLUME_DESCRIPTORS; ++descriptor_index ) {
-            stream->Seek( ISO_SIGNATURE_OFFSET + descriptor_index * ISO_VOLUME_DESCRIPTOR_SIZE, 0, nullptr );
-            file_signature = readSignature( stream, UDF_SIGNATURE_SIZE );
+            const auto descriptor_offset = ISO_SIGNATURE_OFFSET + descriptor_index * ISO_VOLUME_DESCRIPTOR_SIZE;
+            file_signature = readSignature( data, size, descriptor_offset, UDF_SIGNATURE_SIZE );
             if ( file_signature == UDF_SIGNATURE ) {
-                stream->Seek( 0, 0, nullptr );
-                return BitFormat::Udf;
+                signature_size = ISO_SIGNATURE_SIZE + UDF_SIGNATURE_SIZE;
+                return &BitFormat::Udf;
             }
         }
-        stream->Seek( 0, 0, nullptr );
-        return BitFormat::Iso; //No UDF volume signature found, i.e. simple ISO!
+        signature_size = ISO_SIGNATURE_SIZE;
+        return &BitFormat::Iso; //No UDF volume signature found, i.e. simple ISO!
     }
+    return nullptr;
+}
 
+const BitInFormat& detectFormatFromSig( IInStream* stream ) {
+    BIT7Z_TRACE_SCOPE( "detectFormatFromSig" );
+    // Reading the whole signature window at once, instead of seeking and reading each signature separately.
+    std::vector< byte_t > window( kSignatureWindowSize );
+    std::size_t window_size = 0;
+    while ( window_size < window.size() ) {
+        UInt32 processed_size = 0;
+        const auto read_size = static_cast< UInt32 >( window.size() - window_size );
+        if ( stream->Read( window.data() + window_size, read_size, &processed_size ) != S_OK || processed_size == 0 ) {
+            break;
+        }
+        window_size += processed_size;
+    }
     stream->Seek( 0, 0, nullptr );
-    throw BitException( "Failed to detect the format of the file",
-                        make_error_code( BitError::NoMatchingSignature ) );
+
+    uint32_t signature_size = 0;
+    const BitInFormat* format = detectFormatFromBuffer( window.data(), window_size, signature_size );
+    if ( format == nullptr ) {
+        throw BitException( "Failed to detect the format of the file",
+                            make_error_code( BitError::NoMatchingSignature ) );
+    }
+    return *format;
+}
+
+struct EmbeddedSignature {
+    std::array< byte_t, 10 > bytes;
+    uint32_t size;
+    uint32_t offset; // The position of the signature relative to the start of the archive.
+    uint16_t wildcards; // Bit i is set if the i-th byte of the signature can have any value.
+    const BitInFormat& format;
+};
+
+// Note: the signatures are sorted by their first byte, as required by the SignatureScanner.
+const EmbeddedSignature embedded_signatures[] = {
+    { { '!', '<', 'a', 'r', 'c', 'h', '>' }, 7, 0, 0, BitFormat::Deb },
+    { { '0', '7', '0', '7', '0' }, 5, 0, 0, BitFormat::Cpio },
+    { { '7', 'z', 0xBC, 0xAF, 0x27, 0x1C }, 6, 0, 0, BitFormat::SevenZip },
+    { { 'B', 'Z', 'h', 0, '1', 'A', 'Y', '&', 'S', 'Y' }, 10, 0, 1U << 3U, BitFormat::BZip2 },
+    { { 'C', 'D', '0', '0', '1' }, 5, 0x8001, 0, BitFormat::Iso },
+    { { 'I', 'T', 'S', 'F', 0x03 }, 5, 0, 0, BitFormat::Chm },
+    { { 'M', 'S', 'C', 'F', 0x00, 0x00, 0x00, 0x00 }, 8, 0, 0, BitFormat::Cab },
+    { { 'M', 'S', 'W', 'I', 'M', 0x00, 0x00, 0x00 }, 8, 0, 0, BitFormat::Wim },
+    { { 'N', 'T', 'F', 'S', ' ', ' ', ' ', ' ' }, 8, 0x03, 0, BitFormat::Ntfs },
+    { { 'N', 'u', 'l', 'l', 's', 'o', 'f', 't' }, 8, 0x08, 0, BitFormat::Nsis },
+    { { 'P', 'K', 0x03, 0x04 }, 4, 0, 0, BitFormat::Zip },
+    { { 'Q', 'F', 'I', 0xFB }, 4, 0, 0, BitFormat::QCow },
+    { { 'R', 'a', 'r', '!', 0x1A, 0x07, 0x00 }, 7, 0, 0, BitFormat::Rar },
+    { { 'R', 'a', 'r', '!', 0x1A, 0x07, 0x01, 0x00 }, 8, 0, 0, BitFormat::Rar5 },
+    { { 'S', 'Z', 'D', 'D', 0x88, 0xF0, 0x27, 0x33 }, 8, 0, 0, BitFormat::Mslz },
+    { { 'c', 'o', 'n', 'e', 'c', 't', 'i', 'x' }, 8, 0, 0, BitFormat::Vhd },
+    { { 'h', 's', 'q', 's' }, 4, 0, 0, BitFormat::SquashFS },
+    { { 's', 'q', 's', 'h' }, 4, 0, 0, BitFormat::SquashFS },
+    { { 'u', 's', 't', 'a', 'r' }, 5, 0x101, 0, BitFormat::Tar },
+    { { 'x', 'a', 'r', '!', 0x00, 0x1C }, 6, 0, 0, BitFormat::Xar },
+    { { 0x8F, 0xAF, 0xAC, 0x84 }, 4, 0, 0, BitFormat::Ppmd },
+    { { 0xD0, 0xCF, 0x11, 0xE0, 0xA1, 0xB1, 0x1A, 0xE1 }, 8, 0, 0, BitFormat::Compound },
+    { { 0xED, 0xAB, 0xEE, 0xDB }, 4, 0, 0, BitFormat::Rpm },
+    { { 0xFD, '7', 'z', 'X', 'Z', 0x00 }, 6, 0, 0, BitFormat::Xz }
+};
+
+constexpr auto kEmbeddedSignaturesCount = sizeof( embedded_signatures ) / sizeof( EmbeddedSignature );
+constexpr uint8_t kNoSignature = 0xFF;
+static_assert( kEmbeddedSignaturesCount < kNoSignature, "Too many embedded signatures" );
+
+inline bool matches_signature( const EmbeddedSignature& signature, const byte_t* data ) noexcept {
+    // Note: the first byte is already known to match.
+    for ( uint32_t index = 1; index < signature.size; ++index ) {
+        if ( data[ index ] != signature.bytes[ index ] && ( signature.wildcards & ( 1U << index ) ) == 0 ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined( BIT7Z_SCAN_SSSE3 ) || defined( BIT7Z_SCAN_NEON )
+inline unsigned count_trailing_zeros( uint64_t value ) noexcept {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64( &index, value );
+    return static_cast< unsigned >( index );
+#else
+    return static_cast< unsigned >( __builtin_ctzll( value ) );
+#endif
+}
+#endif
+
+#ifdef BIT7Z_SCAN_SSSE3
+bool has_ssse3() noexcept {
+#ifdef _MSC_VER
+    std::array< int, 4 > cpu_info{};
+    __cpuid( cpu_info.data(), 1 );
+    return ( cpu_info[ 2 ] & ( 1 << 9 ) ) != 0;
+#else
+    return __builtin_cpu_supports( "ssse3" ) != 0;
+#endif
+}
+
+// Returns, for each of the given bytes, the buckets of the set that the byte may belong to (zero if none).
+BIT7Z_TARGET_SSSE3 inline __m128i classify_bytes( __m128i bytes, __m128i low_table, __m128i high_table ) noexcept {
+    const __m128i nibble_mask = _mm_set1_epi8( 0x0F );
+    const __m128i low_nibbles = _mm_and_si128( bytes, nibble_mask );
+    const __m128i high_nibbles = _mm_and_si128( _mm_srli_epi16( bytes, 4 ), nibble_mask );
+    return _mm_and_si128( _mm_shuffle_epi8( low_table, low_nibbles ), _mm_shuffle_epi8( high_table, high_nibbles ) );
+}
+
+// Calls on_candidate for each position in [0, scan_size) whose first two bytes may start a signature,
+// sixteen positions at a time; returns the number of positions checked (the remaining ones must be checked
+// by the caller, as the filter reads one byte after each position).
+template< typename Function >
+BIT7Z_TARGET_SSSE3 std::size_t filter_positions( const byte_t* data,
+                                                 std::size_t size,
+                                                 std::size_t scan_size,
+                                                 const SignatureScanner::NibbleBuckets& first_bytes,
+                                                 const SignatureScanner::NibbleBuckets& second_bytes,
+                                                 const Function& on_candidate ) {
+    if ( size <= 16 ) {
+        return 0;
+    }
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i first_low = _mm_loadu_si128( reinterpret_cast< const __m128i* >( first_bytes.low.data() ) );
+    const __m128i first_high = _mm_loadu_si128( reinterpret_cast< const __m128i* >( first_bytes.high.data() ) );
+    const __m128i second_low = _mm_loadu_si128( reinterpret_cast< const __m128i* >( second_bytes.low.data() ) );
+    const __m128i second_high = _mm_loadu_si128( reinterpret_cast< const __m128i* >( second_bytes.high.data() ) );
+    const __m128i zero = _mm_setzero_si128();
+    const std::size_t blocks_end = std::min( scan_size, size - 1 );
+    std::size_t position = 0;
+    for ( ; blocks_end - position >= 16; position += 16 ) {
+        const __m128i bytes = _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + position ) );
+        const __m128i next_bytes = _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + position + 1 ) );
+        const __m128i buckets = _mm_and_si128( classify_bytes( bytes, first_low, first_high ),
+                                               classify_bytes( next_bytes, second_low, second_high ) );
+        auto mask = static_cast< uint64_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( buckets, zero ) ) ) ^ 0xFFFFU;
+        for ( ; mask != 0; mask &= mask - 1 ) {
+            on_candidate( position + count_trailing_zeros( mask ) );
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    return position;
+}
+#elif defined( BIT7Z_SCAN_NEON )
+// Returns, for each of the given bytes, the buckets of the set that the byte may belong to (zero if none).
+inline uint8x16_t classify_bytes( uint8x16_t bytes, uint8x16_t low_table, uint8x16_t high_table ) noexcept {
+    return vandq_u8( vqtbl1q_u8( low_table, vandq_u8( bytes, vdupq_n_u8( 0x0F ) ) ),
+                     vqtbl1q_u8( high_table, vshrq_n_u8( bytes, 4 ) ) );
+}
+
+// Calls on_candidate for each position in [0, scan_size) whose first two bytes may start a signature,
+// sixteen positions at a time; returns the number of positions checked (the remaining ones must be checked
+// by the caller, as the filter reads one byte after each position).
+template< typename Function >
+std::size_t filter_positions( const byte_t* data,
+                              std::size_t size,
+                              std::size_t scan_size,
+                              const SignatureScanner::NibbleBuckets& first_bytes,
+                              const SignatureScanner::NibbleBuckets& second_bytes,
+                              const Function& on_candidate ) {
+    if ( size <= 16 ) {
+        return 0;
+    }
+    const uint8x16_t first_low = vld1q_u8( first_bytes.low.data() );
+    const uint8x16_t first_high = vld1q_u8( first_bytes.high.data() );
+    const uint8x16_t second_low = vld1q_u8( second_bytes.low.data() );
+    const uint8x16_t second_high = vld1q_u8( second_bytes.high.data() );
+    const std::size_t blocks_end = std::min( scan_size, size - 1 );
+    std::size_t position = 0;
+    for ( ; blocks_end - position >= 16; position += 16 ) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        const uint8x16_t bytes = vld1q_u8( reinterpret_cast< const uint8_t* >( data + position ) );
+        const uint8x16_t next_bytes = vld1q_u8( reinterpret_cast< const uint8_t* >( data + position + 1 ) );
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        const uint8x16_t buckets = vandq_u8( classify_bytes( bytes, first_low, first_high ),
+                                             classify_bytes( next_bytes, second_low, second_high ) );
+        // Narrowing the 0x00/0xFF byte mask to a 64-bit mask with four bits per byte, keeping one bit per byte.
+        const uint8x8_t narrowed = vshrn_n_u16( vreinterpretq_u16_u8( vtstq_u8( buckets, buckets ) ), 4 );
+        uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( narrowed ), 0 ) & 0x8888888888888888ULL;
+        for ( ; mask != 0; mask &= mask - 1 ) {
+            on_candidate( position + count_trailing_zeros( mask ) / 4 );
+        }
+    }
+    return position;
+}
+#endif
+
+SignatureScanner::SignatureScanner() noexcept : mFirstSignature{}, mFirstBytes{}, mSecondBytes{} {
+    mFirstSignature.fill( kNoSignature );
+    for ( auto index = kEmbeddedSignaturesCount; index > 0; --index ) {
+        const auto& signature = embedded_signatures[ index - 1 ];
+        const auto first_byte = static_cast< uint8_t >( signature.bytes[ 0 ] );
+        mFirstSignature[ first_byte ] = static_cast< uint8_t >( index - 1 );
+
+        // Note: the buckets may make some other positions pass the SIMD filter too,
+        //       but these are then discarded by the mFirstSignature table and by the full comparison.
+        const auto bucket = static_cast< uint8_t >( 1U << ( ( first_byte >> 4U ) & 7U ) );
+        mFirstBytes.low[ first_byte & 0x0FU ] |= bucket;
+        mFirstBytes.high[ first_byte >> 4U ] |= bucket;
+        if ( ( signature.wildcards & 2U ) != 0 ) {
+            for ( std::size_t nibble = 0; nibble < 16; ++nibble ) {
+                mSecondBytes.low[ nibble ] |= bucket;
+                mSecondBytes.high[ nibble ] |= bucket;
+            }
+            continue;
+        }
+        const auto second_byte = static_cast< uint8_t >( signature.bytes[ 1 ] );
+        mSecondBytes.low[ second_byte & 0x0FU ] |= bucket;
+        mSecondBytes.high[ second_byte >> 4U ] |= bucket;
+    }
+}
+
+std::size_t SignatureScanner::maxSignatureSize() noexcept {
+    uint32_t max_size = 0;
+    for ( const auto& signature : embedded_signatures ) {
+        max_size = std::max( max_size, signature.size );
+    }
+    return max_size;
+}
+
+void SignatureScanner::scan( const byte_t* data,
+                             std::size_t size,
+                             std::size_t scan_size,
+                             uint64_t base_offset,
+                             std::vector< SignatureCandidate >& candidates ) const {
+    scan_size = std::min( scan_size, size );
+    std::size_t position = 0;
+#if defined( BIT7Z_SCAN_SSSE3 ) || defined( BIT7Z_SCAN_NEON )
+#ifdef BIT7Z_SCAN_SSSE3
+    static const bool kUseSimdFilter = has_ssse3();
+#else
+    constexpr bool kUseSimdFilter = true;
+#endif
+    if ( kUseSimdFilter ) {
+        position = filter_positions( data, size, scan_size, mFirstBytes, mSecondBytes,
+                                     [ & ]( std::size_t candidate_position ) {
+                                         matchSignatures( data, size, candidate_position, base_offset, candidates );
+                                     } );
+    }
+#endif
+    for ( ; position < scan_size; ++position ) {
+        matchSignatures( data, size, position, base_offset, candidates );
+    }
+}
+
+void SignatureScanner::matchSignatures( const byte_t* data,
+                                        std::size_t size,
+                                        std::size_t position,
+                                        uint64_t base_offset,
+                                        std::vector< SignatureCandidate >& candidates ) const {
+    const byte_t first_byte = data[ position ];
+    const uint8_t first_signature = mFirstSignature[ static_cast< uint8_t >( first_byte ) ];
+    if ( first_signature == kNoSignature ) {
+        return;
+    }
+    for ( auto index = static_cast< std::size_t >( first_signature );
+          index < kEmbeddedSignaturesCount && embedded_signatures[ index ].bytes[ 0 ] == first_byte;
+          ++index ) {
+        const auto& signature = embedded_signatures[ index ];
+        const uint64_t signature_offset = base_offset + position;
+        if ( size - position < signature.size || signature_offset < signature.offset ||
+             !matches_signature( signature, data + position ) ) {
+            continue;
+        }
+        candidates.push_back( { signature_offset - signature.offset, &signature.format } );
+    }
 }
 
 #if defined(BIT7Z_USE_NATIVE_STRING) && defined(_WIN32)
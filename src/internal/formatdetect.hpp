@@ -12,17 +12,108 @@
 
 #ifdef BIT7Z_AUTO_FORMAT
 
+#include <array>
+#include <cstddef>
+#include <vector>
+
 #include "bitformat.hpp"
 #include "bitfs.hpp"
+#include "bittypes.hpp"
 
 struct IInStream;
 
 namespace bit7z {
 
+/**
+ * @brief The size of the initial part of a file that is needed for checking all the known signatures
+ * (the farthest one is the UDF volume descriptor, at most at 0x8001 + 15 * 0x800 bytes from the start).
+ */
+constexpr std::size_t kSignatureWindowSize = 64 * 1024;
+
 const BitInFormat& detectFormatFromExt( const fs::path& in_file );
 
 const BitInFormat& detectFormatFromSig( IInStream* stream );
 
+/**
+ * @brief Checks all the known signatures against the given (initial part of a) file.
+ *
+ * @param data            the initial bytes of the file.
+ * @param size            the number of bytes available in data (at most kSignatureWindowSize are used).
+ * @param signature_size  the size (in bytes) of the matched signature.
+ *
+ * @return the detected format, or nullptr if no signature matched.
+ */
+const BitInFormat* detectFormatFromBuffer( const byte_t* data, std::size_t size, uint32_t& signature_size ) noexcept;
+
+/**
+ * @brief A possible archive embedded in a larger file, found by the SignatureScanner.
+ */
+struct SignatureCandidate {
+    uint64_t offset; // The offset of the start of the archive in the scanned data.
+    const BitInFormat* format;
+};
+
+/**
+ * @brief Searches the signatures of the archive formats at any position of some data (e.g., for finding archives
+ * appended to executables or embedded in disk images).
+ *
+ * Only signatures of at least four bytes are searched, to keep the number of false positives low.
+ * Each byte of the data is checked against a table of the first bytes of the signatures, and only the positions
+ * whose byte starts some signature are compared with the whole signatures.
+ * Where SIMD instructions are available (SSSE3 on x86-64, NEON on ARM64), the data is first filtered sixteen bytes
+ * at a time, classifying each byte and the following one by their nibbles, so that the table is checked only for
+ * the few positions whose first two bytes may start a signature.
+ */
+class SignatureScanner final {
+    public:
+        /**
+         * @brief The buckets of a set of bytes having each low and high nibble value: a byte may be in the set
+         * only if the buckets of its two nibbles intersect.
+         */
+        struct NibbleBuckets {
+            std::array< uint8_t, 16 > low;
+            std::array< uint8_t, 16 > high;
+        };
+
+        SignatureScanner() noexcept;
+
+        /**
+         * @return the number of bytes that must be available after a position for checking all the signatures there.
+         */
+        BIT7Z_NODISCARD static std::size_t maxSignatureSize() noexcept;
+
+        /**
+         * @brief Searches the signatures starting at the positions [0, scan_size) of the given data.
+         *
+         * @param data         the data to be scanned.
+         * @param size         the number of bytes available in data (signatures must end within them).
+         * @param scan_size    the number of positions to be checked (at most size).
+         * @param base_offset  the offset of data in the whole scanned file.
+         * @param candidates   the vector where the candidates found are appended.
+         */
+        void scan( const byte_t* data,
+                   std::size_t size,
+                   std::size_t scan_size,
+                   uint64_t base_offset,
+                   std::vector< SignatureCandidate >& candidates ) const;
+
+    private:
+        // For each byte value, the index of the first signature starting with it, in the signatures sorted
+        // by their first byte (kNoSignature if none).
+        std::array< uint8_t, 256 > mFirstSignature;
+
+        // The buckets of the first and second bytes of the signatures; the signatures are put in eight buckets
+        // by the high nibble of their first byte, so that a second byte matters only for the same bucket.
+        NibbleBuckets mFirstBytes;
+        NibbleBuckets mSecondBytes;
+
+        void matchSignatures( const byte_t* data,
+                              std::size_t size,
+                              std::size_t position,
+                              uint64_t base_offset,
+                              std::vector< SignatureCandidate >& candidates ) const;
+};
+
 } // namespace bit7z
 
 #endif
@@ -12,6 +12,15 @@
 
 #include "internal/fsindexer.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
 #include "bitexception.hpp"
 #include "internal/fsutil.hpp"
 
@@ -19,50 +28,380 @@ using bit7z::GenericInputItem;
 using bit7z::tstring;
 using namespace bit7z::filesystem;
 
-FSIndexer::FSIndexer( FSItem directory, tstring filter, bool only_files )
-    : mDirItem( std::move( directory ) ), mFilter( std::move( filter ) ), mOnlyFiles{ only_files } {
+FSIndexer::FSIndexer( FSItem directory, tstring filter, bool only_files, bool sort_entries )
+    : mDirItem( std::move( directory ) ),
+      mFilter( std::move( filter ) ),
+      mOnlyFiles{ only_files },
+      mSortEntries{ sort_entries } {
     if ( !mDirItem.isDir() ) {
         throw BitException( "Invalid path", std::make_error_code( std::errc::not_a_directory ), mDirItem.name() );
     }
+    mIncludeRootPath = mFilter.empty() ||
+                       fs::path{ mDirItem.path() }.parent_path().empty() ||
+                       mDirItem.inArchivePath().filename() != mDirItem.name();
 }
 
-// NOTE: It indexes all the items whose metadata are needed in the archive to be created!
-// NOLINTNEXTLINE(misc-no-recursion)
-void FSIndexer::listDirectoryItems( vector< unique_ptr< GenericInputItem > >& result,
-                                    bool recursive,
-                                    const fs::path& prefix ) {
+template< typename OnEntry >
+void FSIndexer::listDirectory( const fs::path& prefix, bool recursive, OnEntry&& on_entry ) const {
     fs::path path = mDirItem.path();
+    auto search_path = mIncludeRootPath ? mDirItem.inArchivePath() : fs::path();
     if ( !prefix.empty() ) {
         path = path / prefix;
+        search_path = search_path.empty() ? prefix : search_path / prefix;
+    }
+    vector< FSItem > sorted_items;
+    {
+        // Note: the entries are listed using the same handle used for reading their metadata.
+        fsutil::DirectoryHandle directory{ path };
+        fs::path entry_path;
+        while ( directory.nextEntry( entry_path ) ) {
+            FSItem current_item{ entry_path, search_path, directory };
+            if ( mSortEntries ) {
+                sorted_items.push_back( std::move( current_item ) );
+            } else {
+                visitEntry( current_item, recursive, on_entry );
+            }
+        }
+        // Note: otherwise, a directory that couldn't be (fully) listed would give a partial index.
+        if ( directory.error() ) {
+            throw BitException( "Could not list the directory", directory.error(), path.string< tchar >() );
+        }
+    }
+
+    // Note: the sorted entries are visited after closing the directory (e.g., before listing the subdirectories).
+    std::sort( sorted_items.begin(), sorted_items.end(), []( const FSItem& first, const FSItem& second ) {
+        return first.name() < second.name();
+    } );
+    for ( const auto& item : sorted_items ) {
+        visitEntry( item, recursive, on_entry );
+    }
+}
+
+template< typename OnEntry >
+void FSIndexer::visitEntry( const FSItem& item, bool recursive, OnEntry& on_entry ) const {
+    /* An item matches if:
+     *  - Its name matches the wildcard pattern, and
+     *  - Either is a file, or we are interested also to include folders in the index.
+     *
+     * Note: The boolean expression uses short-circuiting to optimize the evaluation. */
+    const bool item_matches = ( !mOnlyFiles || !item.isDir() ) && fsutil::wildcardMatch( mFilter, item.name() );
+
+    //item is a directory, and we must list it only if:
+    // > indexing is done recursively
+    // > indexing is not recursive, but the directory name matched the filter.
+    const bool list_subdirectory = item.isDir() && ( recursive || item_matches );
+
+    if ( item_matches || list_subdirectory ) {
+        on_entry( item, item_matches, list_subdirectory );
     }
-    const bool include_root_path = mFilter.empty() ||
-                                   fs::path{ mDirItem.path() }.parent_path().empty() ||
-                                   mDirItem.inArchivePath().filename() != mDirItem.name();
-    std::error_code error;
-    for ( const auto& current_entry : fs::directory_iterator( path, error ) ) {
-        auto search_path = include_root_path ? mDirItem.inArchivePath() : fs::path();
-        if ( !prefix.empty() ) {
-            search_path = search_path.empty() ? prefix : search_path / prefix;
-        }
-
-        const FSItem current_item{ current_entry, search_path };
-        /* An item matches if:
-         *  - Its name matches the wildcard pattern, and
-         *  - Either is a file, or we are interested also to include folders in the index.
-         *
-         * Note: The boolean expression uses short-circuiting to optimize the evaluation. */
-        const bool item_matches = ( !mOnlyFiles || !current_item.isDir() ) &&
-                                  fsutil::wildcardMatch( mFilter, current_item.name() );
-        if ( item_matches ) {
-            result.emplace_back( std::make_unique< FSItem >( current_item ) );
-        }
-
-        if ( current_item.isDir() && ( recursive || item_matches ) ) {
-            //currentItem is a directory, and we must list it only if:
-            // > indexing is done recursively
-            // > indexing is not recursive, but the directory name matched the filter.
-            const fs::path next_dir = prefix.empty() ? fs::path( current_item.name() ) : prefix / current_item.name();
-            listDirectoryItems( result, true, next_dir );
+}
+
+namespace {
+/**
+ * @brief Sink appending the indexed items to a vector of generic input items.
+ */
+class ItemsVectorSink final {
+    public:
+        using Parent = std::nullptr_t; // The items in the vector have no parent.
+        using Entry = unique_ptr< GenericInputItem >;
+
+        explicit ItemsVectorSink( vector< unique_ptr< GenericInputItem > >& result ) : mResult( result ) {}
+
+        static Entry makeEntry( const FSItem& item, bool item_matches ) {
+            return item_matches ? std::make_unique< FSItem >( item ) : nullptr;
+        }
+
+        static Parent root( const fs::path& /*directory*/, const fs::path& /*searchPath*/ ) noexcept {
+            return nullptr;
         }
+
+        Parent add( Parent /*parent*/, Entry entry ) {
+            if ( entry ) {
+                mResult.emplace_back( std::move( entry ) );
+            }
+            return nullptr;
+        }
+
+    private:
+        vector< unique_ptr< GenericInputItem > >& mResult;
+};
+
+/**
+ * @brief Sink adding the indexed items, and the directories containing them, to a compact store.
+ */
+class ItemsStoreSink final {
+    public:
+        using Parent = FSItemsStore::node_index;
+
+        struct Entry {
+            tstring name;
+            fsutil::FileMetadata metadata;
+            bool isItem;
+        };
+
+        explicit ItemsStoreSink( FSItemsStore& store ) : mStore( store ) {}
+
+        static Entry makeEntry( const FSItem& item, bool item_matches ) {
+            return { item.name(), item.metadata(), item_matches };
+        }
+
+        Parent root( const fs::path& directory, const fs::path& searchPath ) {
+            return mStore.addRoot( directory, searchPath );
+        }
+
+        Parent add( Parent parent, const Entry& entry ) {
+            const Parent node = mStore.addNode( parent, entry.name );
+            if ( entry.isItem ) {
+                mStore.addItem( node, entry.metadata );
+            }
+            return node;
+        }
+
+    private:
+        FSItemsStore& mStore;
+};
+} // namespace
+
+// NOTE: It indexes all the items whose metadata are needed in the archive to be created!
+void FSIndexer::listDirectoryItems( vector< unique_ptr< GenericInputItem > >& result,
+                                    bool recursive,
+                                    std::size_t threads_count ) {
+    ItemsVectorSink sink{ result };
+    listItems( sink, recursive, threads_count );
+}
+
+void FSIndexer::listDirectoryItems( FSItemsStore& result, bool recursive, std::size_t threads_count ) {
+    ItemsStoreSink sink{ result };
+    listItems( sink, recursive, threads_count );
+}
+
+template< typename Sink >
+void FSIndexer::listItems( Sink& sink, bool recursive, std::size_t threads_count ) {
+    const auto root = sink.root( mDirItem.path(), mIncludeRootPath ? mDirItem.inArchivePath() : fs::path() );
+    if ( threads_count > 1 ) {
+        listDirectoryItemsInParallel( sink, recursive, threads_count, root );
+    } else {
+        listSubdirectoryItems( sink, recursive, fs::path(), root );
     }
-}
\ No newline at end of file
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+template< typename Sink >
+void FSIndexer::listSubdirectoryItems( Sink& sink,
+                                       bool recursive,
+                                       const fs::path& prefix,
+                                       typename Sink::Parent parent ) {
+    listDirectory( prefix, recursive, [ & ]( const FSItem& item, bool item_matches, bool list_subdirectory ) {
+        const auto node = sink.add( parent, Sink::makeEntry( item, item_matches ) );
+        if ( list_subdirectory ) { // NOLINT(misc-no-recursion)
+            listSubdirectoryItems( sink, true, prefix.empty() ? fs::path( item.name() ) : prefix / item.name(), node );
+        }
+    } );
+}
+
+namespace {
+/**
+ * @brief The entries of a directory, in listing order: each entry might have the node of a subdirectory
+ * to be listed.
+ *
+ * Flattening the tree of nodes depth-first gives the same sequence of entries produced by the sequential indexing.
+ */
+template< typename Entry >
+struct DirectoryNode {
+    struct NodeEntry {
+        Entry entry;
+        unique_ptr< DirectoryNode > subdirectory;
+    };
+
+    DirectoryNode( fs::path directory_prefix, bool recursive_listing )
+        : prefix{ std::move( directory_prefix ) }, recursive{ recursive_listing } {}
+
+    fs::path prefix;
+    bool recursive;
+    vector< NodeEntry > entries;
+};
+
+// NOLINTNEXTLINE(misc-no-recursion)
+template< typename Sink >
+void flattenDirectoryNode( DirectoryNode< typename Sink::Entry >& node, Sink& sink, typename Sink::Parent parent ) {
+    for ( auto& node_entry : node.entries ) {
+        const auto entry_node = sink.add( parent, std::move( node_entry.entry ) );
+        if ( node_entry.subdirectory ) {
+            flattenDirectoryNode( *node_entry.subdirectory, sink, entry_node );
+        }
+    }
+}
+/**
+ * @brief Work-stealing queues of the directories still to be listed: each worker pushes and pops
+ * the subdirectories it finds at the back of its own queue (depth-first), while idle workers steal
+ * from the front of the other workers' queues (i.e., the directories nearest to the root).
+ */
+template< typename Node >
+class DirectoryWorkQueues final {
+    public:
+        explicit DirectoryWorkQueues( std::size_t workers_count ) : mQueues( workers_count ) {}
+
+        void push( std::size_t worker_index, Node* node ) {
+            mPendingNodes.fetch_add( 1 );
+            {
+                const std::lock_guard< std::mutex > lock( mQueues[ worker_index ].mutex );
+                mQueues[ worker_index ].nodes.push_back( node );
+            }
+            mQueuedNodes.fetch_add( 1 );
+            notify( false );
+        }
+
+        /**
+         * @return the next directory to be listed by the given worker, or nullptr if all the directories
+         *         have been listed (or the indexing failed).
+         */
+        Node* pop( std::size_t worker_index ) {
+            while ( !mFailed.load() ) {
+                Node* node = tryPop( worker_index );
+                if ( node != nullptr ) {
+                    return node;
+                }
+
+                std::unique_lock< std::mutex > lock( mIdleMutex );
+                if ( mPendingNodes.load() == 0 ) {
+                    return nullptr;
+                }
+                mIdleCondition.wait( lock, [ this ]() {
+                    return mQueuedNodes.load() > 0 || mPendingNodes.load() == 0 || mFailed.load();
+                } );
+            }
+            return nullptr;
+        }
+
+        void completed() {
+            if ( mPendingNodes.fetch_sub( 1 ) == 1 ) {
+                notify( true );
+            }
+        }
+
+        void fail( std::exception_ptr error ) {
+            {
+                const std::lock_guard< std::mutex > lock( mIdleMutex );
+                if ( !mError ) {
+                    mError = std::move( error );
+                }
+                mFailed.store( true );
+            }
+            mIdleCondition.notify_all();
+        }
+
+        void rethrowError() const {
+            if ( mError ) {
+                std::rethrow_exception( mError );
+            }
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque< Node* > nodes;
+        };
+
+        vector< Queue > mQueues;
+        std::atomic< std::size_t > mPendingNodes{ 0 }; // Queued or being listed.
+        std::atomic< std::size_t > mQueuedNodes{ 0 };
+        std::atomic< bool > mFailed{ false };
+        std::mutex mIdleMutex;
+        std::condition_variable mIdleCondition;
+        std::exception_ptr mError;
+
+        Node* tryPop( std::size_t worker_index ) {
+            const std::size_t queues_count = mQueues.size();
+            for ( std::size_t offset = 0; offset < queues_count; ++offset ) {
+                const bool own_queue = offset == 0;
+                Queue& queue = mQueues[ ( worker_index + offset ) % queues_count ];
+                const std::lock_guard< std::mutex > lock( queue.mutex );
+                if ( queue.nodes.empty() ) {
+                    continue;
+                }
+                Node* node = own_queue ? queue.nodes.back() : queue.nodes.front();
+                if ( own_queue ) {
+                    queue.nodes.pop_back();
+                } else {
+                    queue.nodes.pop_front();
+                }
+                mQueuedNodes.fetch_sub( 1 );
+                return node;
+            }
+            return nullptr;
+        }
+
+        void notify( bool all ) {
+            {
+                // Note: locking the mutex guarantees that the notification is not lost by a worker that is
+                // checking the wait condition.
+                const std::lock_guard< std::mutex > lock( mIdleMutex );
+            }
+            if ( all ) {
+                mIdleCondition.notify_all();
+            } else {
+                mIdleCondition.notify_one();
+            }
+        }
+};
+} // namespace
+
+template< typename Sink >
+void FSIndexer::listDirectoryItemsInParallel( Sink& sink,
+                                              bool recursive,
+                                              std::size_t threads_count,
+                                              typename Sink::Parent parent ) {
+    using Node = DirectoryNode< typename Sink::Entry >;
+
+    Node root{ fs::path(), recursive };
+    DirectoryWorkQueues< Node > queues{ threads_count };
+    queues.push( 0, &root );
+
+    /* Note: each worker lists one directory at a time (i.e., the directory iterator is closed before listing
+     *       the subdirectories), so there are at most threads_count directory handles open at the same time. */
+    auto run_worker = [ & ]( std::size_t worker_index ) {
+        try {
+            Node* node = nullptr;
+            while ( ( node = queues.pop( worker_index ) ) != nullptr ) {
+                vector< Node* > subdirectories;
+                listDirectory( node->prefix, node->recursive, [ node, &subdirectories ]( const FSItem& item,
+                                                                                          bool item_matches,
+                                                                                          bool list_subdirectory ) {
+                    unique_ptr< Node > subdirectory_node;
+                    if ( list_subdirectory ) {
+                        subdirectory_node = std::make_unique< Node >( node->prefix.empty() ?
+                                                                      fs::path( item.name() ) :
+                                                                      node->prefix / item.name(), true );
+                        subdirectories.push_back( subdirectory_node.get() );
+                    }
+                    auto entry = Sink::makeEntry( item, item_matches );
+                    node->entries.push_back( { std::move( entry ), std::move( subdirectory_node ) } );
+                } );
+                // Pushing in reverse order, so that the worker continues with the first subdirectory.
+                for ( auto it = subdirectories.rbegin(); it != subdirectories.rend(); ++it ) {
+                    queues.push( worker_index, *it );
+                }
+                queues.completed();
+            }
+        } catch ( ... ) {
+            queues.fail( std::current_exception() );
+        }
+    };
+
+    vector< std::thread > workers;
+    workers.reserve( threads_count - 1 );
+    try {
+        for ( std::size_t worker_index = 1; worker_index < threads_count; ++worker_index ) {
+            workers.emplace_back( run_worker, worker_index );
+        }
+    } catch ( const std::system_error& ) {
+        // Not enough resources for all the workers: the ones already started (and this thread) will do the job.
+    }
+    run_worker( 0 ); // The calling thread is also a worker.
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+    queues.rethrowError();
+
+    flattenDirectoryNode( root, sink, parent );
+}
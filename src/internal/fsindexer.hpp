@@ -10,11 +10,13 @@
 #ifndef FSINDEXER_HPP
 #define FSINDEXER_HPP
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <map>
 
 #include "internal/fsitem.hpp"
+#include "internal/fsitemsstore.hpp"
 
 namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
 namespace filesystem {
@@ -24,16 +26,73 @@ using std::unique_ptr;
 
 class FSIndexer final {
     public:
-        explicit FSIndexer( FSItem directory, tstring filter = {}, bool only_files = false );
+        /**
+         * @param directory     the directory to be indexed.
+         * @param filter        the wildcard filter of the items to be indexed (empty means all the items).
+         * @param only_files    whether to index only the files (and not the folders).
+         * @param sort_entries  whether to sort the entries of each directory by name, so that the order of
+         *                      the indexed items does not depend on the filesystem (otherwise, the directory
+         *                      iteration order is used).
+         */
+        explicit FSIndexer( FSItem directory, tstring filter = {}, bool only_files = false, bool sort_entries = false );
 
+        /**
+         * @brief Indexes the items of the directory, appending them to the given vector.
+         *
+         * @note Indexing with more than one thread produces the same items, in the same order, as indexing
+         * with a single thread.
+         *
+         * @param result         the vector to which the indexed items are appended.
+         * @param recursive      whether to index also the content of the subdirectories.
+         * @param threads_count  the number of threads used for listing the (sub)directories.
+         */
         void listDirectoryItems( vector< unique_ptr< GenericInputItem > >& result,
                                  bool recursive,
-                                 const fs::path& prefix = fs::path() );
+                                 std::size_t threads_count = 1 );
+
+        /**
+         * @brief Indexes the items of the directory, adding them to the given compact store.
+         *
+         * @note The items are added in the same order as the ones appended to a vector.
+         *
+         * @param result         the store to which the indexed items are added.
+         * @param recursive      whether to index also the content of the subdirectories.
+         * @param threads_count  the number of threads used for listing the (sub)directories.
+         */
+        void listDirectoryItems( FSItemsStore& result, bool recursive, std::size_t threads_count = 1 );
 
     private:
         FSItem mDirItem;
         tstring mFilter;
         bool mOnlyFiles;
+        bool mSortEntries;
+        bool mIncludeRootPath;
+
+        template< typename Sink >
+        void listItems( Sink& sink, bool recursive, std::size_t threads_count );
+
+        template< typename Sink >
+        void listSubdirectoryItems( Sink& sink,
+                                    bool recursive,
+                                    const fs::path& prefix,
+                                    typename Sink::Parent parent );
+
+        template< typename Sink >
+        void listDirectoryItemsInParallel( Sink& sink,
+                                           bool recursive,
+                                           std::size_t threads_count,
+                                           typename Sink::Parent parent );
+
+        /**
+         * @brief Lists the entries of the (sub)directory having the given prefix (i.e., the path relative to
+         * the indexed directory), in the directory iteration order (or sorted by name), calling on_entry for
+         * each entry that is either an item to be indexed or a subdirectory to be listed.
+         */
+        template< typename OnEntry >
+        void listDirectory( const fs::path& prefix, bool recursive, OnEntry&& on_entry ) const;
+
+        template< typename OnEntry >
+        void visitEntry( const FSItem& item, bool recursive, OnEntry& on_entry ) const;
 };
 
 }  // namespace filesystem
@@ -30,76 +30,76 @@ using bit7z::filesystem::FSItem;
  *    As in mPath, mSearchPath does not contain trailing / or \! *
  * 3) mInArchivePath is the path of the item in the archive. If not already given (i.e., the user doesn't want to custom
  *    the path of the file in the archive), the path in the archive is calculated from mPath and mSearchPath
- *    (see inArchivePath() method). */
+ *    (see inArchivePath() method).
+ * 4) The name and the metadata of the item are read only once, in the constructor: FSIndexer creates an FSItem for
+ *    each entry of the indexed directories, so the constructors must not do more filesystem calls than needed. */
 
 FSItem::FSItem( const fs::path& itemPath, fs::path inArchivePath )
-    : mFileAttributeData(),
+    : mPath( FORMAT_LONG_PATH( itemPath ) ),
       mInArchivePath( !inArchivePath.empty() ? std::move( inArchivePath ) : fsutil::inArchivePath( itemPath ) ) {
-    std::error_code error;
-
-    mFileEntry.assign( FORMAT_LONG_PATH( itemPath ), error );
-    if ( error ) {
-        throw BitException( "Cannot read file entry", error, itemPath.string< tchar >() );
+    if ( !fsutil::getFileMetadata( mPath, mMetadata ) ) {
+        throw BitException( "Invalid path", last_error_code(), itemPath.string< tchar >() );
     }
-    if ( !mFileEntry.exists( error ) ) { // NOLINT
-        if ( !error ) { // call to "exists(error)" succeeded
-            error = std::make_error_code( std::errc::no_such_file_or_directory );
-        }
-        throw BitException( "Invalid path", error, itemPath.string< tchar >() );
+    if ( !mMetadata.exists ) { // e.g., a symbolic link to a non-existing file
+        throw BitException( "Invalid path",
+                            std::make_error_code( std::errc::no_such_file_or_directory ),
+                            itemPath.string< tchar >() );
     }
-    initAttributes( mFileEntry.path() );
-}
 
-FSItem::FSItem( fs::directory_entry entry, const fs::path& searchPath )
-    : mFileEntry( std::move( entry ) ),
-      mFileAttributeData(),
-      mInArchivePath( fsutil::inArchivePath( mFileEntry.path(), searchPath ) ) {
-    initAttributes( mFileEntry.path() );
+    /* Note: user-given paths might end with dots or separators (e.g., "foo/bar/."), so we need the normalized path
+     *       for the name. The path is normalized lexically, so that symbolic links are named after the link itself
+     *       (and not after their target), like the items found by FSIndexer. */
+    BIT7Z_MAYBE_UNUSED std::error_code error;
+    fs::path normal_path = fs::absolute( mPath, error ).lexically_normal();
+    if ( !normal_path.has_filename() ) { // e.g., "foo/bar/" is normalized as it is.
+        normal_path = normal_path.parent_path();
+    }
+    mName = normal_path.filename().string< tchar >();
 }
 
-void FSItem::initAttributes( const fs::path& itemPath ) {
-    if ( !fsutil::getFileAttributesEx( itemPath.c_str(), mFileAttributeData ) ) {
+FSItem::FSItem( const fs::path& entryPath,
+                const fs::path& searchPath,
+                const fsutil::DirectoryHandle& directory )
+    : mPath( entryPath ),
+      mName( mPath.filename().string< tchar >() ), // Entries of a directory are never dots.
+      mInArchivePath( fsutil::inArchivePath( mPath, searchPath ) ) {
+    if ( !directory.entryMetadata( mPath, mMetadata ) ) {
         //should not happen, but anyway...
-        throw BitException( "Could not retrieve file attributes", last_error_code(), itemPath.string< tchar >() );
+        throw BitException( "Could not retrieve file attributes", last_error_code(), mPath.string< tchar >() );
     }
 }
 
 bool FSItem::isDots() const {
-    const auto filename = mFileEntry.path().filename();
+    const auto filename = mPath.filename();
     return ( filename == "." || filename == ".." );
 }
 
 bool FSItem::isDir() const noexcept {
-    std::error_code error;
-    const bool res = mFileEntry.is_directory( error );
-    return !error && res;
+    return mMetadata.is_dir;
 }
 
 uint64_t FSItem::size() const noexcept {
-    std::error_code error;
-    const auto res = mFileEntry.file_size( error );
-    return !error ? res : 0;
+    return mMetadata.size;
 }
 
 FILETIME FSItem::creationTime() const noexcept {
-    return mFileAttributeData.ftCreationTime;
+    return mMetadata.attributes.ftCreationTime;
 }
 
 FILETIME FSItem::lastAccessTime() const noexcept {
-    return mFileAttributeData.ftLastAccessTime;
+    return mMetadata.attributes.ftLastAccessTime;
 }
 
 FILETIME FSItem::lastWriteTime() const noexcept {
-    return mFileAttributeData.ftLastWriteTime;
+    return mMetadata.attributes.ftLastWriteTime;
 }
 
 tstring FSItem::name() const {
-    BIT7Z_MAYBE_UNUSED std::error_code error;
-    return fs::canonical( mFileEntry.path(), error ).filename().string< tchar >();
+    return mName;
 }
 
 tstring FSItem::path() const {
-    return mFileEntry.path().string< tchar >();
+    return mPath.string< tchar >();
 }
 
 /* NOTE:
@@ -125,7 +125,11 @@ fs::path FSItem::inArchivePath() const {
 }
 
 uint32_t FSItem::attributes() const noexcept {
-    return mFileAttributeData.dwFileAttributes;
+    return mMetadata.attributes.dwFileAttributes;
+}
+
+const bit7z::filesystem::fsutil::FileMetadata& FSItem::metadata() const noexcept {
+    return mMetadata;
 }
 
 HRESULT FSItem::getStream( ISequentialInStream** inStream ) const {
@@ -134,7 +138,7 @@ HRESULT FSItem::getStream( ISequentialInStream** inStream ) const {
     }
 
     try {
-        auto inStreamLoc = bit7z::make_com< CFileInStream >( path() );
+        auto inStreamLoc = bit7z::make_com< CFileInStream >( path(), size() );
         *inStream = inStreamLoc.Detach();
     } catch ( const BitException& ex ) {
         return ex.nativeCode();
@@ -10,6 +10,7 @@
 #ifndef FSITEM_HPP
 #define FSITEM_HPP
 
+#include "internal/fsutil.hpp"
 #include "internal/genericinputitem.hpp"
 #include "internal/windows.hpp"
 
@@ -20,7 +21,9 @@ class FSItem final : public GenericInputItem {
     public:
         explicit FSItem( const fs::path& itemPath, fs::path inArchivePath = fs::path() );
 
-        explicit FSItem( fs::directory_entry entry, const fs::path& searchPath );
+        FSItem( const fs::path& entryPath,
+                const fs::path& searchPath,
+                const fsutil::DirectoryHandle& directory );
 
         BIT7Z_NODISCARD bool isDots() const;
 
@@ -44,12 +47,13 @@ class FSItem final : public GenericInputItem {
 
         BIT7Z_NODISCARD HRESULT getStream( ISequentialInStream** inStream ) const override;
 
+        BIT7Z_NODISCARD const fsutil::FileMetadata& metadata() const noexcept;
+
     private:
-        fs::directory_entry mFileEntry;
-        WIN32_FILE_ATTRIBUTE_DATA mFileAttributeData;
+        fs::path mPath;
+        tstring mName;
         fs::path mInArchivePath;
-
-        void initAttributes( const fs::path& itemPath );
+        fsutil::FileMetadata mMetadata;
 };
 
 }  // namespace filesystem
@@ -0,0 +1,178 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/fsitemsstore.hpp"
+
+#include <system_error>
+
+#include "bitexception.hpp"
+#include "internal/cfileinstream.hpp"
+#include "internal/util.hpp"
+
+using bit7z::BitPropVariant;
+using bit7z::tstring;
+using bit7z::filesystem::FSItemsStore;
+
+namespace {
+// The parents of the top-level nodes of an indexed directory are the roots, marked by the most significant bit.
+constexpr FSItemsStore::node_index kRootNode = 1u << 31u;
+constexpr FSItemsStore::node_index kMaxNodes = kRootNode;
+
+inline bool isRoot( FSItemsStore::node_index node ) noexcept {
+    return ( node & kRootNode ) != 0;
+}
+} // namespace
+
+FSItemsStore::node_index FSItemsStore::addRoot( const fs::path& directory, const fs::path& searchPath ) {
+    if ( mRoots.size() >= kMaxNodes ) {
+        throw BitException( "Cannot index the directory",
+                            std::make_error_code( std::errc::value_too_large ),
+                            directory.string< tchar >() );
+    }
+    mRoots.push_back( { directory, searchPath } );
+    return kRootNode | static_cast< node_index >( mRoots.size() - 1 );
+}
+
+FSItemsStore::node_index FSItemsStore::addNode( node_index parent, const tstring& name ) {
+    if ( mParents.size() >= kMaxNodes ) {
+        throw BitException( "Cannot index the item", std::make_error_code( std::errc::value_too_large ), name );
+    }
+    mNamesArena += name;
+    mNamesOffsets.push_back( mNamesArena.size() );
+    mParents.push_back( parent );
+    return static_cast< node_index >( mParents.size() - 1 );
+}
+
+void FSItemsStore::addItem( node_index node, const fsutil::FileMetadata& metadata ) {
+    mItemsNodes.push_back( node );
+    mSizes.push_back( metadata.size );
+    mAttributes.push_back( metadata.attributes.dwFileAttributes );
+    mCreationTimes.push_back( metadata.attributes.ftCreationTime );
+    mAccessTimes.push_back( metadata.attributes.ftLastAccessTime );
+    mWriteTimes.push_back( metadata.attributes.ftLastWriteTime );
+    mDirectories.push_back( metadata.is_dir );
+}
+
+std::size_t FSItemsStore::size() const noexcept {
+    return mItemsNodes.size();
+}
+
+bool FSItemsStore::isDir( std::size_t index ) const {
+    return mDirectories[ index ];
+}
+
+uint64_t FSItemsStore::itemSize( std::size_t index ) const {
+    return mSizes[ index ];
+}
+
+fs::path FSItemsStore::path( std::size_t index ) const {
+    const std::lock_guard< std::mutex > lock{ mPathsCache.mutex };
+    const Root& root = relativeParentPath( index );
+    return root.directory / mPathsCache.parentPath / nodeName( mItemsNodes[ index ] );
+}
+
+fs::path FSItemsStore::inArchivePath( std::size_t index ) const {
+    const std::lock_guard< std::mutex > lock{ mPathsCache.mutex };
+    if ( mPathsCache.hasItem && mPathsCache.item == index ) {
+        return mPathsCache.inArchivePath;
+    }
+    mPathsCache.hasItem = false;
+
+    // Note: this is the same path computed by FSItem for the items found by FSIndexer.
+    const Root& root = relativeParentPath( index );
+    const fs::path& parent_path = mPathsCache.parentPath;
+    const fs::path item_path = root.directory / parent_path / nodeName( mItemsNodes[ index ] );
+    if ( parent_path.empty() ) {
+        mPathsCache.inArchivePath = fsutil::inArchivePath( item_path, root.searchPath );
+    } else {
+        mPathsCache.inArchivePath = fsutil::inArchivePath( item_path, root.searchPath.empty() ?
+                                                                      parent_path : root.searchPath / parent_path );
+    }
+    mPathsCache.item = index;
+    mPathsCache.hasItem = true;
+    return mPathsCache.inArchivePath;
+}
+
+BitPropVariant FSItemsStore::itemProperty( std::size_t index, BitProperty property ) const {
+    switch ( property ) {
+        case BitProperty::Path:
+            return BitPropVariant{ inArchivePath( index ).wstring() };
+        case BitProperty::IsDir:
+            return BitPropVariant{ isDir( index ) };
+        case BitProperty::Size:
+            return BitPropVariant{ mSizes[ index ] };
+        case BitProperty::Attrib:
+            return BitPropVariant{ mAttributes[ index ] };
+        case BitProperty::CTime:
+            return BitPropVariant{ mCreationTimes[ index ] };
+        case BitProperty::ATime:
+            return BitPropVariant{ mAccessTimes[ index ] };
+        case BitProperty::MTime:
+            return BitPropVariant{ mWriteTimes[ index ] };
+        default:
+            return BitPropVariant{};
+    }
+}
+
+HRESULT FSItemsStore::itemStream( std::size_t index, ISequentialInStream** inStream ) const {
+    if ( isDir( index ) ) {
+        return S_OK;
+    }
+
+    try {
+        auto inStreamLoc = bit7z::make_com< CFileInStream >( path( index ), mSizes[ index ] );
+        *inStream = inStreamLoc.Detach();
+    } catch ( const BitException& ex ) {
+        return ex.nativeCode();
+    }
+    return S_OK;
+}
+
+const FSItemsStore::Root& FSItemsStore::relativeParentPath( std::size_t index ) const {
+    const node_index parent = mParents[ mItemsNodes[ index ] ];
+    if ( mPathsCache.hasParent && mPathsCache.parent == parent ) {
+        return mRoots[ mPathsCache.root ];
+    }
+    mPathsCache.hasParent = false;
+
+    auto& ancestors = mPathsCache.ancestors;
+    ancestors.clear();
+    node_index node = parent;
+    while ( !isRoot( node ) ) {
+        ancestors.push_back( node );
+        node = mParents[ node ];
+    }
+
+    fs::path& parent_path = mPathsCache.parentPath;
+    parent_path.clear();
+    for ( auto it = ancestors.rbegin(); it != ancestors.rend(); ++it ) {
+        parent_path /= nodeName( *it );
+    }
+    mPathsCache.parent = parent;
+    mPathsCache.root = node & ~kRootNode;
+    mPathsCache.hasParent = true;
+    return mRoots[ mPathsCache.root ];
+}
+
+FSItemsStore::PathsCache& FSItemsStore::PathsCache::operator=( const PathsCache& other ) noexcept {
+    if ( this != &other ) {
+        // Note: the nodes and items of the copied store are different, so the cache must be reset.
+        hasParent = false;
+        hasItem = false;
+    }
+    return *this;
+}
+
+tstring FSItemsStore::nodeName( node_index node ) const {
+    const std::size_t name_offset = mNamesOffsets[ node ];
+    return mNamesArena.substr( name_offset, mNamesOffsets[ node + 1 ] - name_offset );
+}
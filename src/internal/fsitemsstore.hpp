@@ -0,0 +1,152 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FSITEMSSTORE_HPP
+#define FSITEMSSTORE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "bitpropvariant.hpp"
+#include "internal/fs.hpp"
+#include "internal/fsutil.hpp"
+#include "internal/windows.hpp"
+
+struct ISequentialInStream;
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace filesystem {
+
+/**
+ * @brief Compact, columnar store of the filesystem items found while indexing directories.
+ *
+ * Each metadata of the items is stored in its own array (indexed by the item index), while the paths are stored
+ * as a tree of nodes: each node has the index of its parent node, and its name is stored in a string arena shared
+ * by all the nodes. Nodes are created also for the directories that are not items themselves (e.g., because
+ * they do not match the filter of the indexing), but that contain some items.
+ *
+ * The full paths of the items (both on the filesystem and in the archive) are built only when requested;
+ * the path of the last requested parent node, and the path in the archive of the last requested item, are cached
+ * since the properties of an item are usually requested one after the other (e.g., while compressing it).
+ */
+class FSItemsStore final {
+    public:
+        using node_index = uint32_t;
+
+        FSItemsStore() = default;
+
+        FSItemsStore( const FSItemsStore& ) = default;
+
+        FSItemsStore( FSItemsStore&& ) = delete;
+
+        FSItemsStore& operator=( const FSItemsStore& ) = default;
+
+        FSItemsStore& operator=( FSItemsStore&& ) = delete;
+
+        ~FSItemsStore() = default;
+
+        /**
+         * @brief Adds the root of an indexed directory.
+         *
+         * @param directory  the path of the indexed directory.
+         * @param searchPath the path in the archive of the content of the directory (see fsutil::inArchivePath).
+         *
+         * @return the node to be used as the parent of the entries of the directory.
+         */
+        node_index addRoot( const fs::path& directory, const fs::path& searchPath );
+
+        /**
+         * @brief Adds a node with the given name and parent (either a root or another node).
+         */
+        node_index addNode( node_index parent, const tstring& name );
+
+        /**
+         * @brief Adds an item, i.e., a node with the given metadata.
+         */
+        void addItem( node_index node, const fsutil::FileMetadata& metadata );
+
+        BIT7Z_NODISCARD std::size_t size() const noexcept;
+
+        BIT7Z_NODISCARD bool isDir( std::size_t index ) const;
+
+        BIT7Z_NODISCARD uint64_t itemSize( std::size_t index ) const;
+
+        /**
+         * @return the path of the item on the filesystem.
+         */
+        BIT7Z_NODISCARD fs::path path( std::size_t index ) const;
+
+        /**
+         * @return the path of the item in the archive.
+         */
+        BIT7Z_NODISCARD fs::path inArchivePath( std::size_t index ) const;
+
+        BIT7Z_NODISCARD BitPropVariant itemProperty( std::size_t index, BitProperty property ) const;
+
+        BIT7Z_NODISCARD HRESULT itemStream( std::size_t index, ISequentialInStream** inStream ) const;
+
+    private:
+        struct Root {
+            fs::path directory;
+            fs::path searchPath;
+        };
+
+        std::vector< Root > mRoots;
+
+        // Nodes
+        tstring mNamesArena;
+        std::vector< std::size_t > mNamesOffsets{ 0 }; // Nodes count + 1 offsets in mNamesArena.
+        std::vector< node_index > mParents;
+
+        // Items
+        std::vector< node_index > mItemsNodes;
+        std::vector< uint64_t > mSizes;
+        std::vector< uint32_t > mAttributes;
+        std::vector< FILETIME > mCreationTimes;
+        std::vector< FILETIME > mAccessTimes;
+        std::vector< FILETIME > mWriteTimes;
+        std::vector< bool > mDirectories;
+
+        struct PathsCache {
+            std::mutex mutex;
+            bool hasParent = false;
+            node_index parent = 0;
+            std::size_t root = 0;
+            fs::path parentPath; // Relative to the root directory.
+            std::vector< node_index > ancestors; // Reused buffer for walking the parent chain.
+            bool hasItem = false;
+            std::size_t item = 0;
+            fs::path inArchivePath;
+
+            PathsCache() = default;
+
+            // Note: copies of the store start with an empty cache.
+            PathsCache( const PathsCache& /*other*/ ) noexcept {} // NOLINT(bugprone-copy-constructor-init)
+
+            PathsCache& operator=( const PathsCache& other ) noexcept;
+        };
+
+        mutable PathsCache mPathsCache;
+
+        /**
+         * @brief Builds (or reuses) the path of the given item's parent relative to the indexed directory
+         * in mPathsCache.parentPath, returning the item's root.
+         *
+         * @note The mutex of the paths cache must be locked by the caller.
+         */
+        const Root& relativeParentPath( std::size_t index ) const;
+
+        BIT7Z_NODISCARD tstring nodeName( node_index node ) const;
+};
+
+}  // namespace filesystem
+}  // namespace bit7z
+
+#endif //FSITEMSSTORE_HPP
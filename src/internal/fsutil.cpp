@@ -15,6 +15,9 @@
 #include <algorithm> //for std::adjacent_find
 
 #ifndef _WIN32
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -225,6 +228,44 @@ bool fsutil::setFileModifiedTime( const fs::path& filePath, const FILETIME& ftMo
 #endif
 }
 
+#ifndef _WIN32
+namespace {
+void fill_file_attributes( const struct stat& stat_info, WIN32_FILE_ATTRIBUTE_DATA& fileMetadata ) noexcept {
+    // File attributes
+    fileMetadata.dwFileAttributes = S_ISDIR( stat_info.st_mode ) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_ARCHIVE;
+    if ( ( stat_info.st_mode & S_IWUSR ) == 0 ) {
+        fileMetadata.dwFileAttributes |= FILE_ATTRIBUTE_READONLY;
+    }
+    fileMetadata.dwFileAttributes |= FILE_ATTRIBUTE_UNIX_EXTENSION + ( ( stat_info.st_mode & 0xFFFF ) << 16 );
+
+    // File times
+    fileMetadata.ftCreationTime = time_to_FILETIME( stat_info.st_ctime );
+    fileMetadata.ftLastAccessTime = time_to_FILETIME( stat_info.st_atime );
+    fileMetadata.ftLastWriteTime = time_to_FILETIME( stat_info.st_mtime );
+}
+
+bool read_file_metadata( int directory_fd, const char* file_path, fsutil::FileMetadata& metadata ) noexcept {
+    struct stat stat_info{};
+    if ( fstatat( directory_fd, file_path, &stat_info, AT_SYMLINK_NOFOLLOW ) != 0 ) {
+        return false;
+    }
+    fill_file_attributes( stat_info, metadata.attributes );
+
+    metadata.exists = true;
+    if ( S_ISLNK( stat_info.st_mode ) ) {
+        // Only symbolic links need a second call, for getting the type and the size of their target.
+        metadata.exists = fstatat( directory_fd, file_path, &stat_info, 0 ) == 0;
+        if ( !metadata.exists ) {
+            stat_info.st_mode = 0;
+        }
+    }
+    metadata.is_dir = S_ISDIR( stat_info.st_mode );
+    metadata.size = S_ISREG( stat_info.st_mode ) ? static_cast< uint64_t >( stat_info.st_size ) : 0;
+    return true;
+}
+} // namespace
+#endif
+
 bool fsutil::getFileAttributesEx( const fs::path& filePath, WIN32_FILE_ATTRIBUTE_DATA& fileMetadata ) noexcept {
     if ( filePath.empty() ) {
         return false;
@@ -237,22 +278,110 @@ bool fsutil::getFileAttributesEx( const fs::path& filePath, WIN32_FILE_ATTRIBUTE
     if ( lstat( filePath.c_str(), &stat_info ) != 0 ) {
         return false;
     }
+    fill_file_attributes( stat_info, fileMetadata );
+    return true;
+#endif
+}
 
-    // File attributes
-    fileMetadata.dwFileAttributes = S_ISDIR( stat_info.st_mode ) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_ARCHIVE;
-    if ( ( stat_info.st_mode & S_IWUSR ) == 0 ) {
-        fileMetadata.dwFileAttributes |= FILE_ATTRIBUTE_READONLY;
+bool fsutil::getFileMetadata( const fs::path& filePath, FileMetadata& metadata ) noexcept {
+    if ( filePath.empty() ) {
+        return false;
     }
-    fileMetadata.dwFileAttributes |= FILE_ATTRIBUTE_UNIX_EXTENSION + ( ( stat_info.st_mode & 0xFFFF ) << 16 );
 
-    // File times
-    fileMetadata.ftCreationTime = time_to_FILETIME( stat_info.st_ctime );
-    fileMetadata.ftLastAccessTime = time_to_FILETIME( stat_info.st_atime );
-    fileMetadata.ftLastWriteTime = time_to_FILETIME( stat_info.st_mtime );
+#ifdef _WIN32
+    if ( ::GetFileAttributesExW( filePath.c_str(), GetFileExInfoStandard, &metadata.attributes ) == FALSE ) {
+        return false;
+    }
+
+    const DWORD attributes = metadata.attributes.dwFileAttributes;
+    if ( ( attributes & FILE_ATTRIBUTE_REPARSE_POINT ) != 0 ) {
+        // Symbolic links and junctions: the type and the size are the ones of the target.
+        std::error_code error;
+        const auto target_status = fs::status( filePath, error );
+        metadata.exists = !error && fs::exists( target_status );
+        metadata.is_dir = metadata.exists && fs::is_directory( target_status );
+        metadata.size = metadata.exists && fs::is_regular_file( target_status ) ? fs::file_size( filePath, error ) : 0;
+        if ( error ) {
+            metadata.size = 0;
+        }
+    } else {
+        metadata.exists = true;
+        metadata.is_dir = ( attributes & FILE_ATTRIBUTE_DIRECTORY ) != 0;
+        metadata.size = metadata.is_dir ? 0 : ( static_cast< uint64_t >( metadata.attributes.nFileSizeHigh ) << 32u ) |
+                                              metadata.attributes.nFileSizeLow;
+    }
     return true;
+#else
+    return read_file_metadata( AT_FDCWD, filePath.c_str(), metadata );
 #endif
 }
 
+#ifdef _WIN32
+fsutil::DirectoryHandle::DirectoryHandle( const fs::path& directory )
+    : mIterator{ directory, mError } {}
+
+fsutil::DirectoryHandle::~DirectoryHandle() = default;
+
+bool fsutil::DirectoryHandle::nextEntry( fs::path& entryPath ) {
+    if ( mError || mIterator == fs::directory_iterator{} ) {
+        return false;
+    }
+    entryPath = mIterator->path();
+    mIterator.increment( mError );
+    return true;
+}
+
+bool fsutil::DirectoryHandle::entryMetadata( const fs::path& entryPath, FileMetadata& metadata ) const noexcept {
+    return getFileMetadata( entryPath, metadata );
+}
+#else
+fsutil::DirectoryHandle::DirectoryHandle( const fs::path& directory )
+    : mDirectory{ directory }, mDirectoryStream{ opendir( directory.c_str() ) } {
+    if ( mDirectoryStream == nullptr ) {
+        mError = std::error_code{ errno, std::generic_category() };
+    }
+}
+
+fsutil::DirectoryHandle::~DirectoryHandle() {
+    if ( mDirectoryStream != nullptr ) {
+        closedir( mDirectoryStream );
+    }
+}
+
+bool fsutil::DirectoryHandle::nextEntry( fs::path& entryPath ) {
+    if ( mDirectoryStream == nullptr ) {
+        return false;
+    }
+    // Note: readdir returns nullptr both at the end of the directory and on errors, which are told apart by errno.
+    errno = 0;
+    // Note: each DirectoryHandle is used by a single thread at a time, so readdir is safe here.
+    while ( const dirent* entry = readdir( mDirectoryStream ) ) { // NOLINT(concurrency-mt-unsafe)
+        const char* entry_name = entry->d_name;
+        if ( std::strcmp( entry_name, "." ) != 0 && std::strcmp( entry_name, ".." ) != 0 ) {
+            entryPath = mDirectory / entry_name;
+            return true;
+        }
+    }
+    if ( errno != 0 ) {
+        mError = std::error_code{ errno, std::generic_category() };
+    }
+    return false;
+}
+
+bool fsutil::DirectoryHandle::entryMetadata( const fs::path& entryPath, FileMetadata& metadata ) const noexcept {
+    if ( mDirectoryStream == nullptr ) {
+        return getFileMetadata( entryPath, metadata );
+    }
+    // Note: the filename is relative to the directory, so the kernel doesn't need to resolve the whole path.
+    const fs::path entry_name = entryPath.filename();
+    return read_file_metadata( dirfd( mDirectoryStream ), entry_name.c_str(), metadata );
+}
+#endif
+
+const std::error_code& fsutil::DirectoryHandle::error() const noexcept {
+    return mError;
+}
+
 #if defined( _WIN32 ) && defined( BIT7Z_AUTO_PREFIX_LONG_PATHS )
 
 constexpr auto LONG_PATH_PREFIX = R"(\\?\)";
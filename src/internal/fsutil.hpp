@@ -10,7 +10,13 @@
 #ifndef FSUTIL_HPP
 #define FSUTIL_HPP
 
+#include <cstdint>
 #include <string>
+#include <system_error>
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
 
 #include "bitdefines.hpp"
 #include "bittypes.hpp"
@@ -30,6 +36,82 @@ BIT7Z_NODISCARD bool wildcardMatch( const tstring& pattern, const tstring& str )
 BIT7Z_NODISCARD bool getFileAttributesEx( const fs::path& filePath,
                                           WIN32_FILE_ATTRIBUTE_DATA& fileMetadata ) noexcept;
 
+/**
+ * @brief The metadata of a filesystem item needed for compressing it.
+ */
+struct FileMetadata {
+    WIN32_FILE_ATTRIBUTE_DATA attributes{}; // The attributes of the item (symbolic links are not followed).
+    uint64_t size = 0; // The size of the item (or of the symbolic link's target), 0 if it is not a regular file.
+    bool is_dir = false; // Whether the item is a directory, or a symbolic link to a directory.
+    bool exists = false; // Whether the item exists (false for symbolic links to non-existing items).
+};
+
+/**
+ * @brief Reads the metadata of the item at the given path.
+ *
+ * @note The metadata are read using a single system call, unless the item is a symbolic link
+ * (in which case, a second call is needed for the link's target).
+ *
+ * @return true if the item's metadata could be read, false otherwise (e.g., the item doesn't exist).
+ */
+BIT7Z_NODISCARD bool getFileMetadata( const fs::path& filePath, FileMetadata& metadata ) noexcept;
+
+/**
+ * @brief An open directory, whose entries can be listed, and whose entries' metadata can be read without resolving
+ * again all the components of the entries' paths.
+ *
+ * @note On POSIX systems, both the listing and the metadata use the same file descriptor, so each DirectoryHandle
+ * keeps only one descriptor open. On Windows, the metadata are read using the entries' full paths.
+ */
+class DirectoryHandle final {
+    public:
+        explicit DirectoryHandle( const fs::path& directory );
+
+        DirectoryHandle( const DirectoryHandle& ) = delete;
+
+        DirectoryHandle( DirectoryHandle&& ) = delete;
+
+        DirectoryHandle& operator=( const DirectoryHandle& ) = delete;
+
+        DirectoryHandle& operator=( DirectoryHandle&& ) = delete;
+
+        ~DirectoryHandle();
+
+        /**
+         * @brief Reads the next entry of the directory (the "." and ".." entries are skipped).
+         *
+         * @param entryPath the object to be filled with the full path of the entry.
+         *
+         * @return true if there was a next entry, false if all the entries were listed, or in case of errors
+         *         (e.g., the directory couldn't be opened), which are then given by error().
+         */
+        BIT7Z_NODISCARD bool nextEntry( fs::path& entryPath );
+
+        /**
+         * @return the error that occurred while opening the directory or reading its entries (if any).
+         */
+        BIT7Z_NODISCARD const std::error_code& error() const noexcept;
+
+        /**
+         * @brief Reads the metadata of the given entry of the directory (see getFileMetadata).
+         *
+         * @param entryPath the full path of the entry (only its filename is used if the directory is open).
+         * @param metadata  the object to be filled with the entry's metadata.
+         *
+         * @return true if the entry's metadata could be read, false otherwise.
+         */
+        BIT7Z_NODISCARD bool entryMetadata( const fs::path& entryPath, FileMetadata& metadata ) const noexcept;
+
+    private:
+        std::error_code mError;
+#ifdef _WIN32
+        fs::directory_iterator mIterator;
+#else
+        fs::path mDirectory;
+        DIR* mDirectoryStream;
+#endif
+};
+
 bool setFileModifiedTime( const fs::path& filePath, const FILETIME& ftModified ) noexcept;
 
 bool setFileAttributes( const fs::path& filePath, DWORD attributes ) noexcept;
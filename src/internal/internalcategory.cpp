@@ -60,6 +60,8 @@ std::string internal_category_t::message( int error_value ) const noexcept {
             return "Unsupported operation.";
         case BitError::WrongUpdateMode:
             return "Wrong update mode.";
+        case BitError::OperationCancelled:
+            return "Operation cancelled.";
         default:
             return "Unknown error.";
     }
@@ -87,6 +89,8 @@ std::error_condition bit7z::internal_category_t::default_error_condition( int er
         case BitError::ItemMarkedAsDeleted:
         case BitError::WrongUpdateMode:
             return std::make_error_condition( std::errc::operation_not_permitted );
+        case BitError::OperationCancelled:
+            return std::make_error_condition( std::errc::operation_canceled );
         default:
             return error_category::default_error_condition( error_value );
     }
@@ -0,0 +1,142 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/iostats.hpp"
+
+using namespace bit7z;
+
+namespace {
+// Upper bounds (inclusive) of the buckets of the seek distance histogram; the last bucket is unbounded.
+constexpr std::array< uint64_t, kSeekDistanceBuckets - 1 > kSeekDistanceBounds = { { 0,
+                                                                                     4ull * 1024,
+                                                                                     64ull * 1024,
+                                                                                     1024ull * 1024,
+                                                                                     16ull * 1024 * 1024 } };
+
+inline void add( std::atomic< uint64_t >& counter, uint64_t value ) noexcept {
+    counter.fetch_add( value, std::memory_order_relaxed );
+}
+
+inline uint64_t load( const std::atomic< uint64_t >& counter ) noexcept {
+    return counter.load( std::memory_order_relaxed );
+}
+} // namespace
+
+void IOStatsCollector::record( IOOperation operation, uint64_t amount, std::chrono::nanoseconds elapsed ) noexcept {
+    const auto elapsed_ns = static_cast< uint64_t >( elapsed.count() );
+    switch ( operation ) {
+        case IOOperation::Read:
+            add( mReadCalls, 1 );
+            add( mReadBytes, amount );
+            add( mReadTime, elapsed_ns );
+            break;
+        case IOOperation::Write:
+            add( mWriteCalls, 1 );
+            add( mWriteBytes, amount );
+            add( mWriteTime, elapsed_ns );
+            break;
+        case IOOperation::Seek:
+        default:
+            add( mSeekCalls, 1 );
+            add( mSeekTime, elapsed_ns );
+            add( mSeekDistances[ seekDistanceBucket( amount ) ], 1 );
+            break;
+    }
+}
+
+void IOStatsCollector::merge( const BitOperationStats& stats ) noexcept {
+    add( mReadCalls, stats.readCalls );
+    add( mReadBytes, stats.readBytes );
+    add( mReadTime, static_cast< uint64_t >( stats.readTime.count() ) );
+    add( mWriteCalls, stats.writeCalls );
+    add( mWriteBytes, stats.writeBytes );
+    add( mWriteTime, static_cast< uint64_t >( stats.writeTime.count() ) );
+    add( mSeekCalls, stats.seekCalls );
+    add( mSeekTime, static_cast< uint64_t >( stats.seekTime.count() ) );
+    for ( std::size_t bucket = 0; bucket < kSeekDistanceBuckets; ++bucket ) {
+        add( mSeekDistances[ bucket ], stats.seekDistances[ bucket ] );
+    }
+}
+
+BitOperationStats IOStatsCollector::stats() const noexcept {
+    using std::chrono::nanoseconds;
+
+    BitOperationStats result;
+    result.readCalls = load( mReadCalls );
+    result.readBytes = load( mReadBytes );
+    result.readTime = nanoseconds{ static_cast< nanoseconds::rep >( load( mReadTime ) ) };
+    result.writeCalls = load( mWriteCalls );
+    result.writeBytes = load( mWriteBytes );
+    result.writeTime = nanoseconds{ static_cast< nanoseconds::rep >( load( mWriteTime ) ) };
+    result.seekCalls = load( mSeekCalls );
+    result.seekTime = nanoseconds{ static_cast< nanoseconds::rep >( load( mSeekTime ) ) };
+    for ( std::size_t bucket = 0; bucket < kSeekDistanceBuckets; ++bucket ) {
+        result.seekDistances[ bucket ] = load( mSeekDistances[ bucket ] );
+    }
+    return result;
+}
+
+std::size_t IOStatsCollector::seekDistanceBucket( uint64_t distance ) noexcept {
+    std::size_t bucket = 0;
+    while ( bucket < kSeekDistanceBounds.size() && distance > kSeekDistanceBounds[ bucket ] ) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+void IOStatsRecorder::setIOStatsCollector( IOStatsCollector* collector ) noexcept {
+    mIOStatsCollector = collector;
+}
+
+IOStatsCollector* IOStatsRecorder::ioStatsCollector() const noexcept {
+    return mIOStatsCollector;
+}
+
+IOStatsRecord::IOStatsRecord( IOStatsCollector* collector, IOOperation operation ) noexcept
+    : mCollector{ collector },
+      mOperation{ operation },
+      mAmount{ 0 },
+      mStart{ collector != nullptr ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{} } {}
+
+IOStatsRecord::~IOStatsRecord() {
+    if ( mCollector != nullptr ) {
+        const auto elapsed = std::chrono::steady_clock::now() - mStart;
+        mCollector->record( mOperation,
+                            mAmount,
+                            std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ) );
+    }
+}
+
+bool IOStatsRecord::active() const noexcept {
+    return mCollector != nullptr;
+}
+
+void IOStatsRecord::setBytes( uint64_t bytes ) noexcept {
+    mAmount = bytes;
+}
+
+void IOStatsRecord::setSeek( uint64_t old_position, uint64_t new_position ) noexcept {
+    mAmount = old_position > new_position ? old_position - new_position : new_position - old_position;
+}
+
+IOStatsAttachment::IOStatsAttachment( IOStatsRecorder* recorder, IOStatsCollector* collector ) noexcept
+    : mRecorder{ collector != nullptr ? recorder : nullptr } {
+    if ( mRecorder != nullptr ) {
+        mRecorder->setIOStatsCollector( collector );
+    }
+}
+
+IOStatsAttachment::~IOStatsAttachment() {
+    if ( mRecorder != nullptr ) {
+        mRecorder->setIOStatsCollector( nullptr );
+    }
+}
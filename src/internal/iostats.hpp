@@ -0,0 +1,182 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef IOSTATS_HPP
+#define IOSTATS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "bitdefines.hpp"
+#include "bitoperationstats.hpp"
+
+namespace bit7z {
+
+enum struct IOOperation {
+    Read,
+    Write,
+    Seek
+};
+
+/**
+ * @brief Thread-safe accumulator of the I/O statistics of the streams used by a single operation.
+ *
+ * @note The streams of an operation might be used by different threads (e.g., by multithreaded encoders),
+ * so all the counters are relaxed atomics.
+ */
+class IOStatsCollector final {
+    public:
+        IOStatsCollector() = default;
+
+        IOStatsCollector( const IOStatsCollector& ) = delete;
+
+        IOStatsCollector( IOStatsCollector&& ) = delete;
+
+        IOStatsCollector& operator=( const IOStatsCollector& ) = delete;
+
+        IOStatsCollector& operator=( IOStatsCollector&& ) = delete;
+
+        ~IOStatsCollector() = default;
+
+        /**
+         * @brief Records a single call of a stream.
+         *
+         * @param operation the kind of the call.
+         * @param amount    the number of bytes read or written, or the distance covered by the seek.
+         * @param elapsed   the duration of the call.
+         */
+        void record( IOOperation operation, uint64_t amount, std::chrono::nanoseconds elapsed ) noexcept;
+
+        /**
+         * @brief Adds the given statistics (e.g., collected by another operation) to the ones of this collector.
+         */
+        void merge( const BitOperationStats& stats ) noexcept;
+
+        BIT7Z_NODISCARD BitOperationStats stats() const noexcept;
+
+        /**
+         * @return the index of the bucket of the seek distance histogram containing the given distance.
+         */
+        BIT7Z_NODISCARD static std::size_t seekDistanceBucket( uint64_t distance ) noexcept;
+
+    private:
+        std::atomic< uint64_t > mReadCalls{ 0 };
+        std::atomic< uint64_t > mReadBytes{ 0 };
+        std::atomic< uint64_t > mReadTime{ 0 };
+        std::atomic< uint64_t > mWriteCalls{ 0 };
+        std::atomic< uint64_t > mWriteBytes{ 0 };
+        std::atomic< uint64_t > mWriteTime{ 0 };
+        std::atomic< uint64_t > mSeekCalls{ 0 };
+        std::atomic< uint64_t > mSeekTime{ 0 };
+        std::array< std::atomic< uint64_t >, kSeekDistanceBuckets > mSeekDistances{};
+};
+
+/**
+ * @brief Base class of the streams whose calls can be recorded by an IOStatsCollector.
+ *
+ * By default, no collector is attached, and the streams do not record anything (not even the time of the calls).
+ */
+class IOStatsRecorder {
+    public:
+        void setIOStatsCollector( IOStatsCollector* collector ) noexcept;
+
+    protected:
+        IOStatsRecorder() = default;
+
+        IOStatsRecorder( const IOStatsRecorder& ) = delete;
+
+        IOStatsRecorder( IOStatsRecorder&& ) = delete;
+
+        IOStatsRecorder& operator=( const IOStatsRecorder& ) = delete;
+
+        IOStatsRecorder& operator=( IOStatsRecorder&& ) = delete;
+
+        ~IOStatsRecorder() = default;
+
+        BIT7Z_NODISCARD IOStatsCollector* ioStatsCollector() const noexcept;
+
+    private:
+        // Note: the collector is set before an operation starts and reset after it ends, so a plain pointer is enough.
+        IOStatsCollector* mIOStatsCollector{ nullptr };
+};
+
+/**
+ * @brief RAII object recording a single Read, Write or Seek call of a stream, if a collector is attached to it.
+ */
+class IOStatsRecord final {
+    public:
+        IOStatsRecord( IOStatsCollector* collector, IOOperation operation ) noexcept;
+
+        IOStatsRecord( const IOStatsRecord& ) = delete;
+
+        IOStatsRecord( IOStatsRecord&& ) = delete;
+
+        IOStatsRecord& operator=( const IOStatsRecord& ) = delete;
+
+        IOStatsRecord& operator=( IOStatsRecord&& ) = delete;
+
+        ~IOStatsRecord();
+
+        /**
+         * @return whether the call is being recorded (i.e., whether the stream has an attached collector).
+         */
+        BIT7Z_NODISCARD bool active() const noexcept;
+
+        void setBytes( uint64_t bytes ) noexcept;
+
+        void setSeek( uint64_t old_position, uint64_t new_position ) noexcept;
+
+    private:
+        IOStatsCollector* mCollector;
+        IOOperation mOperation;
+        uint64_t mAmount;
+        std::chrono::steady_clock::time_point mStart;
+};
+
+/**
+ * @brief Attaches the given collector to the given stream, if the stream supports the recording of its calls.
+ */
+template< typename Stream >
+void attachIOStats( Stream* stream, IOStatsCollector* collector ) noexcept {
+    if ( collector == nullptr ) {
+        return;
+    }
+    auto* recorder = dynamic_cast< IOStatsRecorder* >( stream );
+    if ( recorder != nullptr ) {
+        recorder->setIOStatsCollector( collector );
+    }
+}
+
+/**
+ * @brief RAII object attaching a collector to a stream (e.g., the stream of an archive) for the duration
+ * of an operation.
+ */
+class IOStatsAttachment final {
+    public:
+        IOStatsAttachment( IOStatsRecorder* recorder, IOStatsCollector* collector ) noexcept;
+
+        IOStatsAttachment( const IOStatsAttachment& ) = delete;
+
+        IOStatsAttachment( IOStatsAttachment&& ) = delete;
+
+        IOStatsAttachment& operator=( const IOStatsAttachment& ) = delete;
+
+        IOStatsAttachment& operator=( IOStatsAttachment&& ) = delete;
+
+        ~IOStatsAttachment();
+
+    private:
+        IOStatsRecorder* mRecorder;
+};
+
+}  // namespace bit7z
+
+#endif //IOSTATS_HPP
@@ -0,0 +1,37 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ITEMPROPERTIES_HPP
+#define ITEMPROPERTIES_HPP
+
+#include <array>
+
+#include "bitpropvariant.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief The item properties that are used by most of the bit7z's functions (e.g., by BitArchiveItem),
+ * and that handlers may return even if they don't list them among the supported ones
+ * (e.g., because 7-zip queries them explicitly).
+ */
+constexpr std::array< BitProperty, 10 > kCommonItemProperties = { { BitProperty::Path,
+                                                                    BitProperty::IsDir,
+                                                                    BitProperty::Size,
+                                                                    BitProperty::PackSize,
+                                                                    BitProperty::Attrib,
+                                                                    BitProperty::CTime,
+                                                                    BitProperty::ATime,
+                                                                    BitProperty::MTime,
+                                                                    BitProperty::Encrypted,
+                                                                    BitProperty::CRC } };
+
+}  // namespace bit7z
+
+#endif //ITEMPROPERTIES_HPP
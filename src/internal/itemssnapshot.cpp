@@ -0,0 +1,269 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/itemssnapshot.hpp"
+
+#include "internal/itemproperties.hpp"
+
+using namespace bit7z;
+
+constexpr uint16_t kHasPath = 1u << 0u;
+constexpr uint16_t kHasIsDir = 1u << 1u;
+constexpr uint16_t kHasSize = 1u << 2u;
+constexpr uint16_t kHasPackSize = 1u << 3u;
+constexpr uint16_t kHasAttrib = 1u << 4u;
+constexpr uint16_t kHasCTime = 1u << 5u;
+constexpr uint16_t kHasATime = 1u << 6u;
+constexpr uint16_t kHasMTime = 1u << 7u;
+constexpr uint16_t kHasEncrypted = 1u << 8u;
+constexpr uint16_t kHasCRC = 1u << 9u;
+constexpr uint16_t kIsDirValue = 1u << 10u;
+constexpr uint16_t kIsEncryptedValue = 1u << 11u;
+constexpr uint16_t kHasOtherValues = 1u << 12u;
+
+inline uint16_t propertyFlag( BitProperty property ) noexcept {
+    switch ( property ) {
+        case BitProperty::Path:
+            return kHasPath;
+        case BitProperty::IsDir:
+            return kHasIsDir;
+        case BitProperty::Size:
+            return kHasSize;
+        case BitProperty::PackSize:
+            return kHasPackSize;
+        case BitProperty::Attrib:
+            return kHasAttrib;
+        case BitProperty::CTime:
+            return kHasCTime;
+        case BitProperty::ATime:
+            return kHasATime;
+        case BitProperty::MTime:
+            return kHasMTime;
+        case BitProperty::Encrypted:
+            return kHasEncrypted;
+        case BitProperty::CRC:
+            return kHasCRC;
+        default:
+            return 0;
+    }
+}
+
+ItemsSnapshot::ItemsSnapshot( const BitInputArchive& archive )
+    : ItemsSnapshot( archive.itemsCount(), [ &archive ]( uint32_t index, BitProperty property ) {
+          return archive.itemProperty( index, property );
+      } ) {}
+
+ItemsSnapshot::ItemsSnapshot( uint32_t items_count, const PropertyGetter& get_property ) {
+    mPathsOffsets.reserve( static_cast< size_t >( items_count ) + 1 );
+    mPathsOffsets.push_back( 0 );
+    mSizes.resize( items_count );
+    mPackSizes.resize( items_count );
+    mCrcs.resize( items_count );
+    mAttributes.resize( items_count );
+    mCreationTimes.resize( items_count );
+    mAccessTimes.resize( items_count );
+    mWriteTimes.resize( items_count );
+    mFlags.resize( items_count );
+
+    for ( uint32_t index = 0; index < items_count; ++index ) {
+        for ( auto property : kCommonItemProperties ) {
+            const BitPropVariant value = get_property( index, property );
+            if ( value.isEmpty() ) {
+                continue;
+            }
+            if ( !storeProperty( index, property, value ) ) {
+                mOtherValues.emplace( std::make_pair( index, property ), value );
+                mFlags[ index ] |= kHasOtherValues;
+            }
+        }
+        mPathsOffsets.push_back( mPathsArena.size() );
+    }
+}
+
+bool ItemsSnapshot::covers( BitProperty property ) noexcept {
+    return propertyFlag( property ) != 0;
+}
+
+uint32_t ItemsSnapshot::itemsCount() const noexcept {
+    return static_cast< uint32_t >( mFlags.size() );
+}
+
+BitPropVariant ItemsSnapshot::itemProperty( uint32_t index, BitProperty property ) const {
+    if ( !hasFlag( index, propertyFlag( property ) ) ) {
+        if ( hasFlag( index, kHasOtherValues ) ) {
+            auto res = mOtherValues.find( std::make_pair( index, property ) );
+            if ( res != mOtherValues.end() ) {
+                return res->second;
+            }
+        }
+        return BitPropVariant{};
+    }
+
+    switch ( property ) {
+        case BitProperty::Path: {
+            const size_t path_offset = mPathsOffsets[ index ];
+            return BitPropVariant{ mPathsArena.substr( path_offset, mPathsOffsets[ index + 1 ] - path_offset ) };
+        }
+        case BitProperty::IsDir:
+            return BitPropVariant{ hasFlag( index, kIsDirValue ) };
+        case BitProperty::Size:
+            return BitPropVariant{ mSizes[ index ] };
+        case BitProperty::PackSize:
+            return BitPropVariant{ mPackSizes[ index ] };
+        case BitProperty::Attrib:
+            return BitPropVariant{ mAttributes[ index ] };
+        case BitProperty::CTime:
+            return BitPropVariant{ mCreationTimes[ index ] };
+        case BitProperty::ATime:
+            return BitPropVariant{ mAccessTimes[ index ] };
+        case BitProperty::MTime:
+            return BitPropVariant{ mWriteTimes[ index ] };
+        case BitProperty::Encrypted:
+            return BitPropVariant{ hasFlag( index, kIsEncryptedValue ) };
+        case BitProperty::CRC:
+            return BitPropVariant{ mCrcs[ index ] };
+        default:
+            return BitPropVariant{};
+    }
+}
+
+bool ItemsSnapshot::isDir( uint32_t index ) const {
+    if ( hasFlag( index, kHasIsDir ) ) {
+        return hasFlag( index, kIsDirValue );
+    }
+    const BitPropVariant is_dir = itemProperty( index, BitProperty::IsDir );
+    return !is_dir.isEmpty() && is_dir.getBool();
+}
+
+bool ItemsSnapshot::isEncrypted( uint32_t index ) const {
+    // Note: non-boolean values are not stored in the columns, and BitArchiveItem treats them as "not encrypted".
+    return hasFlag( index, kHasEncrypted ) && hasFlag( index, kIsEncryptedValue );
+}
+
+uint64_t ItemsSnapshot::size( uint32_t index ) const {
+    if ( hasFlag( index, kHasSize ) ) {
+        return mSizes[ index ];
+    }
+    const BitPropVariant size = itemProperty( index, BitProperty::Size );
+    return size.isEmpty() ? 0 : size.getUInt64();
+}
+
+uint64_t ItemsSnapshot::packSize( uint32_t index ) const {
+    if ( hasFlag( index, kHasPackSize ) ) {
+        return mPackSizes[ index ];
+    }
+    const BitPropVariant pack_size = itemProperty( index, BitProperty::PackSize );
+    return pack_size.isEmpty() ? 0 : pack_size.getUInt64();
+}
+
+uint32_t ItemsSnapshot::foldersCount() const {
+    uint32_t result = 0;
+    for ( uint32_t index = 0; index < itemsCount(); ++index ) {
+        result += isDir( index ) ? 1 : 0;
+    }
+    return result;
+}
+
+uint64_t ItemsSnapshot::totalSize() const {
+    uint64_t result = 0;
+    for ( uint32_t index = 0; index < itemsCount(); ++index ) {
+        result += isDir( index ) ? 0 : size( index );
+    }
+    return result;
+}
+
+uint64_t ItemsSnapshot::totalPackSize() const {
+    uint64_t result = 0;
+    for ( uint32_t index = 0; index < itemsCount(); ++index ) {
+        result += isDir( index ) ? 0 : packSize( index );
+    }
+    return result;
+}
+
+bool ItemsSnapshot::hasEncryptedItems() const {
+    for ( uint32_t index = 0; index < itemsCount(); ++index ) {
+        if ( !isDir( index ) && isEncrypted( index ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ItemsSnapshot::hasFlag( uint32_t index, uint16_t flag ) const noexcept {
+    return ( mFlags[ index ] & flag ) != 0;
+}
+
+bool ItemsSnapshot::storeProperty( uint32_t index, BitProperty property, const BitPropVariant& value ) {
+    // Note: we store in the columns only the values having the type used by 7-zip for the given property.
+    switch ( property ) {
+        case BitProperty::Path:
+            if ( !value.isString() ) {
+                return false;
+            }
+            if ( value.bstrVal != nullptr ) {
+                mPathsArena.append( value.bstrVal, SysStringLen( value.bstrVal ) );
+            }
+            break;
+        case BitProperty::IsDir:
+            if ( !value.isBool() ) {
+                return false;
+            }
+            if ( value.getBool() ) {
+                mFlags[ index ] |= kIsDirValue;
+            }
+            break;
+        case BitProperty::Size:
+        case BitProperty::PackSize:
+            if ( value.vt != VT_UI8 ) {
+                return false;
+            }
+            ( property == BitProperty::Size ? mSizes : mPackSizes )[ index ] = value.getUInt64();
+            break;
+        case BitProperty::Attrib:
+        case BitProperty::CRC:
+            if ( value.vt != VT_UI4 ) {
+                return false;
+            }
+            ( property == BitProperty::Attrib ? mAttributes : mCrcs )[ index ] = value.getUInt32();
+            break;
+        case BitProperty::CTime:
+            if ( !value.isFileTime() ) {
+                return false;
+            }
+            mCreationTimes[ index ] = value.getFileTime();
+            break;
+        case BitProperty::ATime:
+            if ( !value.isFileTime() ) {
+                return false;
+            }
+            mAccessTimes[ index ] = value.getFileTime();
+            break;
+        case BitProperty::MTime:
+            if ( !value.isFileTime() ) {
+                return false;
+            }
+            mWriteTimes[ index ] = value.getFileTime();
+            break;
+        case BitProperty::Encrypted:
+            if ( !value.isBool() ) {
+                return false;
+            }
+            if ( value.getBool() ) {
+                mFlags[ index ] |= kIsEncryptedValue;
+            }
+            break;
+        default:
+            return false;
+    }
+    mFlags[ index ] |= propertyFlag( property );
+    return true;
+}
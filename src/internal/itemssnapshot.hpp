@@ -0,0 +1,99 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ITEMSSNAPSHOT_HPP
+#define ITEMSSNAPSHOT_HPP
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bitinputarchive.hpp"
+#include "bitpropvariant.hpp"
+#include "internal/windows.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief In-memory, columnar copy of the most commonly used metadata of all the items of an archive.
+ *
+ * Each property is stored in its own array (indexed by the item index), while the paths of all the items
+ * are stored contiguously in a single string arena.
+ * Property values having a type different from the one usually used by 7-zip's handlers are kept
+ * as they are in a separate map, so that the snapshot always returns the same values as the archive.
+ */
+class ItemsSnapshot final {
+    public:
+        using PropertyGetter = std::function< BitPropVariant( uint32_t, BitProperty ) >;
+
+        explicit ItemsSnapshot( const BitInputArchive& archive );
+
+        /**
+         * @brief Constructs a snapshot of the given number of items, whose properties are read using
+         * the given function.
+         */
+        ItemsSnapshot( uint32_t items_count, const PropertyGetter& get_property );
+
+        BIT7Z_NODISCARD static bool covers( BitProperty property ) noexcept;
+
+        BIT7Z_NODISCARD uint32_t itemsCount() const noexcept;
+
+        BIT7Z_NODISCARD BitPropVariant itemProperty( uint32_t index, BitProperty property ) const;
+
+        BIT7Z_NODISCARD bool isDir( uint32_t index ) const;
+
+        BIT7Z_NODISCARD bool isEncrypted( uint32_t index ) const;
+
+        BIT7Z_NODISCARD uint64_t size( uint32_t index ) const;
+
+        BIT7Z_NODISCARD uint64_t packSize( uint32_t index ) const;
+
+        /**
+         * @return the number of folder items.
+         */
+        BIT7Z_NODISCARD uint32_t foldersCount() const;
+
+        /**
+         * @return the total uncompressed size of the file items.
+         */
+        BIT7Z_NODISCARD uint64_t totalSize() const;
+
+        /**
+         * @return the total packed size of the file items.
+         */
+        BIT7Z_NODISCARD uint64_t totalPackSize() const;
+
+        /**
+         * @return true if and only if any file item is encrypted.
+         */
+        BIT7Z_NODISCARD bool hasEncryptedItems() const;
+
+    private:
+        std::wstring mPathsArena;
+        std::vector< size_t > mPathsOffsets; // itemsCount() + 1 offsets in mPathsArena.
+        std::vector< uint64_t > mSizes;
+        std::vector< uint64_t > mPackSizes;
+        std::vector< uint32_t > mCrcs;
+        std::vector< uint32_t > mAttributes;
+        std::vector< FILETIME > mCreationTimes;
+        std::vector< FILETIME > mAccessTimes;
+        std::vector< FILETIME > mWriteTimes;
+        std::vector< uint16_t > mFlags;
+        std::map< std::pair< uint32_t, BitProperty >, BitPropVariant > mOtherValues;
+
+        BIT7Z_NODISCARD bool hasFlag( uint32_t index, uint16_t flag ) const noexcept;
+
+        bool storeProperty( uint32_t index, BitProperty property, const BitPropVariant& value );
+};
+
+}  // namespace bit7z
+
+#endif //ITEMSSNAPSHOT_HPP
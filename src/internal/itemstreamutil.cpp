@@ -0,0 +1,58 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/itemstreamutil.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "bitexception.hpp"
+#include "internal/guids.hpp"
+
+CMyComPtr< IInStream > bit7z::getSeekableItemStream( IInArchive* in_archive, uint32_t index ) {
+    CMyComPtr< IInArchiveGetStream > get_stream;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if ( in_archive->QueryInterface( ::IID_IInArchiveGetStream, reinterpret_cast< void** >( &get_stream ) ) != S_OK ||
+         get_stream == nullptr ) {
+        return nullptr;
+    }
+
+    CMyComPtr< ISequentialInStream > sequential_stream;
+    if ( get_stream->GetStream( index, &sequential_stream ) != S_OK || sequential_stream == nullptr ) {
+        return nullptr;
+    }
+
+    // Note: some handlers provide only sequential (i.e., non-seekable) streams, which are not useful for random access.
+    CMyComPtr< IInStream > item_stream;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    sequential_stream->QueryInterface( ::IID_IInStream, reinterpret_cast< void** >( &item_stream ) );
+    return item_stream;
+}
+
+std::size_t bit7z::readStream( ISequentialInStream* in_stream, byte_t* buffer, std::size_t size ) {
+    std::size_t total_read = 0;
+    while ( total_read < size ) {
+        const auto chunk_size = static_cast< UInt32 >(
+            std::min< std::size_t >( size - total_read, std::numeric_limits< UInt32 >::max() )
+        );
+        UInt32 processed_size = 0;
+        const HRESULT res = in_stream->Read( buffer + total_read, chunk_size, &processed_size );
+        if ( res != S_OK ) {
+            throw BitException( "Could not read the item stream", make_hresult_code( res ) );
+        }
+        if ( processed_size == 0 ) { // End of the stream.
+            break;
+        }
+        total_read += processed_size;
+    }
+    return total_read;
+}
@@ -0,0 +1,38 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ITEMSTREAMUTIL_HPP
+#define ITEMSTREAMUTIL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bittypes.hpp"
+
+#include <7zip/Archive/IArchive.h>
+#include <Common/MyCom.h>
+
+namespace bit7z {
+
+/**
+ * @return the seekable stream provided by the archive handler for reading the given item (via IInArchiveGetStream),
+ * or nullptr if the handler cannot provide one.
+ */
+CMyComPtr< IInStream > getSeekableItemStream( IInArchive* in_archive, uint32_t index );
+
+/**
+ * @brief Reads from the given stream until the buffer is full or the end of the stream is reached.
+ *
+ * @return the number of bytes read.
+ */
+std::size_t readStream( ISequentialInStream* in_stream, byte_t* buffer, std::size_t size );
+
+}  // namespace bit7z
+
+#endif //ITEMSTREAMUTIL_HPP
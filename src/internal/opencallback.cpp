@@ -13,7 +13,7 @@
 #include "internal/opencallback.hpp"
 
 #include "bitexception.hpp"
-#include "internal/cfileinstream.hpp"
+#include "internal/cmappedinstream.hpp"
 #include "internal/util.hpp"
 
 using namespace bit7z;
@@ -93,7 +93,8 @@ STDMETHODIMP OpenCallback::GetStream( const wchar_t* name, IInStream** inStream
         }
 
         try {
-            auto inStreamTemp = bit7z::make_com< CFileInStream >( stream_path );
+            // Note: the other streams requested by the handlers are usually the next volumes of the archive.
+            auto inStreamTemp = openFileInStream( stream_path, MappedAccess::Sequential );
             *inStream = inStreamTemp.Detach();
         } catch ( const BitException& ex ) {
             return ex.nativeCode();
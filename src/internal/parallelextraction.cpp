@@ -0,0 +1,280 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/parallelextraction.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+using namespace bit7z;
+
+ExtractionCallbacks ExtractionCallbacks::fromHandler( const BitAbstractArchiveHandler& handler ) {
+    return { handler.totalCallback(),
+             handler.progressCallback(),
+             handler.ratioCallback(),
+             handler.fileCallback(),
+             handler.passwordCallback(),
+             handler.operationStatsCallback() };
+}
+
+ParallelExtractionState::ParallelExtractionState( const BitProgressMonitor& monitor,
+                                                  ExtractionCallbacks callbacks,
+                                                  size_t workers_count )
+    : mMonitor{ monitor },
+      mCallbacks{ std::move( callbacks ) },
+      mWorkersMonitors( workers_count ),
+      mReportedProgress( workers_count ),
+      mAborted{ false } {}
+
+const ExtractionCallbacks& ParallelExtractionState::callbacks() const noexcept {
+    return mCallbacks;
+}
+
+const BitProgressMonitor& ParallelExtractionState::workerMonitor( size_t worker_index ) const noexcept {
+    return mWorkersMonitors[ worker_index ];
+}
+
+void ParallelExtractionState::beginOperation( uint64_t items_count, uint64_t total_size ) const {
+    mMonitor.reset( items_count );
+    mMonitor.setTotalSize( total_size );
+    if ( mCallbacks.total ) {
+        mCallbacks.total( total_size );
+    }
+}
+
+void ParallelExtractionState::updateProgress() noexcept {
+    for ( size_t worker_index = 0; worker_index < mWorkersMonitors.size(); ++worker_index ) {
+        const BitProgressMonitor& worker_monitor = mWorkersMonitors[ worker_index ];
+        addProgress( worker_index, worker_monitor.processedSize(), worker_monitor.processedItems() );
+    }
+}
+
+void ParallelExtractionState::addProgress( size_t worker_index,
+                                           uint64_t processed_size,
+                                           uint64_t processed_items ) noexcept {
+    // Note: each worker updates only its own reported progress, and the workers' counters never decrease.
+    ReportedProgress& reported = mReportedProgress[ worker_index ];
+    processed_size = std::max( processed_size, reported.processedSize );
+    processed_items = std::max( processed_items, reported.processedItems );
+    mMonitor.addProcessed( processed_size - reported.processedSize, processed_items - reported.processedItems );
+    reported.processedSize = processed_size;
+    reported.processedItems = processed_items;
+}
+
+bool ParallelExtractionState::setCompleted( size_t worker_index, uint64_t processed_size, uint64_t processed_items ) {
+    if ( mAborted ) {
+        return false;
+    }
+    addProgress( worker_index, processed_size, processed_items );
+    mMonitor.setCurrentItem( mWorkersMonitors[ worker_index ].currentItem() );
+    if ( !mCallbacks.progress ) {
+        return true;
+    }
+
+    const std::lock_guard< std::mutex > lock( mMutex );
+    // Note: the total is read while holding the lock, so that the callback is never called with decreasing values.
+    if ( !mCallbacks.progress( mMonitor.processedSize() ) ) {
+        mAborted = true;
+    }
+    return !mAborted;
+}
+
+void ParallelExtractionState::setRatioInfo() {
+    // Note: the workers' monitors have already been updated with the ratio info.
+    uint64_t total_in_size = 0;
+    uint64_t total_out_size = 0;
+    for ( const auto& worker_monitor : mWorkersMonitors ) {
+        total_in_size += worker_monitor.inputSize();
+        total_out_size += worker_monitor.outputSize();
+    }
+    mMonitor.setRatioInfo( total_in_size, total_out_size );
+    if ( !mCallbacks.ratio ) {
+        return;
+    }
+
+    const std::lock_guard< std::mutex > lock( mMutex );
+    mCallbacks.ratio( total_in_size, total_out_size );
+}
+
+void ParallelExtractionState::notifyFile( const tstring& file_path ) {
+    if ( !mCallbacks.file ) {
+        return;
+    }
+
+    const std::lock_guard< std::mutex > lock( mMutex );
+    mCallbacks.file( file_path );
+}
+
+tstring ParallelExtractionState::password() {
+    if ( !mCallbacks.password ) {
+        return {};
+    }
+
+    const std::lock_guard< std::mutex > lock( mMutex );
+    return mCallbacks.password();
+}
+
+void ParallelExtractionState::addOperationStats( const BitOperationStats& stats ) noexcept {
+    mOperationStats.merge( stats );
+}
+
+void ParallelExtractionState::reportOperationStats() const {
+    if ( mCallbacks.operationStats ) {
+        mCallbacks.operationStats( mOperationStats.stats() );
+    }
+}
+
+void ParallelExtractionState::fail( std::exception_ptr error ) {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    if ( !mError ) { // Only the first error is kept, the following ones are usually caused by the abort.
+        mError = std::move( error );
+    }
+    mAborted = true;
+}
+
+bool ParallelExtractionState::failed() const noexcept {
+    return mAborted;
+}
+
+void ParallelExtractionState::rethrowError() const {
+    if ( mError ) {
+        std::rethrow_exception( mError );
+    }
+}
+
+ExtractionWorkerHandler::ExtractionWorkerHandler( const BitAbstractArchiveHandler& handler,
+                                                  const BitInFormat& format,
+                                                  ParallelExtractionState& state,
+                                                  size_t worker_index )
+    : BitAbstractArchiveHandler{ handler.library(), handler.password(), handler.overwriteMode() },
+      mFormat{ format } {
+    setRetainDirectories( handler.retainDirectories() );
+    setCancellationToken( handler.cancellationToken() );
+    setProgressMonitor( state.workerMonitor( worker_index ) );
+
+    /* Note: the progress and ratio callbacks are always set, since they are used also to update the original
+     *       progress monitor (and the progress callback to abort the other workers on errors). */
+    setProgressCallback( [ &state, worker_index ]( uint64_t completed ) -> bool {
+        // Note: the worker's monitor has already been updated with the completed size.
+        return state.setCompleted( worker_index, completed, state.workerMonitor( worker_index ).processedItems() );
+    } );
+    setRatioCallback( [ &state ]( uint64_t /*in_size*/, uint64_t /*out_size*/ ) {
+        state.setRatioInfo();
+    } );
+    const ExtractionCallbacks& callbacks = state.callbacks();
+    if ( callbacks.file ) {
+        setFileCallback( [ &state ]( const tstring& file_path ) {
+            state.notifyFile( file_path );
+        } );
+    }
+    if ( callbacks.operationStats ) {
+        setOperationStatsCallback( [ &state ]( const BitOperationStats& stats ) {
+            state.addOperationStats( stats );
+        } );
+    }
+    if ( callbacks.password ) {
+        setPasswordCallback( [ &state ]() -> tstring {
+            return state.password();
+        } );
+    }
+}
+
+const BitInFormat& ExtractionWorkerHandler::format() const noexcept {
+    return mFormat;
+}
+
+vector< vector< uint32_t > > bit7z::partitionBySize( const vector< uint32_t >& indices,
+                                                     const vector< uint64_t >& sizes,
+                                                     size_t groups_count ) {
+    groups_count = std::max< size_t >( std::min( groups_count, indices.size() ), 1 );
+
+    // Greedy balancing: the largest items go first, each one to the group with the smallest total size.
+    vector< size_t > order( indices.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::stable_sort( order.begin(), order.end(), [ &sizes ]( size_t first, size_t second ) {
+        return sizes[ first ] > sizes[ second ];
+    } );
+
+    vector< vector< uint32_t > > groups( groups_count );
+    vector< uint64_t > groups_sizes( groups_count, 0 );
+    for ( const auto position : order ) {
+        const auto lightest_group = static_cast< size_t >(
+            std::distance( groups_sizes.begin(), std::min_element( groups_sizes.begin(), groups_sizes.end() ) )
+        );
+        groups[ lightest_group ].push_back( indices[ position ] );
+        groups_sizes[ lightest_group ] += sizes[ position ];
+    }
+
+    for ( auto& group : groups ) {
+        std::sort( group.begin(), group.end() );
+    }
+    groups.erase( std::remove_if( groups.begin(), groups.end(), []( const vector< uint32_t >& group ) {
+        return group.empty();
+    } ), groups.end() );
+    return groups;
+}
+
+void bit7z::extractInParallel( const BitInputArchive& archive,
+                               const tstring& out_dir,
+                               const vector< vector< uint32_t > >& groups,
+                               const vector< uint32_t >& folders,
+                               uint64_t total_size ) {
+    const BitAbstractArchiveHandler& handler = archive.handler();
+    // Note: the folders, if any, are extracted by an additional worker.
+    ParallelExtractionState state{ handler.progressMonitor(),
+                                   ExtractionCallbacks::fromHandler( handler ),
+                                   groups.size() + ( folders.empty() ? 0 : 1 ) };
+    uint64_t items_count = folders.size();
+    for ( const auto& group : groups ) {
+        items_count += group.size();
+    }
+    state.beginOperation( items_count, total_size );
+    auto run_worker = [ & ]( size_t worker_index, const vector< uint32_t >& indices ) {
+        try {
+            const ExtractionWorkerHandler worker_handler{ handler, archive.detectedFormat(), state, worker_index };
+            // Note: archives embedded in a file are reopened at the same offset.
+            const auto worker_archive = archive.archiveOffset() == 0 ?
+                                        std::make_unique< BitInputArchive >( worker_handler, archive.archivePath() ) :
+                                        std::make_unique< BitInputArchive >( worker_handler,
+                                                                             archive.archivePath(),
+                                                                             archive.archiveOffset() );
+            worker_archive->extract( out_dir, indices );
+        } catch ( ... ) {
+            state.fail( std::current_exception() );
+        }
+    };
+
+    vector< std::thread > workers;
+    workers.reserve( groups.size() );
+    try {
+        for ( size_t worker_index = 1; worker_index < groups.size(); ++worker_index ) {
+            workers.emplace_back( run_worker, worker_index, std::cref( groups[ worker_index ] ) );
+        }
+    } catch ( const std::system_error& ) {
+        state.fail( std::current_exception() );
+    }
+    run_worker( 0, groups.front() ); // The first group is extracted by the calling thread.
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+
+    // The metadata of the folders is set only once no other worker is writing files into them.
+    if ( !folders.empty() && !state.failed() ) {
+        run_worker( groups.size(), folders );
+    }
+    state.updateProgress(); // The workers might have completed some items after their last progress update.
+    state.reportOperationStats();
+    state.rethrowError();
+}
@@ -0,0 +1,173 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef PARALLELEXTRACTION_HPP
+#define PARALLELEXTRACTION_HPP
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "bitabstractarchivehandler.hpp"
+#include "bitinputarchive.hpp"
+#include "internal/iostats.hpp"
+
+namespace bit7z {
+
+using std::vector;
+
+/**
+ * @brief The user callbacks of the original archive handler of a parallel extraction.
+ */
+struct ExtractionCallbacks {
+    TotalCallback total;
+    ProgressCallback progress;
+    RatioCallback ratio;
+    FileCallback file;
+    PasswordCallback password;
+    OperationStatsCallback operationStats;
+
+    static ExtractionCallbacks fromHandler( const BitAbstractArchiveHandler& handler );
+};
+
+/**
+ * @brief Merges the progress, ratio, file, and password notifications of the workers of a parallel
+ * extraction into the progress monitor and the callbacks of the original archive handler, and keeps track
+ * of the first error.
+ *
+ * Each worker updates its own progress monitor, whose increments are added (without locks) to the original
+ * progress monitor, so that its counters never decrease.
+ * The user callbacks, instead, are invoked while holding a lock, so they never run concurrently.
+ */
+class ParallelExtractionState final {
+    public:
+        ParallelExtractionState( const BitProgressMonitor& monitor,
+                                 ExtractionCallbacks callbacks,
+                                 size_t workers_count );
+
+        BIT7Z_NODISCARD const ExtractionCallbacks& callbacks() const noexcept;
+
+        BIT7Z_NODISCARD const BitProgressMonitor& workerMonitor( size_t worker_index ) const noexcept;
+
+        void beginOperation( uint64_t items_count, uint64_t total_size ) const;
+
+        /**
+         * @brief Adds the progress of the given worker to the original progress monitor, and notifies
+         *        the total processed size to the progress callback (if any).
+         *
+         * @param worker_index      the index of the worker.
+         * @param processed_size    the size processed so far by the worker.
+         * @param processed_items   the number of items completed so far by the worker.
+         *
+         * @return false if the extraction must be aborted, true otherwise.
+         */
+        bool setCompleted( size_t worker_index, uint64_t processed_size, uint64_t processed_items );
+
+        void setRatioInfo();
+
+        void notifyFile( const tstring& file_path );
+
+        BIT7Z_NODISCARD tstring password();
+
+        void addOperationStats( const BitOperationStats& stats ) noexcept;
+
+        /**
+         * @brief Calls the original operation stats callback (if any) with the sum of the workers' stats.
+         */
+        void reportOperationStats() const;
+
+        void fail( std::exception_ptr error );
+
+        /**
+         * @brief Adds the size and items processed by the workers since their last update
+         *        to the original progress monitor.
+         *
+         * @note It must be called only after all the workers have ended.
+         */
+        void updateProgress() noexcept;
+
+        /**
+         * @return true if a worker failed, or the extraction was aborted by the user.
+         */
+        BIT7Z_NODISCARD bool failed() const noexcept;
+
+        void rethrowError() const;
+
+    private:
+        struct ReportedProgress {
+            uint64_t processedSize = 0;
+            uint64_t processedItems = 0;
+        };
+
+        const BitProgressMonitor& mMonitor;
+        ExtractionCallbacks mCallbacks;
+        vector< BitProgressMonitor > mWorkersMonitors;
+        vector< ReportedProgress > mReportedProgress; // The progress of each worker already added to the total.
+        IOStatsCollector mOperationStats;
+
+        std::mutex mMutex;
+        std::atomic< bool > mAborted;
+        std::exception_ptr mError;
+
+        void addProgress( size_t worker_index, uint64_t processed_size, uint64_t processed_items ) noexcept;
+};
+
+/**
+ * @brief Archive handler used by a single worker of a parallel extraction: it has the same settings
+ * of the original handler, but its callbacks are routed through the shared ParallelExtractionState.
+ */
+class ExtractionWorkerHandler final : public BitAbstractArchiveHandler {
+    public:
+        ExtractionWorkerHandler( const BitAbstractArchiveHandler& handler,
+                                 const BitInFormat& format,
+                                 ParallelExtractionState& state,
+                                 size_t worker_index );
+
+        BIT7Z_NODISCARD const BitInFormat& format() const noexcept override;
+
+    private:
+        const BitInFormat& mFormat;
+};
+
+/**
+ * @brief Splits the given item indices into (at most) groups_count groups having similar total unpacked size.
+ *
+ * @param indices       the indices of the items to be split.
+ * @param sizes         the unpacked sizes of the items (sizes[i] is the size of the item indices[i]).
+ * @param groups_count  the maximum number of groups.
+ *
+ * @return the groups of indices, each sorted in ascending order (as required by IInArchive::Extract).
+ */
+vector< vector< uint32_t > > partitionBySize( const vector< uint32_t >& indices,
+                                              const vector< uint64_t >& sizes,
+                                              size_t groups_count );
+
+/**
+ * @brief Extracts the given groups of items of a file archive to the given directory, each group using
+ * a separate thread and a separate instance of the archive.
+ *
+ * The folders are extracted by a last worker, only after all the groups of files have been extracted,
+ * so that their metadata (e.g., the last write time) is not changed by the files being written into them.
+ *
+ * @param archive       the (file) archive to be extracted.
+ * @param out_dir       the output directory.
+ * @param groups        the groups of indices of the files, one for each worker.
+ * @param folders       the indices of the folders.
+ * @param total_size    the total unpacked size of the items to be extracted.
+ */
+void extractInParallel( const BitInputArchive& archive,
+                        const tstring& out_dir,
+                        const vector< vector< uint32_t > >& groups,
+                        const vector< uint32_t >& folders,
+                        uint64_t total_size );
+
+}  // namespace bit7z
+
+#endif //PARALLELEXTRACTION_HPP
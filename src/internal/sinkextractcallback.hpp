@@ -0,0 +1,50 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SINKEXTRACTCALLBACK_HPP
+#define SINKEXTRACTCALLBACK_HPP
+
+#include <exception>
+
+#include "internal/extractcallback.hpp"
+
+namespace bit7z {
+
+class SinkExtractCallback final : public ExtractCallback {
+    public:
+        SinkExtractCallback( const BitInputArchive& inputArchive, const SinkCallback& sink );
+
+        SinkExtractCallback( const SinkExtractCallback& ) = delete;
+
+        SinkExtractCallback( SinkExtractCallback&& ) = delete;
+
+        SinkExtractCallback& operator=( const SinkExtractCallback& ) = delete;
+
+        SinkExtractCallback& operator=( SinkExtractCallback&& ) = delete;
+
+        ~SinkExtractCallback() override = default;
+
+        /**
+         * @return the exception thrown by the sink callback, if any.
+         */
+        BIT7Z_NODISCARD const std::exception_ptr& sinkError() const noexcept;
+
+    private:
+        const SinkCallback& mSink;
+        std::exception_ptr mSinkError;
+        CMyComPtr< ISequentialOutStream > mSinkOutStream;
+
+        void releaseStream() override;
+
+        HRESULT getOutStream( uint32_t index, ISequentialOutStream** outStream ) override;
+};
+
+}  // namespace bit7z
+
+#endif // SINKEXTRACTCALLBACK_HPP
@@ -0,0 +1,118 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "internal/solidblockcache.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace bit7z;
+
+SolidBlockCache::SolidBlockCache( uint64_t max_memory ) : mMaxMemory{ max_memory }, mUsedMemory{ 0 } {}
+
+uint64_t SolidBlockCache::maxMemory() const noexcept {
+    return mMaxMemory;
+}
+
+uint64_t SolidBlockCache::usedMemory() const {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    return mUsedMemory;
+}
+
+bool SolidBlockCache::get( uint32_t index, vector< byte_t >& out_buffer ) {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    const vector< byte_t >* item = find( index );
+    if ( item == nullptr ) {
+        return false;
+    }
+    out_buffer = *item;
+    return true;
+}
+
+bool SolidBlockCache::get( uint32_t index, byte_t* buffer, std::size_t size ) {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    const vector< byte_t >* item = find( index );
+    if ( item == nullptr || item->size() != size ) {
+        return false;
+    }
+    std::copy( item->cbegin(), item->cend(), buffer );
+    return true;
+}
+
+void SolidBlockCache::insert( map< uint32_t, vector< byte_t > > block_items ) {
+    uint64_t block_size = 0;
+    for ( const auto& item : block_items ) {
+        block_size += item.second.size();
+    }
+    if ( block_size > mMaxMemory ) {
+        return;
+    }
+
+    const std::lock_guard< std::mutex > lock( mMutex );
+    for ( const auto& item : block_items ) {
+        // Items already cached (e.g., inserted concurrently by another thread) are moved to the new block,
+        // so that each item is stored only once.
+        removeItem( item.first );
+    }
+
+    while ( !mBlocks.empty() && mUsedMemory + block_size > mMaxMemory ) {
+        const auto evicted_block = std::prev( mBlocks.end() );
+        for ( const auto& item : evicted_block->items ) {
+            auto res = mItemsBlocks.find( item.first );
+            if ( res != mItemsBlocks.end() && res->second == evicted_block ) {
+                mItemsBlocks.erase( res );
+            }
+        }
+        mUsedMemory -= evicted_block->size;
+        mBlocks.erase( evicted_block );
+    }
+
+    mBlocks.push_front( CachedBlock{ std::move( block_items ), block_size } );
+    for ( const auto& item : mBlocks.front().items ) {
+        mItemsBlocks[ item.first ] = mBlocks.begin();
+    }
+    mUsedMemory += block_size;
+}
+
+bool SolidBlockCache::contains( uint32_t index ) const {
+    const std::lock_guard< std::mutex > lock( mMutex );
+    return mItemsBlocks.find( index ) != mItemsBlocks.end();
+}
+
+void SolidBlockCache::removeItem( uint32_t index ) {
+    auto res = mItemsBlocks.find( index );
+    if ( res == mItemsBlocks.end() ) {
+        return;
+    }
+    const auto block = res->second;
+    mItemsBlocks.erase( res );
+
+    auto item = block->items.find( index );
+    if ( item != block->items.end() ) {
+        block->size -= item->second.size();
+        mUsedMemory -= item->second.size();
+        block->items.erase( item );
+    }
+    if ( block->items.empty() ) {
+        mBlocks.erase( block );
+    }
+}
+
+const vector< byte_t >* SolidBlockCache::find( uint32_t index ) {
+    auto res = mItemsBlocks.find( index );
+    if ( res == mItemsBlocks.end() ) {
+        return nullptr;
+    }
+    // Marking the item's block as the most recently used.
+    mBlocks.splice( mBlocks.begin(), mBlocks, res->second );
+    return &res->second->items.at( index );
+}
@@ -0,0 +1,87 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SOLIDBLOCKCACHE_HPP
+#define SOLIDBLOCKCACHE_HPP
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "bitdefines.hpp"
+#include "bittypes.hpp"
+
+namespace bit7z {
+
+using std::vector;
+using std::map;
+
+/**
+ * @brief Bounded-memory LRU cache of the decoded contents of the items of solid blocks.
+ *
+ * Items are inserted and evicted one whole solid block at a time; all the methods are thread-safe.
+ */
+class SolidBlockCache final {
+    public:
+        explicit SolidBlockCache( uint64_t max_memory );
+
+        BIT7Z_NODISCARD uint64_t maxMemory() const noexcept;
+
+        BIT7Z_NODISCARD uint64_t usedMemory() const;
+
+        /**
+         * @brief Copies the cached content of the given item into the output buffer.
+         *
+         * @return true if and only if the item was in the cache.
+         */
+        bool get( uint32_t index, vector< byte_t >& out_buffer );
+
+        /**
+         * @brief Copies the cached content of the given item into the given fixed-size buffer.
+         *
+         * @return true if and only if the item was in the cache and its size is equal to the given one.
+         */
+        bool get( uint32_t index, byte_t* buffer, std::size_t size );
+
+        /**
+         * @brief Caches the contents of the items of a solid block, evicting the least recently used blocks
+         * if needed. Blocks larger than the maximum memory of the cache are ignored.
+         */
+        void insert( map< uint32_t, vector< byte_t > > block_items );
+
+        /**
+         * @return true if and only if the given item is in the cache.
+         */
+        BIT7Z_NODISCARD bool contains( uint32_t index ) const;
+
+    private:
+        struct CachedBlock {
+            map< uint32_t, vector< byte_t > > items;
+            uint64_t size;
+        };
+
+        using BlocksList = std::list< CachedBlock >;
+
+        uint64_t mMaxMemory;
+        uint64_t mUsedMemory;
+        BlocksList mBlocks; // Most recently used blocks first.
+        std::unordered_map< uint32_t, BlocksList::iterator > mItemsBlocks;
+        mutable std::mutex mMutex;
+
+        const vector< byte_t >* find( uint32_t index );
+
+        void removeItem( uint32_t index );
+};
+
+}  // namespace bit7z
+
+#endif //SOLIDBLOCKCACHE_HPP
@@ -0,0 +1,153 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef BIT7Z_ENABLE_TRACING
+
+#include "internal/tracing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+using namespace bit7z;
+
+constexpr size_t kThreadTraceCapacity = 16384;
+
+ThreadTraceBuffer::ThreadTraceBuffer( uint32_t thread_index, size_t capacity )
+    : mThreadIndex{ thread_index },
+      mSlots{ new Slot[capacity] },
+      mCapacity{ capacity },
+      mWriteIndex{ 0 },
+      mClearIndex{ 0 } {}
+
+void ThreadTraceBuffer::push( const char* name, uint64_t start, uint64_t duration ) noexcept {
+    const uint64_t write_index = mWriteIndex.load( std::memory_order_relaxed );
+    Slot& slot = mSlots[ write_index % mCapacity ];
+    slot.name.store( name, std::memory_order_relaxed );
+    slot.start.store( start, std::memory_order_relaxed );
+    slot.duration.store( duration, std::memory_order_relaxed );
+    mWriteIndex.store( write_index + 1, std::memory_order_release );
+}
+
+void ThreadTraceBuffer::collect( std::vector< TraceEvent >& events ) const {
+    const uint64_t end_index = mWriteIndex.load( std::memory_order_acquire );
+    const uint64_t oldest_index = end_index > mCapacity ? end_index - mCapacity : 0;
+    const uint64_t begin_index = std::max( oldest_index, mClearIndex.load( std::memory_order_relaxed ) );
+
+    const size_t first_event = events.size();
+    for ( uint64_t index = begin_index; index < end_index; ++index ) {
+        const Slot& slot = mSlots[ index % mCapacity ];
+        events.push_back( { slot.name.load( std::memory_order_relaxed ),
+                            slot.start.load( std::memory_order_relaxed ),
+                            slot.duration.load( std::memory_order_relaxed ),
+                            mThreadIndex } );
+    }
+
+    /* The owning thread might have overwritten some of the oldest slots while we were reading them:
+     * the slots up to the index current_end_index - mCapacity (included) might have been written. */
+    std::atomic_thread_fence( std::memory_order_acquire );
+    const uint64_t current_end_index = mWriteIndex.load( std::memory_order_relaxed );
+    if ( current_end_index + 1 > begin_index + mCapacity ) {
+        const auto overwritten = static_cast< size_t >(
+            std::min( current_end_index + 1 - mCapacity - begin_index, end_index - begin_index )
+        );
+        events.erase( events.begin() + static_cast< std::ptrdiff_t >( first_event ),
+                      events.begin() + static_cast< std::ptrdiff_t >( first_event + overwritten ) );
+    }
+}
+
+void ThreadTraceBuffer::clear() noexcept {
+    mClearIndex.store( mWriteIndex.load( std::memory_order_acquire ), std::memory_order_relaxed );
+}
+
+namespace {
+
+/**
+ * @brief The buffers of all the threads that recorded some event; the buffers are kept alive after
+ * the end of their threads, so that their events can still be exported.
+ */
+class TraceRegistry final {
+    public:
+        static TraceRegistry& instance() {
+            static TraceRegistry registry;
+            return registry;
+        }
+
+        std::shared_ptr< ThreadTraceBuffer > registerThread() {
+            const std::lock_guard< std::mutex > lock( mMutex );
+            auto buffer = std::make_shared< ThreadTraceBuffer >( static_cast< uint32_t >( mBuffers.size() + 1 ),
+                                                                 kThreadTraceCapacity );
+            mBuffers.push_back( buffer );
+            return buffer;
+        }
+
+        std::vector< TraceEvent > collect() {
+            std::vector< TraceEvent > events;
+            const std::lock_guard< std::mutex > lock( mMutex );
+            for ( const auto& buffer : mBuffers ) {
+                buffer->collect( events );
+            }
+            return events;
+        }
+
+        void clear() {
+            const std::lock_guard< std::mutex > lock( mMutex );
+            for ( const auto& buffer : mBuffers ) {
+                buffer->clear();
+            }
+        }
+
+    private:
+        std::mutex mMutex;
+        std::vector< std::shared_ptr< ThreadTraceBuffer > > mBuffers;
+};
+
+ThreadTraceBuffer* threadTraceBuffer() noexcept {
+    // Note: the registration (and its lock) happens only for the first event of each thread.
+    static thread_local std::shared_ptr< ThreadTraceBuffer > buffer = [] {
+        try {
+            return TraceRegistry::instance().registerThread();
+        } catch ( ... ) { // Tracing must never make the traced operation fail.
+            return std::shared_ptr< ThreadTraceBuffer >{};
+        }
+    }();
+    return buffer.get();
+}
+
+const std::chrono::steady_clock::time_point kTraceClockStart = std::chrono::steady_clock::now();
+
+} // namespace
+
+uint64_t bit7z::traceTimestamp() noexcept {
+    return static_cast< uint64_t >(
+        std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() -
+                                                                kTraceClockStart ).count()
+    );
+}
+
+void bit7z::recordTraceEvent( const char* name, uint64_t start ) noexcept {
+    const uint64_t end = traceTimestamp();
+    ThreadTraceBuffer* buffer = threadTraceBuffer();
+    if ( buffer != nullptr ) {
+        buffer->push( name, start, end - start );
+    }
+}
+
+std::vector< TraceEvent > bit7z::collectTraceEvents() {
+    return TraceRegistry::instance().collect();
+}
+
+void bit7z::clearTraceEvents() {
+    TraceRegistry::instance().clear();
+}
+
+#endif
@@ -0,0 +1,135 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+/* Scoped trace spans, enabled only when bit7z is compiled with the BIT7Z_ENABLE_TRACING option:
+ * when the option is off, the macros expand to nothing, so the instrumentation has no cost. */
+
+#ifdef BIT7Z_ENABLE_TRACING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bitdefines.hpp"
+
+namespace bit7z {
+
+/**
+ * @brief A completed trace span; the name must be a string literal (only its address is stored).
+ */
+struct TraceEvent {
+    const char* name;
+    uint64_t start; // Nanoseconds since the start of the tracing clock.
+    uint64_t duration; // Nanoseconds.
+    uint32_t threadIndex;
+};
+
+/**
+ * @brief Fixed-capacity ring buffer of the trace events of a single thread.
+ *
+ * Only the owning thread pushes events, while any thread can read them: the slots are relaxed atomics
+ * published through the (release) write index, and events overwritten during a read are discarded.
+ * When the buffer is full, the oldest events are overwritten.
+ */
+class ThreadTraceBuffer final {
+    public:
+        ThreadTraceBuffer( uint32_t thread_index, size_t capacity );
+
+        void push( const char* name, uint64_t start, uint64_t duration ) noexcept;
+
+        /**
+         * @brief Appends the events currently in the buffer (from the oldest to the newest) to the given vector.
+         */
+        void collect( std::vector< TraceEvent >& events ) const;
+
+        /**
+         * @brief Discards the events currently in the buffer.
+         */
+        void clear() noexcept;
+
+    private:
+        struct Slot {
+            std::atomic< const char* > name{ nullptr };
+            std::atomic< uint64_t > start{ 0 };
+            std::atomic< uint64_t > duration{ 0 };
+        };
+
+        uint32_t mThreadIndex;
+        std::unique_ptr< Slot[] > mSlots; // NOLINT(*-avoid-c-arrays)
+        size_t mCapacity;
+        std::atomic< uint64_t > mWriteIndex;
+        std::atomic< uint64_t > mClearIndex;
+};
+
+/**
+ * @return the current time of the tracing clock, in nanoseconds.
+ */
+uint64_t traceTimestamp() noexcept;
+
+/**
+ * @brief Records a span, started at the given timestamp and ending now, in the buffer of the calling thread.
+ */
+void recordTraceEvent( const char* name, uint64_t start ) noexcept;
+
+/**
+ * @return the events recorded so far by all the threads.
+ */
+std::vector< TraceEvent > collectTraceEvents();
+
+/**
+ * @brief Discards the events recorded so far by all the threads.
+ */
+void clearTraceEvents();
+
+/**
+ * @brief RAII span, recording the time from its construction to its destruction.
+ */
+class TraceSpan final {
+    public:
+        explicit TraceSpan( const char* name ) noexcept: mName{ name }, mStart{ traceTimestamp() } {}
+
+        TraceSpan( const TraceSpan& ) = delete;
+
+        TraceSpan( TraceSpan&& ) = delete;
+
+        TraceSpan& operator=( const TraceSpan& ) = delete;
+
+        TraceSpan& operator=( TraceSpan&& ) = delete;
+
+        ~TraceSpan() {
+            recordTraceEvent( mName, mStart );
+        }
+
+    private:
+        const char* mName;
+        uint64_t mStart;
+};
+
+}  // namespace bit7z
+
+#define BIT7Z_TRACE_CONCAT2( a, b ) a##b
+#define BIT7Z_TRACE_CONCAT( a, b ) BIT7Z_TRACE_CONCAT2( a, b )
+#define BIT7Z_TRACE_SCOPE( name ) const bit7z::TraceSpan BIT7Z_TRACE_CONCAT( trace_span_, __LINE__ ){ name }
+#define BIT7Z_TRACE_BEGIN( start_var ) start_var = bit7z::traceTimestamp()
+#define BIT7Z_TRACE_END( name, start_var ) bit7z::recordTraceEvent( name, start_var )
+
+#else
+
+#define BIT7Z_TRACE_SCOPE( name )
+#define BIT7Z_TRACE_BEGIN( start_var )
+#define BIT7Z_TRACE_END( name, start_var )
+
+#endif
+
+#endif //TRACING_HPP
@@ -13,6 +13,8 @@
 #include "internal/updatecallback.hpp"
 
 #include "internal/cfileoutstream.hpp"
+#include "internal/iostats.hpp"
+#include "internal/tracing.hpp"
 #include "internal/util.hpp"
 
 using namespace bit7z;
@@ -36,24 +38,25 @@ HRESULT UpdateCallback::Finalize() noexcept {
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP UpdateCallback::SetTotal( UInt64 size ) {
-    if ( mHandler.totalCallback() ) {
-        mHandler.totalCallback()( size );
-    }
+    notifyTotal( size );
     return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP UpdateCallback::SetCompleted( const UInt64* completeValue ) {
-    if ( completeValue != nullptr && mHandler.progressCallback() ) {
-        return mHandler.progressCallback()( *completeValue ) ? S_OK : E_ABORT;
+    if ( mHandler.cancellationToken().isCancelled() ) {
+        return E_ABORT;
+    }
+    if ( completeValue != nullptr ) {
+        return notifyProgress( *completeValue ) ? S_OK : E_ABORT;
     }
     return S_OK;
 }
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP UpdateCallback::SetRatioInfo( const UInt64* inSize, const UInt64* outSize ) {
-    if ( inSize != nullptr && outSize != nullptr && mHandler.ratioCallback() ) {
-        mHandler.ratioCallback()( *inSize, *outSize );
+    if ( inSize != nullptr && outSize != nullptr ) {
+        notifyRatio( *inSize, *outSize );
     }
     return S_OK;
 }
@@ -73,16 +76,27 @@ STDMETHODIMP UpdateCallback::GetProperty( UInt32 index, PROPID propID, PROPVARIA
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP UpdateCallback::GetStream( UInt32 index, ISequentialInStream** inStream ) {
+    BIT7Z_TRACE_SCOPE( "UpdateCallback::GetStream" );
     RINOK( Finalize() )
 
-    if ( mHandler.fileCallback() ) {
+    if ( mHandler.cancellationToken().isCancelled() ) {
+        return E_ABORT;
+    }
+    notifyCurrentItem( index );
+
+    const auto& file_callback = mHandler.fileCallback();
+    if ( file_callback ) {
         const BitPropVariant filePath = mOutputArchive.outputItemProperty( index, BitProperty::Path );
         if ( filePath.isString() ) {
-            mHandler.fileCallback()( filePath.getString() );
+            file_callback( filePath.getString() );
         }
     }
 
-    return mOutputArchive.outputItemStream( index, inStream );
+    const HRESULT result = mOutputArchive.outputItemStream( index, inStream );
+    if ( result == S_OK ) {
+        attachIOStats( *inStream, ioStatsCollector() );
+    }
+    return result;
 }
 
 COM_DECLSPEC_NOTHROW
@@ -129,6 +143,7 @@ STDMETHODIMP UpdateCallback::GetUpdateItemInfo( UInt32 index,
 
 COM_DECLSPEC_NOTHROW
 STDMETHODIMP UpdateCallback::SetOperationResult( Int32 /* operationResult */ ) noexcept {
+    notifyItemCompleted();
     mNeedBeClosed = true;
     return S_OK;
 }
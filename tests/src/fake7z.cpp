@@ -0,0 +1,573 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/* A minimal replacement of the 7-zip shared library, used by the tests that need an archive handler but not
+ * a real archive format (see fakearchive.hpp for the layout of the archives it reads). */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "internal/guids.hpp"
+#include "internal/macros.hpp"
+#include "internal/windows.hpp"
+
+#include <7zip/Archive/IArchive.h>
+#include <Common/MyCom.h>
+
+#include "fakearchive.hpp"
+
+#ifdef _WIN32
+#define FAKE7Z_EXPORT __declspec( dllexport )
+#else
+#define FAKE7Z_EXPORT __attribute__(( visibility( "default" ) ))
+#endif
+
+using namespace bit7z;
+using namespace bit7z::test::fake;
+
+namespace {
+struct ArchiveItem {
+    std::wstring path;
+    uint8_t flags = 0;
+    uint32_t block = kNoBlock;
+    uint64_t size = 0;
+    std::vector< byte_t > content;
+};
+
+struct ArchiveContent {
+    uint8_t flags = 0;
+    uint32_t chunkSize = 0;
+    std::vector< ArchiveItem > items;
+};
+
+// The number of calls to the Extract method of all the handlers (see GetExtractCallsCount()).
+std::atomic< uint32_t > extract_calls{ 0 };
+
+// The number of calls to the GetProperty method of all the handlers, for each property (see GetPropertyCallsCount()).
+std::mutex property_calls_mutex;
+std::map< PROPID, uint32_t > property_calls;
+
+// The properties listed by the handlers as supported.
+constexpr std::array< PROPID, 6 > kSupportedItemProperties = { { kpidPath,
+                                                                 kpidIsDir,
+                                                                 kpidSize,
+                                                                 kpidPackSize,
+                                                                 kpidBlock,
+                                                                 kHandlerSpecificProperty } };
+constexpr std::array< PROPID, 2 > kSupportedArchiveProperties = { { kpidSolid, kHandlerSpecificProperty } };
+
+template< std::size_t N >
+auto get_property_info( const std::array< PROPID, N >& properties, UInt32 index, BSTR* name,
+                        PROPID* propID, VARTYPE* varType ) -> HRESULT {
+    if ( index >= properties.size() ) {
+        return E_INVALIDARG;
+    }
+    *name = nullptr;
+    *propID = properties[ index ];
+    *varType = VT_EMPTY;
+    return S_OK;
+}
+
+auto read_all( ISequentialInStream* stream, std::vector< byte_t >& buffer ) -> HRESULT {
+    constexpr UInt32 kReadSize = 1024;
+    for ( ;; ) {
+        const auto old_size = buffer.size();
+        buffer.resize( old_size + kReadSize );
+        UInt32 processed_size = 0;
+        const HRESULT res = stream->Read( &buffer[ old_size ], kReadSize, &processed_size );
+        buffer.resize( old_size + processed_size );
+        if ( res != S_OK ) {
+            return res;
+        }
+        if ( processed_size == 0 ) {
+            return S_OK;
+        }
+    }
+}
+
+auto parse_archive( const std::vector< byte_t >& buffer, ArchiveContent& archive ) -> bool {
+    std::size_t position = 0;
+    auto read_bytes = [ & ]( std::size_t size ) -> const byte_t* {
+        if ( buffer.size() - position < size ) {
+            return nullptr;
+        }
+        const byte_t* result = buffer.data() + position;
+        position += size;
+        return result;
+    };
+    auto read_integer = [ & ]( auto& value ) -> bool {
+        using Integer = std::remove_reference_t< decltype( value ) >;
+        const byte_t* data = read_bytes( sizeof( Integer ) );
+        if ( data == nullptr ) {
+            return false;
+        }
+        value = read_le< Integer >( data );
+        return true;
+    };
+
+    const byte_t* magic = read_bytes( kMagicSize );
+    if ( magic == nullptr || !std::equal( magic, magic + kMagicSize, to_bytes( kMagic ).cbegin() ) ) {
+        return false;
+    }
+    uint32_t items_count = 0;
+    if ( !read_integer( archive.flags ) || !read_integer( archive.chunkSize ) || !read_integer( items_count ) ) {
+        return false;
+    }
+    archive.items.clear();
+    for ( uint32_t index = 0; index < items_count; ++index ) {
+        ArchiveItem item;
+        uint64_t content_size = 0;
+        uint16_t path_size = 0;
+        if ( !read_integer( item.flags ) || !read_integer( item.block ) || !read_integer( item.size ) ||
+             !read_integer( content_size ) || !read_integer( path_size ) ) {
+            return false;
+        }
+        const byte_t* path = read_bytes( path_size );
+        const byte_t* content = read_bytes( static_cast< std::size_t >( content_size ) );
+        if ( path == nullptr || content == nullptr ) {
+            return false;
+        }
+        for ( uint16_t i = 0; i < path_size; ++i ) {
+            item.path.push_back( static_cast< wchar_t >( path[ i ] ) );
+        }
+        item.content.assign( content, content + content_size );
+        archive.items.push_back( std::move( item ) );
+    }
+    return true;
+}
+
+// A seekable stream over the content of an item.
+class ItemInStream final : public IInStream, public CMyUnknownImp {
+    public:
+        explicit ItemInStream( std::vector< byte_t > content ) : mContent{ std::move( content ) }, mPosition{ 0 } {}
+
+        MY_UNKNOWN_DESTRUCTOR( ~ItemInStream() ) = default;
+
+        MY_UNKNOWN_IMP1( IInStream ) // NOLINT(modernize-use-noexcept)
+
+        BIT7Z_STDMETHOD_NOEXCEPT( Read, void* data, UInt32 size, UInt32* processedSize ) {
+            const auto remaining = mPosition < mContent.size() ? mContent.size() - mPosition : 0;
+            const auto read_size = static_cast< UInt32 >( std::min< uint64_t >( remaining, size ) );
+            std::copy_n( mContent.data() + mPosition, read_size, static_cast< byte_t* >( data ) );
+            mPosition += read_size;
+            if ( processedSize != nullptr ) {
+                *processedSize = read_size;
+            }
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( Seek, Int64 offset, UInt32 seekOrigin, UInt64* newPosition ) {
+            Int64 origin = 0;
+            switch ( seekOrigin ) {
+                case STREAM_SEEK_SET:
+                    break;
+                case STREAM_SEEK_CUR:
+                    origin = static_cast< Int64 >( mPosition );
+                    break;
+                case STREAM_SEEK_END:
+                    origin = static_cast< Int64 >( mContent.size() );
+                    break;
+                default:
+                    return STG_E_INVALIDFUNCTION;
+            }
+            if ( offset < -origin ) {
+                return HRESULT_WIN32_ERROR_NEGATIVE_SEEK;
+            }
+            mPosition = static_cast< uint64_t >( origin + offset );
+            if ( newPosition != nullptr ) {
+                *newPosition = mPosition;
+            }
+            return S_OK;
+        }
+
+    private:
+        std::vector< byte_t > mContent;
+        uint64_t mPosition;
+};
+
+auto write_all( ISequentialOutStream* stream, const std::vector< byte_t >& buffer ) -> HRESULT {
+    std::size_t written_size = 0;
+    while ( written_size < buffer.size() ) {
+        const auto size = static_cast< UInt32 >( std::min< std::size_t >( buffer.size() - written_size,
+                                                                          std::numeric_limits< UInt32 >::max() ) );
+        UInt32 processed_size = 0;
+        RINOK( stream->Write( buffer.data() + written_size, size, &processed_size ) )
+        if ( processed_size == 0 ) {
+            return E_FAIL;
+        }
+        written_size += processed_size;
+    }
+    return S_OK;
+}
+
+auto serialize_archive( const ArchiveContent& archive ) -> std::vector< byte_t > {
+    std::vector< Item > items;
+    items.reserve( archive.items.size() );
+    for ( const auto& archive_item : archive.items ) {
+        std::string path;
+        for ( const wchar_t character : archive_item.path ) {
+            path.push_back( static_cast< char >( character ) );
+        }
+        Item item{ std::move( path ), "" };
+        item.content = archive_item.content;
+        item.flags = archive_item.flags;
+        item.size = archive_item.size;
+        item.block = archive_item.block;
+        items.push_back( std::move( item ) );
+    }
+    return make_archive( items, archive.flags, archive.chunkSize );
+}
+
+class FakeInArchive final : public IInArchive,
+                            public IArchiveOpenSeq,
+                            public IInArchiveGetStream,
+                            public IOutArchive,
+                            public ISetProperties,
+                            public CMyUnknownImp {
+    public:
+        FakeInArchive() = default;
+
+        MY_UNKNOWN_DESTRUCTOR( ~FakeInArchive() ) = default;
+
+        // Note: the IInArchiveGetStream interface is provided only if the archive has seekable item streams.
+        STDMETHOD( QueryInterface )( REFIID iid, void** outObject ) noexcept override {
+            *outObject = nullptr;
+            if ( iid == IID_IUnknown || iid == IID_IInArchive ) {
+                *outObject = static_cast< IInArchive* >( this );
+            } else if ( iid == IID_IArchiveOpenSeq ) {
+                *outObject = static_cast< IArchiveOpenSeq* >( this );
+            } else if ( iid == IID_IInArchiveGetStream && ( mArchive.flags & kSeekableItemStreams ) != 0 ) {
+                *outObject = static_cast< IInArchiveGetStream* >( this );
+            } else if ( iid == IID_IOutArchive ) {
+                *outObject = static_cast< IOutArchive* >( this );
+            } else if ( iid == IID_ISetProperties ) {
+                *outObject = static_cast< ISetProperties* >( this );
+            } else {
+                return E_NOINTERFACE;
+            }
+            AddRef();
+            return S_OK;
+        }
+
+        STDMETHOD_( ULONG, AddRef )() noexcept override {
+            return ++__m_RefCount;
+        }
+
+        STDMETHOD_( ULONG, Release )() noexcept override {
+            if ( --__m_RefCount != 0 ) {
+                return __m_RefCount;
+            }
+            delete this;
+            return 0;
+        }
+
+        // IInArchive
+        BIT7Z_STDMETHOD_NOEXCEPT( Open, IInStream* stream, const UInt64* /*maxCheckStartPosition*/,
+                                  IArchiveOpenCallback* /*openCallback*/ ) {
+            std::vector< byte_t > buffer;
+            RINOK( stream->Seek( 0, STREAM_SEEK_SET, nullptr ) )
+            RINOK( read_all( stream, buffer ) )
+            return parse_archive( buffer, mArchive ) ? S_OK : S_FALSE;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( Close ) {
+            mArchive = ArchiveContent{};
+            mSeqStream.Release();
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetNumberOfItems, UInt32* numItems ) {
+            // Like the real handlers, the number of items is unknown until a forward-only stream is read.
+            *numItems = mSeqStream != nullptr ?
+                        static_cast< UInt32 >( -1 ) : static_cast< UInt32 >( mArchive.items.size() );
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetProperty, UInt32 index, PROPID propID, PROPVARIANT* value ) {
+            {
+                const std::lock_guard< std::mutex > lock{ property_calls_mutex };
+                ++property_calls[ propID ];
+            }
+            if ( index >= mArchive.items.size() ) {
+                return E_INVALIDARG;
+            }
+            const ArchiveItem& item = mArchive.items[ index ];
+            switch ( propID ) {
+                case kpidPath:
+                    value->vt = VT_BSTR;
+                    value->bstrVal = ::SysAllocString( item.path.c_str() );
+                    break;
+                case kpidIsDir:
+                    value->vt = VT_BOOL;
+                    value->boolVal = ( item.flags & kDirectory ) != 0 ? VARIANT_TRUE : VARIANT_FALSE;
+                    break;
+                case kpidSize:
+                    if ( ( item.flags & kUnknownSize ) == 0 ) {
+                        value->vt = VT_UI8;
+                        value->uhVal.QuadPart = item.size;
+                    }
+                    break;
+                case kpidPackSize:
+                    value->vt = VT_UI8;
+                    value->uhVal.QuadPart = item.content.size();
+                    break;
+                case kpidBlock:
+                    if ( item.block != kNoBlock ) {
+                        value->vt = VT_UI4;
+                        value->ulVal = item.block;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( Extract, const UInt32* indices, UInt32 numItems,
+                                  Int32 testMode, IArchiveExtractCallback* extractCallback ) {
+            ++extract_calls;
+            const bool all_items = numItems == std::numeric_limits< UInt32 >::max();
+            if ( mSeqStream != nullptr ) {
+                // The archive can be read only once, from the beginning to the end.
+                if ( !all_items ) {
+                    return E_NOTIMPL;
+                }
+                std::vector< byte_t > buffer;
+                RINOK( read_all( mSeqStream, buffer ) )
+                mSeqStream.Release();
+                if ( !parse_archive( buffer, mArchive ) ) {
+                    return S_FALSE;
+                }
+            }
+
+            std::vector< UInt32 > items_indices;
+            if ( all_items ) {
+                for ( UInt32 index = 0; index < mArchive.items.size(); ++index ) {
+                    items_indices.push_back( index );
+                }
+            } else {
+                items_indices.assign( indices, indices + numItems );
+            }
+
+            UInt64 total_size = 0;
+            for ( const auto index : items_indices ) {
+                if ( index >= mArchive.items.size() ) {
+                    return E_INVALIDARG;
+                }
+                total_size += mArchive.items[ index ].content.size();
+            }
+            RINOK( extractCallback->SetTotal( total_size ) )
+
+            UInt64 completed_size = 0;
+            for ( const auto index : items_indices ) {
+                const ArchiveItem& item = mArchive.items[ index ];
+                const Int32 ask_mode = testMode != 0 ? NArchive::NExtract::NAskMode::kTest
+                                                     : NArchive::NExtract::NAskMode::kExtract;
+                CMyComPtr< ISequentialOutStream > out_stream;
+                RINOK( extractCallback->GetStream( index, &out_stream, ask_mode ) )
+                if ( testMode == 0 && out_stream == nullptr ) {
+                    continue;
+                }
+                RINOK( extractCallback->PrepareOperation( ask_mode ) )
+                if ( out_stream != nullptr ) {
+                    RINOK( writeContent( item, out_stream, extractCallback, completed_size ) )
+                } else {
+                    completed_size += item.content.size();
+                    RINOK( extractCallback->SetCompleted( &completed_size ) )
+                }
+                out_stream.Release();
+                RINOK( extractCallback->SetOperationResult( NArchive::NExtract::NOperationResult::kOK ) )
+            }
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetArchiveProperty, PROPID propID, PROPVARIANT* value ) {
+            if ( propID == kpidSolid ) {
+                value->vt = VT_BOOL;
+                value->boolVal = ( mArchive.flags & kSolid ) != 0 ? VARIANT_TRUE : VARIANT_FALSE;
+            }
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetNumberOfProperties, UInt32* numProps ) {
+            if ( ( mArchive.flags & kNoPropertiesInfo ) != 0 ) {
+                return E_NOTIMPL;
+            }
+            *numProps = static_cast< UInt32 >( kSupportedItemProperties.size() );
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetPropertyInfo, UInt32 index, BSTR* name, PROPID* propID, VARTYPE* varType ) {
+            return get_property_info( kSupportedItemProperties, index, name, propID, varType );
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetNumberOfArchiveProperties, UInt32* numProps ) {
+            if ( ( mArchive.flags & kNoPropertiesInfo ) != 0 ) {
+                return E_NOTIMPL;
+            }
+            *numProps = static_cast< UInt32 >( kSupportedArchiveProperties.size() );
+            return S_OK;
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetArchivePropertyInfo, UInt32 index, BSTR* name,
+                                  PROPID* propID, VARTYPE* varType ) {
+            return get_property_info( kSupportedArchiveProperties, index, name, propID, varType );
+        }
+
+        // IArchiveOpenSeq
+        BIT7Z_STDMETHOD_NOEXCEPT( OpenSeq, ISequentialInStream* stream ) {
+            // Like the real handlers, the items are read only when extracting the archive.
+            mArchive = ArchiveContent{};
+            mSeqStream = stream;
+            return S_OK;
+        }
+
+        // IInArchiveGetStream
+        BIT7Z_STDMETHOD_NOEXCEPT( GetStream, UInt32 index, ISequentialInStream** stream ) {
+            *stream = nullptr;
+            if ( index >= mArchive.items.size() ) {
+                return E_INVALIDARG;
+            }
+            CMyComPtr< ISequentialInStream > item_stream = new ItemInStream( mArchive.items[ index ].content );
+            *stream = item_stream.Detach();
+            return S_OK;
+        }
+
+        // IOutArchive
+        BIT7Z_STDMETHOD_NOEXCEPT( UpdateItems, ISequentialOutStream* outStream, UInt32 numItems,
+                                  IArchiveUpdateCallback* updateCallback ) {
+            // The new archive keeps the flags of the updated one, and the items are written in the given order.
+            ArchiveContent new_archive;
+            new_archive.flags = mArchive.flags;
+            new_archive.chunkSize = mArchive.chunkSize;
+            for ( UInt32 index = 0; index < numItems; ++index ) {
+                Int32 new_data = 0;
+                Int32 new_properties = 0;
+                UInt32 index_in_archive = std::numeric_limits< UInt32 >::max();
+                RINOK( updateCallback->GetUpdateItemInfo( index, &new_data, &new_properties, &index_in_archive ) )
+
+                ArchiveItem item;
+                if ( index_in_archive < mArchive.items.size() ) {
+                    item = mArchive.items[ index_in_archive ];
+                } else if ( new_properties == 0 || new_data == 0 ) {
+                    return E_INVALIDARG;
+                }
+                if ( new_properties != 0 ) {
+                    RINOK( readNewProperties( updateCallback, index, item ) )
+                }
+                if ( new_data != 0 ) {
+                    item.content.clear();
+                    if ( ( item.flags & kDirectory ) == 0 ) {
+                        CMyComPtr< ISequentialInStream > in_stream;
+                        RINOK( updateCallback->GetStream( index, &in_stream ) )
+                        if ( in_stream != nullptr ) {
+                            RINOK( read_all( in_stream, item.content ) )
+                        }
+                    }
+                    item.size = item.content.size();
+                    item.flags &= static_cast< uint8_t >( ~kUnknownSize );
+                    item.block = kNoBlock;
+                    RINOK( updateCallback->SetOperationResult( NArchive::NUpdate::NOperationResult::kOK ) )
+                }
+                new_archive.items.push_back( std::move( item ) );
+            }
+            return write_all( outStream, serialize_archive( new_archive ) );
+        }
+
+        BIT7Z_STDMETHOD_NOEXCEPT( GetFileTimeType, UInt32* type ) {
+            *type = 0;
+            return S_OK;
+        }
+
+        // ISetProperties (the properties are ignored)
+        BIT7Z_STDMETHOD_NOEXCEPT( SetProperties, const wchar_t* const* /*names*/, const PROPVARIANT* /*values*/,
+                                  UInt32 /*numProps*/ ) {
+            return S_OK;
+        }
+
+    private:
+        ArchiveContent mArchive;
+        CMyComPtr< ISequentialInStream > mSeqStream;
+
+        static auto readNewProperties( IArchiveUpdateCallback* update_callback,
+                                       UInt32 index,
+                                       ArchiveItem& item ) -> HRESULT {
+            PROPVARIANT path{};
+            RINOK( update_callback->GetProperty( index, kpidPath, &path ) )
+            if ( path.vt == VT_BSTR ) {
+                item.path = path.bstrVal;
+                ::SysFreeString( path.bstrVal );
+            }
+
+            PROPVARIANT is_dir{};
+            RINOK( update_callback->GetProperty( index, kpidIsDir, &is_dir ) )
+            if ( is_dir.vt == VT_BOOL ) {
+                item.flags = is_dir.boolVal != VARIANT_FALSE ? static_cast< uint8_t >( item.flags | kDirectory )
+                                                             : static_cast< uint8_t >( item.flags & ~kDirectory );
+            }
+            return S_OK;
+        }
+
+        auto writeContent( const ArchiveItem& item,
+                           ISequentialOutStream* out_stream,
+                           IArchiveExtractCallback* extract_callback,
+                           UInt64& completed_size ) const -> HRESULT {
+            const auto content_size = item.content.size();
+            const std::size_t chunk_size = mArchive.chunkSize != 0 ? mArchive.chunkSize : content_size;
+            std::size_t written_size = 0;
+            while ( written_size < content_size ) {
+                const auto size = static_cast< UInt32 >( std::min( chunk_size, content_size - written_size ) );
+                UInt32 processed_size = 0;
+                RINOK( out_stream->Write( item.content.data() + written_size, size, &processed_size ) )
+                if ( processed_size == 0 ) {
+                    return E_FAIL;
+                }
+                written_size += processed_size;
+                completed_size += processed_size;
+                RINOK( extract_callback->SetCompleted( &completed_size ) )
+            }
+            return S_OK;
+        }
+};
+} // namespace
+
+extern "C" FAKE7Z_EXPORT HRESULT WINAPI CreateObject( const GUID* /*clsID*/, const GUID* interfaceID, void** out ) {
+    *out = nullptr;
+    if ( *interfaceID == IID_IInArchive ) {
+        CMyComPtr< IInArchive > in_archive = new FakeInArchive();
+        *out = in_archive.Detach();
+        return S_OK;
+    }
+    if ( *interfaceID == IID_IOutArchive ) {
+        CMyComPtr< IOutArchive > out_archive = new FakeInArchive();
+        *out = out_archive.Detach();
+        return S_OK;
+    }
+    return E_NOINTERFACE;
+}
+
+extern "C" FAKE7Z_EXPORT UInt32 WINAPI GetExtractCallsCount() {
+    return extract_calls.load();
+}
+
+extern "C" FAKE7Z_EXPORT UInt32 WINAPI GetPropertyCallsCount( PROPID propID ) {
+    const std::lock_guard< std::mutex > lock{ property_calls_mutex };
+    const auto calls = property_calls.find( propID );
+    return calls != property_calls.end() ? calls->second : 0;
+}
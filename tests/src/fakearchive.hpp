@@ -0,0 +1,141 @@
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FAKEARCHIVE_HPP
+#define FAKEARCHIVE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bit7z/bittypes.hpp>
+
+namespace bit7z { // NOLINT(modernize-concat-nested-namespaces)
+namespace test {
+namespace fake {
+
+/* The fake 7-zip library used by the tests (see fake7z.cpp) reads the archives having the following layout
+ * (all the integers are little-endian):
+ *
+ *   magic       "FAKE"
+ *   flags       uint8   (ArchiveFlags)
+ *   chunk size  uint32  (the maximum number of bytes written to the output streams at once, 0 means unlimited)
+ *   items count uint32
+ *   items:
+ *     flags         uint8   (ItemFlags)
+ *     block         uint32  (the value of the Block property, kNoBlock if the item is not in any block)
+ *     size          uint64  (the value of the Size property)
+ *     content size  uint64
+ *     path size     uint16
+ *     path          (ASCII)
+ *     content
+ *
+ * The archives can be opened with any format, and from forward-only streams too; they can also be created
+ * and updated (the updated archives keep the archive flags and chunk size of the original ones).
+ * The handlers list the Path, IsDir, Size, PackSize, and Block item properties, the Solid archive property,
+ * and a handler-specific item/archive property (kHandlerSpecificProperty) as supported.
+ * The library also counts the calls to the handlers' Extract and GetProperty methods
+ * (see fake_extract_calls() and fake_property_calls() in shared_lib.hpp). */
+
+constexpr char kMagic[] = "FAKE";
+constexpr std::size_t kMagicSize = sizeof( kMagic ) - 1;
+
+enum ArchiveFlags : uint8_t {
+    kSeekableItemStreams = 1, // The handler provides seekable streams for the items (IInArchiveGetStream).
+    kSolid = 2, // The archive has the Solid property set to true.
+    kNoPropertiesInfo = 4 // The handler cannot tell which properties it supports.
+};
+
+enum ItemFlags : uint8_t {
+    kDirectory = 1,
+    kUnknownSize = 2 // The item has no Size property.
+};
+
+constexpr uint32_t kNoBlock = 0xFFFFFFFF;
+
+constexpr uint32_t kHandlerSpecificProperty = 0x10000; // kpidUserDefined, i.e., a property without a BitProperty value.
+
+inline auto to_bytes( const std::string& str ) -> std::vector< byte_t > {
+    std::vector< byte_t > result;
+    result.reserve( str.size() );
+    for ( const char character : str ) {
+        result.push_back( static_cast< byte_t >( character ) );
+    }
+    return result;
+}
+
+struct Item {
+    std::string path;
+    std::vector< byte_t > content;
+    uint8_t flags = 0;
+    uint64_t size = 0; // The Size property of the item.
+    uint32_t block = kNoBlock; // The Block property of the item.
+
+    Item( std::string item_path, const std::string& item_content )
+        : path{ std::move( item_path ) },
+          content{ to_bytes( item_content ) },
+          size{ content.size() } {}
+
+    Item( std::string item_path, const std::string& item_content, uint64_t size_property )
+        : path{ std::move( item_path ) },
+          content{ to_bytes( item_content ) },
+          size{ size_property } {}
+};
+
+inline auto directory( std::string path ) -> Item {
+    Item item{ std::move( path ), "" };
+    item.flags = kDirectory;
+    return item;
+}
+
+inline auto in_block( Item item, uint32_t block ) -> Item {
+    item.block = block;
+    return item;
+}
+
+template< typename T >
+inline void write_le( std::vector< byte_t >& buffer, T value ) {
+    for ( std::size_t i = 0; i < sizeof( T ); ++i ) {
+        buffer.push_back( static_cast< byte_t >( static_cast< uint64_t >( value ) >> ( 8 * i ) ) );
+    }
+}
+
+template< typename T >
+inline auto read_le( const byte_t* data ) -> T {
+    uint64_t value = 0;
+    for ( std::size_t i = 0; i < sizeof( T ); ++i ) {
+        value |= static_cast< uint64_t >( static_cast< uint8_t >( data[ i ] ) ) << ( 8 * i );
+    }
+    return static_cast< T >( value );
+}
+
+inline auto make_archive( const std::vector< Item >& items, uint8_t flags = 0, uint32_t chunk_size = 0 )
+    -> std::vector< byte_t > {
+    std::vector< byte_t > result = to_bytes( kMagic );
+    write_le< uint8_t >( result, flags );
+    write_le< uint32_t >( result, chunk_size );
+    write_le< uint32_t >( result, static_cast< uint32_t >( items.size() ) );
+    for ( const auto& item : items ) {
+        write_le< uint8_t >( result, item.flags );
+        write_le< uint32_t >( result, item.block );
+        write_le< uint64_t >( result, item.size );
+        write_le< uint64_t >( result, item.content.size() );
+        write_le< uint16_t >( result, static_cast< uint16_t >( item.path.size() ) );
+        const auto path = to_bytes( item.path );
+        result.insert( result.end(), path.cbegin(), path.cend() );
+        result.insert( result.end(), item.content.cbegin(), item.content.cend() );
+    }
+    return result;
+}
+
+} // namespace fake
+} // namespace test
+} // namespace bit7z
+
+#endif //FAKEARCHIVE_HPP
@@ -11,6 +11,11 @@
 #define SHARED_LIB_HPP
 
 #include <bit7z/bittypes.hpp>
+#include <bit7z/bitwindows.hpp>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
 
 #ifndef BIT7Z_USE_SYSTEM_7ZIP
 #include "filesystem.hpp"
@@ -36,6 +41,45 @@ inline auto sevenzip_lib_path() -> tstring {
     return lib_path;
 }
 
+// The fake 7-zip library built along with the tests (see fakearchive.hpp).
+inline auto fake_lib_path() -> tstring {
+#ifdef _WIN32
+    static const auto lib_path = ( filesystem::exe_path().parent_path() / "fake7z.dll" ).string< tchar >();
+#else
+    static const auto lib_path = ( filesystem::exe_path().parent_path() / "fake7z.so" ).string();
+#endif
+    return lib_path;
+}
+
+// Gets a function exported by the fake 7-zip library, which must be already loaded (e.g., by a Bit7zLibrary object).
+template< typename Function >
+inline auto fake_lib_function( const char* name ) -> Function {
+#ifdef _WIN32
+    HMODULE lib_handle = GetModuleHandleW( L"fake7z.dll" );
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast< Function >( GetProcAddress( lib_handle, name ) );
+#else
+    void* lib_handle = dlopen( fake_lib_path().c_str(), RTLD_LAZY | RTLD_NOLOAD );
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto function = reinterpret_cast< Function >( dlsym( lib_handle, name ) );
+    dlclose( lib_handle ); // The library stays loaded, since it is still referenced by the Bit7zLibrary object.
+    return function;
+#endif
+}
+
+// The number of calls to the Extract method of the archive handlers of the fake 7-zip library.
+inline auto fake_extract_calls() -> uint32_t {
+    using GetExtractCallsCountFunc = uint32_t ( WINAPI* )();
+    return fake_lib_function< GetExtractCallsCountFunc >( "GetExtractCallsCount" )();
+}
+
+// The number of calls to the GetProperty method of the archive handlers of the fake 7-zip library
+// for the given property.
+inline auto fake_property_calls( uint32_t property_id ) -> uint32_t {
+    using GetPropertyCallsCountFunc = uint32_t ( WINAPI* )( uint32_t );
+    return fake_lib_function< GetPropertyCallsCountFunc >( "GetPropertyCallsCount" )( property_id );
+}
+
 } // namespace test
 } // namespace bit7z
 
@@ -0,0 +1,121 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitProperty;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+namespace {
+auto property_calls( BitProperty property ) -> uint32_t {
+    return bit7z::test::fake_property_calls( static_cast< uint32_t >( property ) );
+}
+
+auto contains( const std::vector< BitProperty >& properties, BitProperty property ) -> bool {
+    return std::find( properties.cbegin(), properties.cend(), property ) != properties.cend();
+}
+} // namespace
+
+TEST_CASE( "BitArchiveReader: Reading only the properties supported by the format handler", "[bitarchivereader]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    const std::vector< fake::Item > items = { fake::in_block( { "first.txt", "first item" }, 0 ),
+                                              fake::directory( "folder" ),
+                                              { "folder/second.txt", "second item" } };
+
+    SECTION( "Properties listed by the handler" ) {
+        const BitArchiveReader reader{ lib, fake::make_archive( items ), BitFormat::SevenZip };
+
+        // The listed properties, plus the ones used by most of bit7z's functions, without handler-specific ones.
+        const auto& item_properties = reader.supportedItemProperties();
+        REQUIRE( std::is_sorted( item_properties.cbegin(), item_properties.cend() ) );
+        REQUIRE( contains( item_properties, BitProperty::Path ) );
+        REQUIRE( contains( item_properties, BitProperty::Block ) );
+        REQUIRE( contains( item_properties, BitProperty::CRC ) );
+        REQUIRE_FALSE( contains( item_properties, BitProperty::NoProperty ) );
+        REQUIRE_FALSE( contains( item_properties, BitProperty::Method ) );
+        REQUIRE_FALSE( contains( item_properties, BitProperty::Comment ) );
+        REQUIRE( item_properties.back() <= BitProperty::CopyLink );
+
+        const auto& archive_properties = reader.supportedArchiveProperties();
+        REQUIRE( contains( archive_properties, BitProperty::Solid ) );
+        REQUIRE( contains( archive_properties, BitProperty::PhySize ) );
+        REQUIRE_FALSE( contains( archive_properties, BitProperty::Comment ) );
+        REQUIRE( archive_properties.back() <= BitProperty::CopyLink );
+
+        const auto path_calls = property_calls( BitProperty::Path );
+        const auto block_calls = property_calls( BitProperty::Block );
+        const auto method_calls = property_calls( BitProperty::Method );
+        const auto handler_specific_calls = bit7z::test::fake_property_calls( fake::kHandlerSpecificProperty );
+
+        const auto archive_items = reader.items();
+        REQUIRE( archive_items.size() == 3 );
+        REQUIRE( archive_items[ 0 ].path() == BIT7Z_STRING( "first.txt" ) );
+        REQUIRE( archive_items[ 0 ].size() == 10 );
+        REQUIRE( archive_items[ 0 ].itemProperty( BitProperty::Block ).getUInt32() == 0 );
+        REQUIRE( archive_items[ 1 ].isDir() );
+        REQUIRE( archive_items[ 2 ].path() == BIT7Z_STRING( "folder/second.txt" ) );
+        REQUIRE( archive_items[ 2 ].itemProperty( BitProperty::Block ).isEmpty() );
+
+        // Only the supported properties are queried, once for each item.
+        REQUIRE( property_calls( BitProperty::Path ) == path_calls + 3 );
+        REQUIRE( property_calls( BitProperty::Block ) == block_calls + 3 );
+        REQUIRE( property_calls( BitProperty::Method ) == method_calls );
+        REQUIRE( bit7z::test::fake_property_calls( fake::kHandlerSpecificProperty ) == handler_specific_calls );
+    }
+
+    SECTION( "Masking the properties" ) {
+        const BitArchiveReader reader{ lib, fake::make_archive( items ), BitFormat::SevenZip };
+
+        const auto method_calls = property_calls( BitProperty::Method );
+        const auto archive_items = reader.items( { BitProperty::Path, BitProperty::Method, BitProperty::Block } );
+        REQUIRE( archive_items.size() == 3 );
+        const auto first_properties = archive_items[ 0 ].itemProperties();
+        REQUIRE( first_properties.size() == 2 );
+        REQUIRE( first_properties.count( BitProperty::Path ) == 1 );
+        REQUIRE( first_properties.count( BitProperty::Block ) == 1 );
+        REQUIRE( archive_items[ 1 ].itemProperties().size() == 1 );
+        REQUIRE( property_calls( BitProperty::Method ) == method_calls );
+    }
+
+    SECTION( "Handler not listing its properties" ) {
+        const BitArchiveReader reader{ lib, fake::make_archive( items, fake::kNoPropertiesInfo ), BitFormat::SevenZip };
+
+        // All the properties must be tried, except the handler-specific ones.
+        const auto& item_properties = reader.supportedItemProperties();
+        REQUIRE( item_properties.size() == static_cast< std::size_t >( BitProperty::CopyLink ) + 1 );
+        REQUIRE( item_properties.front() == BitProperty::NoProperty );
+        REQUIRE( item_properties.back() == BitProperty::CopyLink );
+        REQUIRE( reader.supportedArchiveProperties().size() == item_properties.size() );
+
+        const auto method_calls = property_calls( BitProperty::Method );
+        const auto handler_specific_calls = bit7z::test::fake_property_calls( fake::kHandlerSpecificProperty );
+        const auto archive_items = reader.items();
+        REQUIRE( archive_items.size() == 3 );
+        REQUIRE( archive_items[ 0 ].path() == BIT7Z_STRING( "first.txt" ) );
+        REQUIRE( archive_items[ 0 ].itemProperty( BitProperty::Block ).getUInt32() == 0 );
+        REQUIRE( property_calls( BitProperty::Method ) == method_calls + 3 );
+        REQUIRE( bit7z::test::fake_property_calls( fake::kHandlerSpecificProperty ) == handler_specific_calls );
+    }
+}
@@ -0,0 +1,60 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitasync.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using bit7z::BitExecutor;
+using bit7z::runAsync;
+
+TEST_CASE( "bitasync: Running tasks asynchronously", "[bitasync]" ) {
+    SECTION( "Default executor" ) {
+        bool executed = false;
+        auto result = runAsync( {}, [ &executed ]() {
+            executed = true;
+        } );
+        REQUIRE_NOTHROW( result.get() );
+        REQUIRE( executed );
+    }
+
+    SECTION( "Custom executor" ) {
+        std::vector< std::function< void() > > queue;
+        const BitExecutor executor = [ &queue ]( std::function< void() > task ) {
+            queue.push_back( std::move( task ) );
+        };
+
+        bool executed = false;
+        auto result = runAsync( executor, [ &executed ]() {
+            executed = true;
+        } );
+        REQUIRE( queue.size() == 1 );
+        REQUIRE_FALSE( executed );
+
+        queue.front()();
+        REQUIRE_NOTHROW( result.get() );
+        REQUIRE( executed );
+    }
+
+    SECTION( "Exceptions are propagated through the future" ) {
+        const BitExecutor executor = []( const std::function< void() >& task ) {
+            task();
+        };
+        auto result = runAsync( executor, []() {
+            throw std::runtime_error( "error" );
+        } );
+        REQUIRE_THROWS_AS( result.get(), std::runtime_error );
+    }
+}
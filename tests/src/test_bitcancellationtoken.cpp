@@ -0,0 +1,184 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitarchivewriter.hpp>
+#include <bit7z/bitcancellationtoken.hpp>
+#include <bit7z/biterror.hpp>
+#include <bit7z/bitexception.hpp>
+
+#include <internal/bufferextractcallback.hpp>
+#include <internal/updatecallback.hpp>
+#include <internal/util.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <map>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitArchiveWriter;
+using bit7z::BitCancellationToken;
+using bit7z::BitError;
+using bit7z::BitException;
+using bit7z::BufferExtractCallback;
+using bit7z::ExtractCallback;
+using bit7z::UpdateCallback;
+using bit7z::byte_t;
+using bit7z::tstring;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+namespace {
+template< typename Function >
+void requireCancelled( const Function& function ) {
+    try {
+        function();
+        FAIL( "The operation was not cancelled" );
+    } catch ( const BitException& ex ) {
+        REQUIRE( ex.code() == BitError::OperationCancelled );
+    }
+}
+} // namespace
+
+TEST_CASE( "BitCancellationToken: Copies share the cancellation state", "[bitcancellationtoken]" ) {
+    const BitCancellationToken token;
+    REQUIRE_FALSE( token.isCancelled() );
+
+    const BitCancellationToken copy = token; // NOLINT(performance-unnecessary-copy-initialization)
+    copy.cancel();
+    REQUIRE( copy.isCancelled() );
+    REQUIRE( token.isCancelled() );
+
+    const BitCancellationToken other;
+    REQUIRE_FALSE( other.isCancelled() );
+}
+
+TEST_CASE( "BitCancellationToken: Cancelling and resetting a token", "[bitcancellationtoken]" ) {
+    const BitCancellationToken token;
+    const BitCancellationToken token_copy = token; // NOLINT(performance-unnecessary-copy-initialization)
+    token_copy.cancel();
+    REQUIRE( token.isCancelled() );
+
+    // Resetting a token resets all its copies.
+    token.reset();
+    REQUIRE_FALSE( token.isCancelled() );
+    REQUIRE_FALSE( token_copy.isCancelled() );
+
+    token_copy.cancel();
+    REQUIRE( token.isCancelled() );
+}
+
+TEST_CASE( "BitCancellationToken: Cancelling an extraction", "[bitcancellationtoken][extractcallback]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    constexpr uint32_t chunk_size = 2;
+    const auto archive = fake::make_archive( { { "first.txt", "first item" }, { "second.txt", "second item" } },
+                                             0,
+                                             chunk_size );
+    BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+    const BitCancellationToken token;
+    reader.setCancellationToken( token );
+
+    SECTION( "ExtractCallback::SetCompleted" ) {
+        std::map< tstring, std::vector< byte_t > > buffers;
+        auto callback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( reader, buffers );
+        const UInt64 completed = 0;
+        REQUIRE( callback->SetCompleted( &completed ) == S_OK );
+        REQUIRE_FALSE( callback->errorException() );
+
+        token.cancel();
+        REQUIRE( callback->SetCompleted( &completed ) == E_ABORT );
+        REQUIRE( callback->errorException() );
+        requireCancelled( [ &callback ]() {
+            std::rethrow_exception( callback->errorException() );
+        } );
+    }
+
+    SECTION( "ExtractCallback::GetStream" ) {
+        std::map< tstring, std::vector< byte_t > > buffers;
+        auto callback = bit7z::make_com< BufferExtractCallback, ExtractCallback >( reader, buffers );
+        token.cancel();
+        CMyComPtr< ISequentialOutStream > out_stream;
+        REQUIRE( callback->GetStream( 0, &out_stream, NArchive::NExtract::NAskMode::kExtract ) != S_OK );
+        REQUIRE( out_stream == nullptr );
+        REQUIRE( callback->errorException() );
+        requireCancelled( [ &callback ]() {
+            std::rethrow_exception( callback->errorException() );
+        } );
+    }
+
+    SECTION( "Cancelling before the extraction" ) {
+        token.cancel();
+        std::vector< byte_t > buffer;
+        requireCancelled( [ & ]() {
+            reader.extract( buffer, 0 );
+        } );
+
+        // A cancelled token stays cancelled until it is reset.
+        requireCancelled( [ & ]() {
+            reader.extract( buffer, 1 );
+        } );
+
+        token.reset();
+        REQUIRE_NOTHROW( reader.extract( buffer, 1 ) );
+        REQUIRE( buffer == fake::to_bytes( "second item" ) );
+    }
+
+    SECTION( "Cancelling during the extraction" ) {
+        uint64_t notified_size = 0;
+        reader.setProgressCallback( [ & ]( uint64_t processed_size ) -> bool {
+            notified_size = processed_size;
+            token.cancel();
+            return true;
+        } );
+        std::vector< byte_t > buffer;
+        requireCancelled( [ & ]() {
+            reader.extract( buffer, 0 );
+        } );
+        REQUIRE( notified_size == chunk_size );
+    }
+}
+
+TEST_CASE( "BitCancellationToken: Cancelling a compression", "[bitcancellationtoken][updatecallback]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    BitArchiveWriter writer{ lib, BitFormat::SevenZip };
+    const std::vector< byte_t > content = fake::to_bytes( "content" );
+    writer.addFile( content, BIT7Z_STRING( "file.txt" ) );
+    const BitCancellationToken token;
+    writer.setCancellationToken( token );
+
+    UpdateCallback callback{ writer };
+    const UInt64 completed = 0;
+    REQUIRE( callback.SetCompleted( &completed ) == S_OK );
+    {
+        CMyComPtr< ISequentialInStream > in_stream;
+        REQUIRE( callback.GetStream( 0, &in_stream ) == S_OK );
+        REQUIRE( in_stream != nullptr );
+    }
+
+    token.cancel();
+    REQUIRE( callback.SetCompleted( &completed ) == E_ABORT );
+    {
+        CMyComPtr< ISequentialInStream > in_stream;
+        REQUIRE( callback.GetStream( 0, &in_stream ) == E_ABORT );
+        REQUIRE( in_stream == nullptr );
+    }
+
+    token.reset();
+    REQUIRE( callback.SetCompleted( &completed ) == S_OK );
+}
@@ -0,0 +1,354 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchiveeditor.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/biterror.hpp>
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bititemsarena.hpp>
+#include <internal/fs.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <array>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveEditor;
+using bit7z::BitArchiveReader;
+using bit7z::BitError;
+using bit7z::BitException;
+using bit7z::BitItemsArena;
+using bit7z::InputStreamMode;
+using bit7z::byte_t;
+using bit7z::tstring;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+namespace {
+template< typename Function >
+void requireNotSupported( const Function& function ) {
+    try {
+        function();
+        FAIL( "The operation did not throw" );
+    } catch ( const BitException& ex ) {
+        REQUIRE( ex.code() == BitError::FormatFeatureNotSupported );
+    }
+}
+
+auto read_file( const fs::path& path ) -> std::string {
+    fs::ifstream file{ path, std::ios::binary };
+    return std::string{ std::istreambuf_iterator< char >{ file }, std::istreambuf_iterator< char >{} };
+}
+} // namespace
+
+TEST_CASE( "BitInputArchive: Finding items by path", "[bitinputarchive][find]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    const auto archive = fake::make_archive( { { "first.txt", "old first" },
+                                               { "second.txt", "old second" },
+                                               { "first.txt", "duplicate of first" },
+                                               fake::directory( "folder" ),
+                                               { "folder/third.txt", "old third" } } );
+
+    SECTION( "Looking up the paths of an archive" ) {
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        auto item = reader.find( BIT7Z_STRING( "second.txt" ) );
+        REQUIRE( item != reader.cend() );
+        REQUIRE( item->index() == 1 );
+        REQUIRE( item->path() == BIT7Z_STRING( "second.txt" ) );
+        REQUIRE( reader.contains( BIT7Z_STRING( "second.txt" ) ) );
+
+        item = reader.find( BIT7Z_STRING( "folder/third.txt" ) );
+        REQUIRE( item != reader.cend() );
+        REQUIRE( item->index() == 4 );
+
+        item = reader.find( BIT7Z_STRING( "folder" ) );
+        REQUIRE( item != reader.cend() );
+        REQUIRE( item->isDir() );
+
+        // Duplicate paths resolve to the item with the lowest index.
+        item = reader.find( BIT7Z_STRING( "first.txt" ) );
+        REQUIRE( item != reader.cend() );
+        REQUIRE( item->index() == 0 );
+
+        REQUIRE( reader.find( BIT7Z_STRING( "third.txt" ) ) == reader.cend() );
+        REQUIRE( reader.find( BIT7Z_STRING( "folder/" ) ) == reader.cend() );
+        REQUIRE( reader.find( BIT7Z_STRING( "" ) ) == reader.cend() );
+        REQUIRE_FALSE( reader.contains( BIT7Z_STRING( "fourth.txt" ) ) );
+    }
+
+    SECTION( "Looking up the paths of an edited archive" ) {
+        const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_find";
+        fs::remove_all( test_dir );
+        fs::create_directories( test_dir );
+
+        const fs::path archive_path = test_dir / "archive.fake";
+        {
+            fs::ofstream archive_file{ archive_path, std::ios::binary };
+            archive_file.write( reinterpret_cast< const char* >( archive.data() ), // NOLINT(*-reinterpret-cast)
+                                static_cast< std::streamsize >( archive.size() ) );
+        }
+
+        BitArchiveEditor editor{ lib, archive_path.string< bit7z::tchar >(), BitFormat::SevenZip };
+        editor.renameItem( BIT7Z_STRING( "first.txt" ), BIT7Z_STRING( "renamed.txt" ) );
+        editor.applyChanges();
+
+        // The paths are looked up in the new archive, not in the index of the old one.
+        REQUIRE_NOTHROW( editor.renameItem( BIT7Z_STRING( "renamed.txt" ), BIT7Z_STRING( "zeroth.txt" ) ) );
+        REQUIRE_NOTHROW( editor.deleteItem( BIT7Z_STRING( "first.txt" ) ) );
+        editor.applyChanges();
+        REQUIRE_THROWS_AS( editor.deleteItem( BIT7Z_STRING( "renamed.txt" ) ), BitException );
+        REQUIRE_THROWS_AS( editor.deleteItem( BIT7Z_STRING( "first.txt" ) ), BitException );
+
+        const BitArchiveReader reader{ lib, archive_path.string< bit7z::tchar >(), BitFormat::SevenZip };
+        REQUIRE( reader.itemsCount() == 4 );
+        auto item = reader.find( BIT7Z_STRING( "zeroth.txt" ) );
+        REQUIRE( item != reader.cend() );
+        REQUIRE( item->index() == 0 );
+        std::vector< byte_t > content;
+        reader.extract( content, item->index() );
+        REQUIRE( content == fake::to_bytes( "old first" ) );
+        REQUIRE( reader.contains( BIT7Z_STRING( "second.txt" ) ) );
+        REQUIRE_FALSE( reader.contains( BIT7Z_STRING( "first.txt" ) ) );
+
+        fs::remove_all( test_dir );
+    }
+}
+
+TEST_CASE( "BitInputArchive: Reading an archive from a forward-only stream", "[bitinputarchive][forwardonly]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    const auto archive = fake::make_archive( { fake::directory( "folder" ),
+                                               { "folder/first.txt", "first item" },
+                                               { "second.txt", "second item" } } );
+    std::istringstream archive_stream{ std::string{ archive.cbegin(), archive.cend() } };
+    const BitArchiveReader reader{ lib, archive_stream, InputStreamMode::ForwardOnly, BitFormat::Tar };
+
+    SECTION( "Item-level operations are not supported" ) {
+        requireNotSupported( [ & ]() { static_cast< void >( reader.itemsCount() ); } );
+        requireNotSupported( [ & ]() { static_cast< void >( reader.items() ); } );
+        REQUIRE( reader.begin() == reader.end() );
+        REQUIRE( reader.cbegin() == reader.cend() );
+        REQUIRE( reader.find( BIT7Z_STRING( "second.txt" ) ) == reader.end() );
+        REQUIRE_FALSE( reader.contains( BIT7Z_STRING( "second.txt" ) ) );
+
+        std::vector< byte_t > buffer;
+        requireNotSupported( [ & ]() { reader.extract( buffer, 0 ); } );
+
+        std::ostringstream out_stream;
+        requireNotSupported( [ & ]() { reader.extract( out_stream, 0 ); } );
+
+        std::map< tstring, std::vector< byte_t > > buffers;
+        requireNotSupported( [ & ]() { reader.extract( buffers ); } );
+
+        BitItemsArena arena;
+        requireNotSupported( [ & ]() { reader.extract( arena ); } );
+
+        requireNotSupported( [ & ]() { reader.extract( BIT7Z_STRING( "." ), { 0 } ); } );
+    }
+
+    SECTION( "Testing the whole archive" ) {
+        REQUIRE_NOTHROW( reader.test() );
+    }
+
+    SECTION( "Extracting the whole archive" ) {
+        const fs::path out_dir = fs::temp_directory_path() / "bit7z_test_forwardonly";
+        fs::remove_all( out_dir );
+
+        REQUIRE_NOTHROW( reader.extract( out_dir.native() ) );
+        REQUIRE( fs::is_directory( out_dir / "folder" ) );
+        REQUIRE( read_file( out_dir / "folder" / "first.txt" ) == "first item" );
+        REQUIRE( read_file( out_dir / "second.txt" ) == "second item" );
+
+        fs::remove_all( out_dir );
+    }
+}
+
+TEST_CASE( "BitInputArchive: Extracting a range of bytes of an item", "[bitinputarchive][extractrange]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+
+    // Without seekable item streams, the range is extracted by decoding the item (in chunks of 4 bytes)
+    // and stopping the extraction as soon as the range is complete.
+    const auto flags = GENERATE( as< uint8_t >(), 0, fake::kSeekableItemStreams );
+    const bool is_direct = ( flags & fake::kSeekableItemStreams ) != 0;
+    DYNAMIC_SECTION( ( is_direct ? "Reading directly from the archive" : "Decoding the item" ) ) {
+        const auto archive = fake::make_archive( { { "first.txt", "first item" },
+                                                   fake::directory( "folder" ),
+                                                   { "folder/second.txt", "Hello, World!" } },
+                                                 flags,
+                                                 4 );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        std::vector< byte_t > buffer( 8, static_cast< byte_t >( '#' ) );
+
+        SECTION( "Range in the middle of the item" ) {
+            REQUIRE( reader.extractRange( 2, 7, 5, buffer.data() ) == 5 );
+            REQUIRE( buffer == fake::to_bytes( "World###" ) );
+        }
+
+        SECTION( "Range at the beginning of the item" ) {
+            REQUIRE( reader.extractRange( 2, 0, 5, buffer.data() ) == 5 );
+            REQUIRE( buffer == fake::to_bytes( "Hello###" ) );
+        }
+
+        SECTION( "Range ending exactly on the last byte of the item" ) {
+            REQUIRE( reader.extractRange( 2, 7, 6, buffer.data() ) == 6 );
+            REQUIRE( buffer == fake::to_bytes( "World!##" ) );
+        }
+
+        SECTION( "Range crossing the end of the item" ) {
+            REQUIRE( reader.extractRange( 2, 10, 8, buffer.data() ) == 3 );
+            REQUIRE( buffer == fake::to_bytes( "ld!#####" ) );
+        }
+
+        SECTION( "Range starting past the end of the item" ) {
+            REQUIRE( reader.extractRange( 2, 13, 8, buffer.data() ) == 0 );
+            REQUIRE( reader.extractRange( 2, 100, 8, buffer.data() ) == 0 );
+            REQUIRE( buffer == fake::to_bytes( "########" ) );
+        }
+
+        SECTION( "Empty range" ) {
+            REQUIRE( reader.extractRange( 2, 0, 0, buffer.data() ) == 0 );
+            REQUIRE( reader.extractRange( 2, 100, 0, buffer.data() ) == 0 );
+            REQUIRE( buffer == fake::to_bytes( "########" ) );
+        }
+
+        SECTION( "Range of the whole item" ) {
+            REQUIRE( reader.extractRange( 0, 0, 8, buffer.data() ) == 8 );
+            REQUIRE( buffer == fake::to_bytes( "first it" ) );
+        }
+
+        SECTION( "Range of an invalid item" ) {
+            try {
+                static_cast< void >( reader.extractRange( 3, 0, 5, buffer.data() ) );
+                FAIL( "A range of a non-existing item was extracted" );
+            } catch ( const BitException& ex ) {
+                REQUIRE( ex.code() == BitError::InvalidIndex );
+            }
+
+            try {
+                static_cast< void >( reader.extractRange( 1, 0, 5, buffer.data() ) );
+                FAIL( "A range of a folder was extracted" );
+            } catch ( const BitException& ex ) {
+                REQUIRE( ex.code() == BitError::ItemIsAFolder );
+            }
+            REQUIRE( buffer == fake::to_bytes( "########" ) );
+        }
+    }
+}
+
+namespace {
+auto unknown_size( fake::Item item ) -> fake::Item {
+    item.flags |= fake::kUnknownSize;
+    return item;
+}
+} // namespace
+
+TEST_CASE( "BitInputArchive: Caching the decoded items of solid blocks", "[bitinputarchive][solidblockcache]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    const std::vector< fake::Item > items = { fake::in_block( { "alpha.txt", "alpha" }, 0 ),
+                                              fake::directory( "folder" ),
+                                              fake::in_block( { "folder/bravo.txt", "bravo!" }, 0 ),
+                                              { "empty.txt", "" },
+                                              fake::in_block( { "charlie.txt", "charlie" }, 0 ),
+                                              fake::in_block( { "delta.txt", "delta" }, 1 ),
+                                              fake::in_block( { "echo.txt", "echo" }, 1 ),
+                                              unknown_size( fake::in_block( { "foxtrot.txt", "foxtrot" }, 2 ) ),
+                                              fake::in_block( { "golf.txt", "golf" }, 2 ) };
+
+    std::vector< byte_t > buffer;
+    auto extracted_item = [ & ]( BitArchiveReader& reader, uint32_t index ) -> std::string {
+        reader.extract( buffer, index );
+        return std::string{ buffer.cbegin(), buffer.cend() };
+    };
+
+    SECTION( "The other items of a cached block are not decoded again" ) {
+        BitArchiveReader reader{ lib, fake::make_archive( items, fake::kSolid ), BitFormat::SevenZip };
+        reader.setSolidBlockCacheSize( 1024 );
+
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        REQUIRE( extracted_item( reader, 2 ) == "bravo!" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 1 );
+
+        // The neighbours of the item in the same block are cached, skipping the items not in any block.
+        REQUIRE( extracted_item( reader, 0 ) == "alpha" );
+        std::array< byte_t, 7 > fixed_buffer{};
+        reader.extract( fixed_buffer, 4 );
+        REQUIRE( std::string{ fixed_buffer.cbegin(), fixed_buffer.cend() } == "charlie" );
+        REQUIRE( extracted_item( reader, 2 ) == "bravo!" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 1 );
+
+        // The items of another block are not cached yet.
+        REQUIRE( extracted_item( reader, 6 ) == "echo" );
+        REQUIRE( extracted_item( reader, 5 ) == "delta" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 2 );
+
+        // Items not in any block are extracted singly.
+        REQUIRE( extracted_item( reader, 3 ).empty() );
+        REQUIRE( extracted_item( reader, 3 ).empty() );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 4 );
+    }
+
+    SECTION( "Blocks larger than the cache are not cached" ) {
+        BitArchiveReader reader{ lib, fake::make_archive( items, fake::kSolid ), BitFormat::SevenZip };
+        reader.setSolidBlockCacheSize( 10 );
+
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        REQUIRE( extracted_item( reader, 2 ) == "bravo!" );
+        REQUIRE( extracted_item( reader, 0 ) == "alpha" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 2 );
+
+        // The second block fits in the cache.
+        REQUIRE( extracted_item( reader, 5 ) == "delta" );
+        REQUIRE( extracted_item( reader, 6 ) == "echo" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 3 );
+    }
+
+    SECTION( "Blocks having items of unknown size are not cached" ) {
+        BitArchiveReader reader{ lib, fake::make_archive( items, fake::kSolid ), BitFormat::SevenZip };
+        reader.setSolidBlockCacheSize( 1024 );
+
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        REQUIRE( extracted_item( reader, 8 ) == "golf" );
+        REQUIRE( extracted_item( reader, 7 ) == "foxtrot" );
+        REQUIRE( extracted_item( reader, 8 ) == "golf" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 3 );
+    }
+
+    SECTION( "The items of non-solid archives are not cached" ) {
+        BitArchiveReader reader{ lib, fake::make_archive( items ), BitFormat::SevenZip };
+        reader.setSolidBlockCacheSize( 1024 );
+
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        REQUIRE( extracted_item( reader, 0 ) == "alpha" );
+        REQUIRE( extracted_item( reader, 2 ) == "bravo!" );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 2 );
+    }
+
+    SECTION( "The cache is disabled by default" ) {
+        const BitArchiveReader reader{ lib, fake::make_archive( items, fake::kSolid ), BitFormat::SevenZip };
+
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        reader.extract( buffer, 0 );
+        reader.extract( buffer, 2 );
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 2 );
+    }
+}
@@ -0,0 +1,163 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/biterror.hpp>
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bititemsarena.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <string>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitArenaEntry;
+using bit7z::BitError;
+using bit7z::BitException;
+using bit7z::BitItemsArena;
+using bit7z::byte_t;
+using bit7z::tstring;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+namespace {
+auto entry_content( const BitItemsArena& arena, const BitArenaEntry& entry ) -> std::vector< byte_t > {
+    const byte_t* content = arena.content( entry );
+    return std::vector< byte_t >( content, content + entry.size );
+}
+} // namespace
+
+TEST_CASE( "BitItemsArena: Extracting the items of an archive into an arena", "[bititemsarena]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    constexpr uint32_t chunk_size = 3;
+
+    SECTION( "Sizing the arena from the Size property of the items" ) {
+        const auto archive = fake::make_archive( { { "first.txt", "first item" },
+                                                   fake::directory( "folder" ),
+                                                   { "folder/second.txt", "second item" },
+                                                   { "third.txt", "third" } },
+                                                 0,
+                                                 chunk_size );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        BitItemsArena arena;
+        reader.extract( arena );
+        REQUIRE( arena.data().size() == 26 );
+        REQUIRE( arena.data().capacity() == 26 );
+
+        const auto& entries = arena.entries();
+        REQUIRE( entries.size() == 3 );
+
+        REQUIRE( entries[ 0 ].index == 0 );
+        REQUIRE( entries[ 0 ].offset == 0 );
+        REQUIRE( entries[ 0 ].size == 10 );
+        REQUIRE( tstring{ arena.path( entries[ 0 ] ) } == BIT7Z_STRING( "first.txt" ) );
+        REQUIRE( entry_content( arena, entries[ 0 ] ) == fake::to_bytes( "first item" ) );
+
+        REQUIRE( entries[ 1 ].index == 2 );
+        REQUIRE( entries[ 1 ].offset == 10 );
+        REQUIRE( entries[ 1 ].size == 11 );
+        REQUIRE( entry_content( arena, entries[ 1 ] ) == fake::to_bytes( "second item" ) );
+
+        REQUIRE( entries[ 2 ].index == 3 );
+        REQUIRE( entries[ 2 ].offset == 21 );
+        REQUIRE( entries[ 2 ].size == 5 );
+        REQUIRE( tstring{ arena.path( entries[ 2 ] ) } == BIT7Z_STRING( "third.txt" ) );
+        REQUIRE( entry_content( arena, entries[ 2 ] ) == fake::to_bytes( "third" ) );
+
+        SECTION( "Extracting only some items, discarding the previous content" ) {
+            reader.extract( arena, { 3, 1, 0, 3 } );
+            REQUIRE( arena.entries().size() == 2 );
+            REQUIRE( arena.entries()[ 0 ].index == 0 );
+            REQUIRE( arena.entries()[ 1 ].index == 3 );
+            REQUIRE( arena.entries()[ 1 ].offset == 10 );
+            REQUIRE( arena.data().size() == 15 );
+        }
+
+        SECTION( "Extracting an invalid index" ) {
+            REQUIRE_THROWS_AS( reader.extract( arena, { 0, 4 } ), BitException );
+        }
+    }
+
+    SECTION( "Extracting empty items" ) {
+        const auto archive = fake::make_archive( { { "empty.txt", "" },
+                                                   { "first.txt", "first item" },
+                                                   { "other_empty.txt", "" } } );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        BitItemsArena arena;
+        reader.extract( arena );
+        REQUIRE( arena.data().size() == 10 );
+
+        const auto& entries = arena.entries();
+        REQUIRE( entries.size() == 3 );
+        REQUIRE( entries[ 0 ].offset == 0 );
+        REQUIRE( entries[ 0 ].size == 0 );
+        REQUIRE( tstring{ arena.path( entries[ 0 ] ) } == BIT7Z_STRING( "empty.txt" ) );
+        REQUIRE( entries[ 1 ].offset == 0 );
+        REQUIRE( entries[ 1 ].size == 10 );
+        REQUIRE( entries[ 2 ].offset == 10 );
+        REQUIRE( entries[ 2 ].size == 0 );
+        REQUIRE( tstring{ arena.path( entries[ 2 ] ) } == BIT7Z_STRING( "other_empty.txt" ) );
+    }
+
+    SECTION( "Extracting an item larger than its Size property" ) {
+        const auto archive = fake::make_archive( { { "first.txt", "first item" },
+                                                   { "larger.txt", "larger item", 6 } },
+                                                 0,
+                                                 chunk_size );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        BitItemsArena arena;
+        try {
+            reader.extract( arena );
+            FAIL( "The extraction did not fail" );
+        } catch ( const BitException& ex ) {
+            REQUIRE( ex.code() == BitError::InvalidOutputBufferSize );
+        }
+
+        // Only the chunks fitting the declared size have been appended to the arena.
+        REQUIRE( arena.data().size() == 16 );
+        REQUIRE( arena.data().capacity() == 16 );
+        REQUIRE( arena.entries().size() == 2 );
+        REQUIRE( arena.entries()[ 1 ].offset == 10 );
+        REQUIRE( arena.entries()[ 1 ].size == 6 );
+    }
+
+    SECTION( "Extracting an item smaller than its Size property" ) {
+        const auto archive = fake::make_archive( { { "smaller.txt", "smaller", 100 },
+                                                   { "second.txt", "second item" } },
+                                                 0,
+                                                 chunk_size );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        BitItemsArena arena;
+        reader.extract( arena );
+        REQUIRE( arena.data().size() == 18 );
+
+        const auto& entries = arena.entries();
+        REQUIRE( entries.size() == 2 );
+        REQUIRE( entries[ 0 ].offset == 0 );
+        REQUIRE( entries[ 0 ].size == 7 );
+        REQUIRE( entry_content( arena, entries[ 0 ] ) == fake::to_bytes( "smaller" ) );
+        REQUIRE( entries[ 1 ].offset == 7 );
+        REQUIRE( entries[ 1 ].size == 11 );
+        REQUIRE( entry_content( arena, entries[ 1 ] ) == fake::to_bytes( "second item" ) );
+    }
+}
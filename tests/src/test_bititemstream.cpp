@@ -0,0 +1,100 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/biterror.hpp>
+#include <bit7z/bitexception.hpp>
+#include <bit7z/bititemstream.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <ios>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitError;
+using bit7z::BitException;
+using bit7z::BitItemStream;
+using bit7z::byte_t;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+TEST_CASE( "BitItemStream: Reading an item of an archive", "[bititemstream]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+
+    // The fake handler provides seekable item streams only if the archive has the kSeekableItemStreams flag;
+    // otherwise, the item stream falls back to decoding the item in memory.
+    const auto flags = GENERATE( as< uint8_t >(), 0, fake::kSeekableItemStreams );
+    const bool is_direct = ( flags & fake::kSeekableItemStreams ) != 0;
+    DYNAMIC_SECTION( ( is_direct ? "Reading directly from the archive" : "Reading from the item decoded in memory" ) ) {
+        const auto archive = fake::make_archive( { { "first.txt", "first item" },
+                                                   fake::directory( "folder" ),
+                                                   { "folder/second.txt", "Hello, World!" } },
+                                                 flags );
+        const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+        const auto item_stream = reader.openItemStream( 2 );
+        REQUIRE( item_stream->isDirect() == is_direct );
+        REQUIRE( item_stream->size() == 13 );
+        REQUIRE( item_stream->position() == 0 );
+
+        std::vector< byte_t > buffer( 5 );
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 5 );
+        REQUIRE( buffer == fake::to_bytes( "Hello" ) );
+        REQUIRE( item_stream->position() == 5 );
+
+        REQUIRE( item_stream->seek( 2, std::ios_base::cur ) == 7 );
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 5 );
+        REQUIRE( buffer == fake::to_bytes( "World" ) );
+
+        REQUIRE( item_stream->seek( -6, std::ios_base::end ) == 7 );
+        REQUIRE( item_stream->position() == 7 );
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 5 );
+        REQUIRE( buffer == fake::to_bytes( "World" ) );
+
+        // Reading past the end of the item.
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 1 );
+        REQUIRE( buffer[ 0 ] == static_cast< byte_t >( '!' ) );
+        REQUIRE( item_stream->position() == 13 );
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 0 );
+
+        REQUIRE( item_stream->seek( 0 ) == 0 );
+        REQUIRE( item_stream->read( buffer.data(), buffer.size() ) == 5 );
+        REQUIRE( buffer == fake::to_bytes( "Hello" ) );
+
+        // Seeking before the beginning of the item.
+        REQUIRE_THROWS_AS( item_stream->seek( -1, std::ios_base::beg ), BitException );
+        REQUIRE( item_stream->position() == 5 );
+
+        SECTION( "Opening the stream of an invalid item" ) {
+            try {
+                static_cast< void >( reader.openItemStream( 3 ) );
+                FAIL( "The stream of a non-existing item was opened" );
+            } catch ( const BitException& ex ) {
+                REQUIRE( ex.code() == BitError::InvalidIndex );
+            }
+
+            try {
+                static_cast< void >( reader.openItemStream( 1 ) );
+                FAIL( "The stream of a folder was opened" );
+            } catch ( const BitException& ex ) {
+                REQUIRE( ex.code() == BitError::ItemIsAFolder );
+            }
+        }
+    }
+}
@@ -0,0 +1,99 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bititemsvector.hpp>
+#include <internal/genericinputitem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace bit7z;
+
+TEST_CASE( "BitItemsVector: Mixing indexed directories and other items", "[bititemsvector]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_bititemsvector";
+    fs::remove_all( test_dir );
+    fs::create_directories( test_dir / "folder" );
+    {
+        std::ofstream file{ test_dir / "folder" / "file.txt" };
+        file << "Hello, World!";
+    }
+
+    const std::vector< byte_t > buffer( 42, 0x2A );
+
+    BitItemsVector items;
+    items.indexBuffer( buffer, BIT7Z_STRING( "first.bin" ) );
+    items.indexDirectory( test_dir );
+    items.indexBuffer( buffer, BIT7Z_STRING( "last.bin" ) );
+
+    REQUIRE( items.size() == 5 );
+
+    REQUIRE( items.inArchivePath( 0 ) == fs::path{ "first.bin" } );
+    REQUIRE( items.itemSize( 0 ) == buffer.size() );
+
+    // The items found while indexing the directory keep their position among the other items.
+    const fs::path root_path = test_dir.filename();
+    REQUIRE( items.inArchivePath( 1 ) == root_path );
+    REQUIRE( items.itemProperty( 1, BitProperty::IsDir ) == BitPropVariant{ true } );
+
+    REQUIRE( items.inArchivePath( 2 ) == root_path / "folder" );
+    REQUIRE( items.itemProperty( 2, BitProperty::IsDir ) == BitPropVariant{ true } );
+    REQUIRE( items.itemPath( 2 ) == ( test_dir / "folder" ).string< tchar >() );
+
+    REQUIRE( items.inArchivePath( 3 ) == root_path / "folder" / "file.txt" );
+    REQUIRE( items.itemProperty( 3, BitProperty::IsDir ) == BitPropVariant{ false } );
+    REQUIRE( items.itemProperty( 3, BitProperty::Size ) == BitPropVariant{ static_cast< uint64_t >( 13 ) } );
+    REQUIRE( items.itemSize( 3 ) == 13 );
+
+    REQUIRE( items.inArchivePath( 4 ) == fs::path{ "last.bin" } );
+    REQUIRE( items.itemProperty( 4, BitProperty::Path ) == BitPropVariant{ std::wstring{ L"last.bin" } } );
+
+    SECTION( "Iterating over the items" ) {
+        std::vector< fs::path > in_archive_paths;
+        for ( const auto& item : items ) {
+            REQUIRE( item.inArchivePath() == items.inArchivePath( item.index() ) );
+            REQUIRE( item.path() == items.itemPath( item.index() ) );
+            REQUIRE( item.size() == items.itemSize( item.index() ) );
+            in_archive_paths.push_back( item.inArchivePath() );
+        }
+        REQUIRE( in_archive_paths.size() == items.size() );
+        REQUIRE( std::distance( items.cbegin(), items.cend() ) == 5 );
+
+        REQUIRE( items[ 2 ].isDir() );
+        REQUIRE( items[ 2 ].name() == BIT7Z_STRING( "folder" ) );
+        REQUIRE_FALSE( items[ 3 ].isDir() );
+        REQUIRE( items[ 3 ].name() == BIT7Z_STRING( "file.txt" ) );
+        REQUIRE( items[ 4 ].name() == BIT7Z_STRING( "last.bin" ) );
+    }
+
+    SECTION( "Copying the vector" ) {
+        BitItemsVector copy{ items };
+        copy.indexBuffer( buffer, BIT7Z_STRING( "copy.bin" ) );
+
+        REQUIRE( items.size() == 5 );
+        REQUIRE( copy.size() == 6 );
+        for ( const auto& item : items ) {
+            REQUIRE( copy[ item.index() ].inArchivePath() == item.inArchivePath() );
+            REQUIRE( copy[ item.index() ].itemProperty( BitProperty::IsDir ) == item.itemProperty( BitProperty::IsDir ) );
+        }
+        REQUIRE( copy.inArchivePath( 5 ) == fs::path{ "copy.bin" } );
+
+        copy = items;
+        REQUIRE( copy.size() == 5 );
+        REQUIRE( copy.inArchivePath( 3 ) == root_path / "folder" / "file.txt" );
+    }
+
+    fs::remove_all( test_dir );
+}
@@ -0,0 +1,111 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <bit7z/bitarchivewriter.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitArchiveWriter;
+using bit7z::UpdateMode;
+using bit7z::byte_t;
+using bit7z::tstring;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+namespace {
+auto archive_content( const Bit7zLibrary& lib, const std::vector< byte_t >& archive )
+    -> std::vector< std::pair< tstring, std::string > > {
+    const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+    std::vector< std::pair< tstring, std::string > > result;
+    for ( const auto& item : reader ) {
+        std::vector< byte_t > content;
+        if ( !item.isDir() ) {
+            reader.extract( content, item.index() );
+        }
+        result.emplace_back( item.path(), std::string{ content.cbegin(), content.cend() } );
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE( "BitOutputArchive: Updating the items of an archive", "[bitoutputarchive]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    const auto archive = fake::make_archive( { { "first.txt", "old first" },
+                                               { "second.txt", "old second" },
+                                               { "first.txt", "duplicate of first" },
+                                               fake::directory( "folder" ),
+                                               { "folder/third.txt", "old third" } } );
+    const auto new_first = fake::to_bytes( "new first" );
+    const auto new_fourth = fake::to_bytes( "new fourth" );
+
+    SECTION( "UpdateMode::Update replaces all the items having the same path as a new item" ) {
+        BitArchiveWriter writer{ lib, archive, BitFormat::SevenZip };
+        writer.setUpdateMode( UpdateMode::Update );
+        writer.addFile( new_first, BIT7Z_STRING( "first.txt" ) );
+        writer.addFile( new_fourth, BIT7Z_STRING( "fourth.txt" ) );
+
+        std::vector< byte_t > out_archive;
+        writer.compressTo( out_archive );
+
+        // The old items at the indices 0 and 2 are deleted, while the others are kept in their original order.
+        const std::vector< std::pair< tstring, std::string > > expected_content = {
+            { BIT7Z_STRING( "second.txt" ), "old second" },
+            { BIT7Z_STRING( "folder" ), "" },
+            { BIT7Z_STRING( "folder/third.txt" ), "old third" },
+            { BIT7Z_STRING( "first.txt" ), "new first" },
+            { BIT7Z_STRING( "fourth.txt" ), "new fourth" }
+        };
+        REQUIRE( archive_content( lib, out_archive ) == expected_content );
+    }
+
+    SECTION( "UpdateMode::Update without new items having the same path keeps all the old items" ) {
+        BitArchiveWriter writer{ lib, archive, BitFormat::SevenZip };
+        writer.setUpdateMode( UpdateMode::Update );
+        writer.addFile( new_fourth, BIT7Z_STRING( "fourth.txt" ) );
+
+        std::vector< byte_t > out_archive;
+        writer.compressTo( out_archive );
+
+        const auto content = archive_content( lib, out_archive );
+        REQUIRE( content.size() == 6 );
+        REQUIRE( content[ 0 ].second == "old first" );
+        REQUIRE( content[ 2 ].second == "duplicate of first" );
+        REQUIRE( content[ 5 ].second == "new fourth" );
+    }
+
+    SECTION( "UpdateMode::Append keeps the old items having the same path as a new item" ) {
+        BitArchiveWriter writer{ lib, archive, BitFormat::SevenZip };
+        writer.setUpdateMode( UpdateMode::Append );
+        writer.addFile( new_first, BIT7Z_STRING( "first.txt" ) );
+
+        std::vector< byte_t > out_archive;
+        writer.compressTo( out_archive );
+
+        const auto content = archive_content( lib, out_archive );
+        REQUIRE( content.size() == 6 );
+        REQUIRE( content[ 0 ] == std::make_pair( tstring{ BIT7Z_STRING( "first.txt" ) }, std::string{ "old first" } ) );
+        REQUIRE( content[ 2 ].second == "duplicate of first" );
+        REQUIRE( content[ 5 ] == std::make_pair( tstring{ BIT7Z_STRING( "first.txt" ) }, std::string{ "new first" } ) );
+    }
+}
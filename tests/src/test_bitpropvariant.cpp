@@ -21,6 +21,7 @@
 #endif
 
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <limits>
 #include <sstream>
@@ -0,0 +1,117 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/bufferpool.hpp>
+#include <internal/cfileinstream.hpp>
+#include <internal/cfileoutstream.hpp>
+
+#include <vector>
+
+using bit7z::BufferPool;
+using bit7z::BitBufferPoolStats;
+using bit7z::CFileInStream;
+using bit7z::CFileOutStream;
+
+// Note: the test data is bigger than the default buffers of file streams (e.g., 8 KiB in libstdc++),
+// but smaller than the pooled buffers used for streams of unknown size.
+constexpr std::size_t kTestDataSize = 64 * 1024;
+
+TEST_CASE( "BufferPool: Buffer size depends on the stream size", "[bufferpool]" ) {
+    REQUIRE( BufferPool::bufferSize( 0 ) == BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSize( 1 ) == BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSize( BufferPool::kMinBufferSize ) == BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSize( BufferPool::kMinBufferSize + 1 ) == 2 * BufferPool::kMinBufferSize );
+    REQUIRE( BufferPool::bufferSize( 100 * 1024 ) == 128 * 1024 );
+    REQUIRE( BufferPool::bufferSize( BufferPool::kMaxBufferSize ) == BufferPool::kMaxBufferSize );
+    REQUIRE( BufferPool::bufferSize( 1024 * BufferPool::kMaxBufferSize ) == BufferPool::kMaxBufferSize );
+    REQUIRE( BufferPool::bufferSize( bit7z::kUnknownStreamSize ) == BufferPool::kMaxBufferSize );
+}
+
+TEST_CASE( "BufferPool: Released buffers are reused", "[bufferpool]" ) {
+    auto& pool = BufferPool::instance();
+    pool.trim();
+    const BitBufferPoolStats initial_stats = pool.stats();
+    REQUIRE( initial_stats.cachedBytes == 0 );
+
+    const char* first_data = nullptr;
+    {
+        const auto buffer = pool.acquire( 10 );
+        REQUIRE( buffer.size() == BufferPool::kMinBufferSize );
+        REQUIRE( pool.stats().bytesInUse == initial_stats.bytesInUse + BufferPool::kMinBufferSize );
+        first_data = buffer.data();
+    }
+    REQUIRE( pool.stats().bytesInUse == initial_stats.bytesInUse );
+    REQUIRE( pool.stats().cachedBytes == BufferPool::kMinBufferSize );
+
+    const auto buffer = pool.acquire( 20 );
+    REQUIRE( buffer.data() == first_data );
+
+    const BitBufferPoolStats stats = pool.stats();
+    REQUIRE( stats.acquiredBuffers == initial_stats.acquiredBuffers + 2 );
+    REQUIRE( stats.reusedBuffers == initial_stats.reusedBuffers + 1 );
+    REQUIRE( stats.allocatedBytes == initial_stats.allocatedBytes + BufferPool::kMinBufferSize );
+    REQUIRE( stats.cachedBytes == 0 );
+}
+
+TEST_CASE( "BufferPool: File output streams write through the pooled buffers", "[bufferpool]" ) {
+    const fs::path test_file = fs::temp_directory_path() / "bit7z_test_bufferpool_out.bin";
+    fs::remove( test_file );
+
+    {
+        CFileOutStream out_stream{ test_file, true };
+
+        // Note: we use small writes since file streams might write big chunks of data directly to the file.
+        const std::vector< char > data( 256, 'a' );
+        for ( std::size_t written_size = 0; written_size < kTestDataSize; written_size += data.size() ) {
+            UInt32 processed_size = 0;
+            REQUIRE( out_stream.Write( data.data(), static_cast< UInt32 >( data.size() ), &processed_size ) == S_OK );
+            REQUIRE( processed_size == data.size() );
+        }
+
+        // The data is still in the pooled buffer, so nothing has been written to the file yet.
+        REQUIRE( fs::file_size( test_file ) == 0 );
+    }
+    REQUIRE( fs::file_size( test_file ) == kTestDataSize );
+    fs::remove( test_file );
+}
+
+TEST_CASE( "BufferPool: File input streams read through the pooled buffers", "[bufferpool]" ) {
+    const fs::path test_file = fs::temp_directory_path() / "bit7z_test_bufferpool_in.bin";
+    {
+        fs::ofstream file{ test_file, std::ios::binary | std::ios::trunc };
+        const std::vector< char > data( kTestDataSize, 'a' );
+        file.write( data.data(), static_cast< std::streamsize >( data.size() ) );
+    }
+
+    CFileInStream in_stream{ test_file };
+    char first_byte = 0;
+    UInt32 processed_size = 0;
+    REQUIRE( in_stream.Read( &first_byte, 1, &processed_size ) == S_OK );
+    REQUIRE( first_byte == 'a' );
+
+    {
+        // Overwriting the file content after the first read (without truncating it).
+        fs::fstream file{ test_file, std::ios::in | std::ios::out | std::ios::binary };
+        const std::vector< char > data( kTestDataSize, 'b' );
+        file.write( data.data(), static_cast< std::streamsize >( data.size() ) );
+    }
+
+    // The whole file was read into the pooled buffer by the first read, so the old content is returned.
+    std::vector< char > content( kTestDataSize - 1, 0 );
+    REQUIRE( in_stream.Read( content.data(), static_cast< UInt32 >( content.size() ), &processed_size ) == S_OK );
+    REQUIRE( processed_size == content.size() );
+    REQUIRE( content == std::vector< char >( kTestDataSize - 1, 'a' ) );
+
+    fs::remove( test_file );
+}
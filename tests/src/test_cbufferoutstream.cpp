@@ -0,0 +1,81 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferoutstream.hpp>
+
+using bit7z::byte_t;
+using bit7z::buffer_t;
+using bit7z::CBufferOutStream;
+
+TEST_CASE( "CBufferOutStream: Writing to a buffer stream", "[cbufferoutstream][writing]" ) {
+    buffer_t buffer;
+    const buffer_t data{ 1, 2, 3, 4, 5 };
+    UInt32 processed_size{ 0 };
+    UInt64 new_position{ 0 };
+
+    SECTION( "Reserving the buffer capacity using the size hint" ) {
+        CBufferOutStream out_stream{ buffer, 1024 };
+        REQUIRE( buffer.empty() );
+        REQUIRE( buffer.capacity() >= 1024 );
+    }
+
+    SECTION( "Appending data to the buffer" ) {
+        CBufferOutStream out_stream{ buffer };
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 5 );
+        REQUIRE( out_stream.Write( data.data(), 2, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 2 );
+        REQUIRE( buffer == buffer_t{ 1, 2, 3, 4, 5, 1, 2 } );
+
+        REQUIRE( out_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 7 );
+    }
+
+    SECTION( "Overwriting and appending data to the buffer" ) {
+        CBufferOutStream out_stream{ buffer };
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == S_OK );
+        REQUIRE( out_stream.Seek( 3, STREAM_SEEK_SET, &new_position ) == S_OK );
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 5 );
+        REQUIRE( buffer == buffer_t{ 1, 2, 3, 1, 2, 3, 4, 5 } );
+
+        REQUIRE( out_stream.Seek( 0, STREAM_SEEK_SET, &new_position ) == S_OK );
+        REQUIRE( out_stream.Write( data.data(), 1, &processed_size ) == S_OK );
+        REQUIRE( buffer == buffer_t{ 1, 2, 3, 1, 2, 3, 4, 5 } );
+        REQUIRE( out_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 1 );
+    }
+
+    SECTION( "Changing the size of the buffer" ) {
+        CBufferOutStream out_stream{ buffer };
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == S_OK );
+
+        REQUIRE( out_stream.SetSize( 10 ) == S_OK );
+        REQUIRE( buffer.size() == 10 );
+        REQUIRE( out_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 5 );
+
+        REQUIRE( out_stream.SetSize( 2 ) == S_OK );
+        REQUIRE( buffer == buffer_t{ 1, 2 } );
+        REQUIRE( out_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 2 );
+
+        REQUIRE( out_stream.Write( data.data(), 1, &processed_size ) == S_OK );
+        REQUIRE( buffer == buffer_t{ 1, 2, 1 } );
+    }
+}
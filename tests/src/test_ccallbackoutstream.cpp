@@ -0,0 +1,136 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <internal/ccallbackoutstream.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::byte_t;
+using bit7z::buffer_t;
+using bit7z::CCallbackOutStream;
+using bit7z::SinkCallback;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+TEST_CASE( "CCallbackOutStream: Writing to a sink callback", "[ccallbackoutstream][writing]" ) {
+    const buffer_t data{ 1, 2, 3, 4, 5 };
+    std::vector< buffer_t > chunks;
+    std::exception_ptr sink_error;
+    UInt32 processed_size{ 42 };
+
+    SECTION( "Delivering the chunks in order and with their size" ) {
+        const SinkCallback sink = [ &chunks ]( const byte_t* chunk, std::size_t size ) -> bool {
+            chunks.emplace_back( chunk, chunk + size );
+            return true;
+        };
+        CCallbackOutStream out_stream{ sink, sink_error };
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 5 );
+        REQUIRE( out_stream.Write( data.data() + 1, 2, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 2 );
+        REQUIRE( out_stream.Write( data.data() + 4, 1, nullptr ) == S_OK );
+        REQUIRE( chunks == std::vector< buffer_t >{ { 1, 2, 3, 4, 5 }, { 2, 3 }, { 5 } } );
+        REQUIRE_FALSE( sink_error );
+    }
+
+    SECTION( "Writing no data does not call the sink" ) {
+        const SinkCallback sink = [ &chunks ]( const byte_t* chunk, std::size_t size ) -> bool {
+            chunks.emplace_back( chunk, chunk + size );
+            return true;
+        };
+        CCallbackOutStream out_stream{ sink, sink_error };
+        REQUIRE( out_stream.Write( data.data(), 0, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 0 );
+        REQUIRE( chunks.empty() );
+    }
+
+    SECTION( "Stopping the writing when the sink returns false" ) {
+        const SinkCallback sink = [ &chunks ]( const byte_t* chunk, std::size_t size ) -> bool {
+            chunks.emplace_back( chunk, chunk + size );
+            return chunks.size() < 2;
+        };
+        CCallbackOutStream out_stream{ sink, sink_error };
+        REQUIRE( out_stream.Write( data.data(), 2, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 2 );
+        REQUIRE( out_stream.Write( data.data() + 2, 3, &processed_size ) == E_ABORT );
+        REQUIRE( processed_size == 0 );
+        REQUIRE( chunks.size() == 2 );
+        REQUIRE_FALSE( sink_error );
+    }
+
+    SECTION( "Capturing the exceptions thrown by the sink" ) {
+        const SinkCallback sink = []( const byte_t*, std::size_t ) -> bool {
+            throw std::runtime_error( "sink error" );
+        };
+        CCallbackOutStream out_stream{ sink, sink_error };
+        REQUIRE( out_stream.Write( data.data(), 5, &processed_size ) == E_ABORT );
+        REQUIRE( processed_size == 0 );
+        REQUIRE( sink_error );
+        REQUIRE_THROWS_WITH( std::rethrow_exception( sink_error ), "sink error" );
+    }
+}
+
+TEST_CASE( "CCallbackOutStream: Extracting an item to a sink callback", "[ccallbackoutstream][extraction]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+    constexpr uint32_t chunk_size = 4;
+    const auto archive = fake::make_archive( { { "first.txt", "first item" }, { "second.txt", "second item" } },
+                                             0,
+                                             chunk_size );
+    const BitArchiveReader reader{ lib, archive, BitFormat::SevenZip };
+
+    std::vector< buffer_t > chunks;
+
+    SECTION( "Delivering the item content in order" ) {
+        reader.extract( [ &chunks ]( const byte_t* chunk, std::size_t size ) -> bool {
+            chunks.emplace_back( chunk, chunk + size );
+            return true;
+        }, 1 );
+
+        REQUIRE( chunks.size() == 3 );
+        buffer_t content;
+        for ( const auto& chunk : chunks ) {
+            REQUIRE( chunk.size() <= chunk_size );
+            content.insert( content.end(), chunk.cbegin(), chunk.cend() );
+        }
+        REQUIRE( content == fake::to_bytes( "second item" ) );
+    }
+
+    SECTION( "Aborting the extraction when the sink returns false" ) {
+        REQUIRE_THROWS( reader.extract( [ &chunks ]( const byte_t* chunk, std::size_t size ) -> bool {
+            chunks.emplace_back( chunk, chunk + size );
+            return false;
+        }, 0 ) );
+        REQUIRE( chunks.size() == 1 );
+    }
+
+    SECTION( "Rethrowing the exceptions thrown by the sink" ) {
+        REQUIRE_THROWS_AS( reader.extract( []( const byte_t*, std::size_t ) -> bool {
+            throw std::invalid_argument( "sink error" );
+        }, 0 ), std::invalid_argument );
+    }
+}
@@ -0,0 +1,53 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/clookaheadinstream.hpp>
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <string>
+
+using bit7z::byte_t;
+using bit7z::CLookAheadInStream;
+
+TEST_CASE( "CLookAheadInStream: Reading a stream after looking ahead", "[clookaheadinstream]" ) {
+    const std::string content = "Lorem ipsum dolor sit amet, consectetur adipiscing elit.";
+    const size_t look_ahead_size = GENERATE( 0, 1, 11, 56, 100 );
+
+    DYNAMIC_SECTION( "Look-ahead of " << look_ahead_size << " bytes" ) {
+        std::istringstream input{ content };
+        CLookAheadInStream in_stream{ input, look_ahead_size };
+
+        const auto& look_ahead = in_stream.lookAhead();
+        REQUIRE( look_ahead.size() == std::min( look_ahead_size, content.size() ) );
+        REQUIRE( std::equal( look_ahead.cbegin(), look_ahead.cend(), content.cbegin() ) );
+
+        // Reading the whole stream in small chunks: the look-ahead bytes come first, then the rest of the stream.
+        std::string read_content;
+        std::array< byte_t, 5 > chunk{};
+        UInt32 processed_size = 0;
+        do {
+            REQUIRE( in_stream.Read( chunk.data(), static_cast< UInt32 >( chunk.size() ), &processed_size ) == S_OK );
+            read_content.append( chunk.cbegin(), chunk.cbegin() + processed_size );
+        } while ( processed_size > 0 );
+        REQUIRE( read_content == content );
+
+        REQUIRE( in_stream.Read( chunk.data(), static_cast< UInt32 >( chunk.size() ), &processed_size ) == S_OK );
+        REQUIRE( processed_size == 0 );
+    }
+}
@@ -0,0 +1,167 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitexception.hpp>
+#include <internal/cfileinstream.hpp>
+#include <internal/cmappedinstream.hpp>
+
+#include <limits>
+
+using bit7z::BitException;
+using bit7z::buffer_t;
+using bit7z::CFileInStream;
+using bit7z::CMappedInStream;
+using bit7z::MappedAccess;
+
+namespace {
+auto write_test_file( const std::string& name, const buffer_t& content ) -> fs::path {
+    fs::path test_file = fs::temp_directory_path() / name;
+    fs::ofstream file{ test_file, std::ios::binary | std::ios::trunc };
+    file.write( reinterpret_cast< const char* >( content.data() ), // NOLINT(*-pro-type-reinterpret-cast)
+                static_cast< std::streamsize >( content.size() ) );
+    return test_file;
+}
+} // namespace
+
+TEST_CASE( "CMappedInStream: Reading a memory-mapped file", "[cmappedinstream][reading]" ) {
+    const buffer_t content{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    const fs::path test_file = write_test_file( "bit7z_test_cmappedinstream.bin", content );
+    {
+        const auto access = GENERATE( MappedAccess::Normal, MappedAccess::Sequential );
+        CMappedInStream in_stream{ test_file, access };
+        buffer_t buffer( 4, 0 );
+        UInt32 processed_size{ 42 };
+        UInt64 new_position{ 0 };
+
+        SECTION( "Reading the whole file in chunks" ) {
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 4 );
+            REQUIRE( buffer == buffer_t{ 1, 2, 3, 4 } );
+
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 4 );
+            REQUIRE( buffer == buffer_t{ 5, 6, 7, 8 } );
+
+            // Reading past the end of the file.
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 2 );
+            REQUIRE( buffer == buffer_t{ 9, 10, 7, 8 } );
+
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 0 );
+
+            REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == content.size() );
+        }
+
+        SECTION( "Reading no data" ) {
+            REQUIRE( in_stream.Read( buffer.data(), 0, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 0 );
+            REQUIRE( in_stream.Read( buffer.data(), 2, nullptr ) == S_OK );
+            REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == 2 );
+        }
+
+        SECTION( "Seeking from the beginning of the file (STREAM_SEEK_SET)" ) {
+            REQUIRE( in_stream.Seek( 6, STREAM_SEEK_SET, &new_position ) == S_OK );
+            REQUIRE( new_position == 6 );
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 4 );
+            REQUIRE( buffer == buffer_t{ 7, 8, 9, 10 } );
+
+            REQUIRE( in_stream.Seek( -1, STREAM_SEEK_SET, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+            REQUIRE( new_position == 6 ); //old value, not changed
+            REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == 10 );
+        }
+
+        SECTION( "Seeking from the current position (STREAM_SEEK_CUR)" ) {
+            REQUIRE( in_stream.Read( buffer.data(), 2, &processed_size ) == S_OK );
+            REQUIRE( in_stream.Seek( 3, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == 5 );
+            REQUIRE( in_stream.Seek( -4, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == 1 );
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( buffer == buffer_t{ 2, 3, 4, 5 } );
+
+            REQUIRE( in_stream.Seek( -6, STREAM_SEEK_CUR, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+            REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+            REQUIRE( new_position == 5 );
+        }
+
+        SECTION( "Seeking from the end of the file (STREAM_SEEK_END)" ) {
+            REQUIRE( in_stream.Seek( -3, STREAM_SEEK_END, &new_position ) == S_OK );
+            REQUIRE( new_position == 7 );
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 3 );
+            REQUIRE( buffer == buffer_t{ 8, 9, 10, 0 } );
+
+            REQUIRE( in_stream.Seek( -10, STREAM_SEEK_END, &new_position ) == S_OK );
+            REQUIRE( new_position == 0 );
+            REQUIRE( in_stream.Seek( -11, STREAM_SEEK_END, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+            REQUIRE( new_position == 0 );
+        }
+
+        SECTION( "Seeking past the end of the file" ) {
+            REQUIRE( in_stream.Seek( 5, STREAM_SEEK_END, &new_position ) == S_OK );
+            REQUIRE( new_position == 15 );
+            REQUIRE( in_stream.Read( buffer.data(), 4, &processed_size ) == S_OK );
+            REQUIRE( processed_size == 0 );
+
+            REQUIRE( in_stream.Seek( std::numeric_limits< Int64 >::max(), STREAM_SEEK_END, &new_position ) ==
+                     E_INVALIDARG );
+            REQUIRE( new_position == 15 );
+        }
+
+        SECTION( "Invalid seek origin" ) {
+            REQUIRE( in_stream.Seek( 0, 3, &new_position ) == STG_E_INVALIDFUNCTION );
+            REQUIRE( new_position == 0 );
+        }
+    }
+    fs::remove( test_file );
+}
+
+TEST_CASE( "CMappedInStream: Mapping an empty or non-existing file", "[cmappedinstream]" ) {
+    const fs::path empty_file = write_test_file( "bit7z_test_cmappedinstream_empty.bin", {} );
+    REQUIRE_THROWS_AS( CMappedInStream{ empty_file }, BitException );
+
+    // An empty file cannot be mapped, so it is read through a file stream.
+    const auto in_stream = bit7z::openFileInStream( empty_file );
+    REQUIRE( dynamic_cast< CFileInStream* >( static_cast< IInStream* >( in_stream ) ) != nullptr );
+
+    buffer_t buffer( 4, 0 );
+    UInt32 processed_size{ 42 };
+    REQUIRE( in_stream->Read( buffer.data(), 4, &processed_size ) == S_OK );
+    REQUIRE( processed_size == 0 );
+    fs::remove( empty_file );
+
+    const fs::path missing_file = fs::temp_directory_path() / "bit7z_test_cmappedinstream_missing.bin";
+    REQUIRE_THROWS_AS( CMappedInStream{ missing_file }, BitException );
+    REQUIRE_THROWS( bit7z::openFileInStream( missing_file ) );
+}
+
+#ifdef BIT7Z_USE_MAPPED_FILES
+TEST_CASE( "CMappedInStream: Opening a file stream on a non-empty file", "[cmappedinstream]" ) {
+    const fs::path test_file = write_test_file( "bit7z_test_cmappedinstream_open.bin", buffer_t{ 1, 2, 3 } );
+    {
+        const auto in_stream = bit7z::openFileInStream( test_file );
+        REQUIRE( dynamic_cast< CMappedInStream* >( static_cast< IInStream* >( in_stream ) ) != nullptr );
+    }
+    fs::remove( test_file );
+}
+#endif
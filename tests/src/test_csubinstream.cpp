@@ -0,0 +1,131 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferinstream.hpp>
+#include <internal/csubinstream.hpp>
+#include <internal/util.hpp>
+
+#include <limits>
+
+using bit7z::buffer_t;
+using bit7z::CBufferInStream;
+using bit7z::CSubInStream;
+
+TEST_CASE( "CSubInStream: Reading a sub-range of a stream", "[csubinstream]" ) {
+    const buffer_t buffer{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const auto base_stream = bit7z::make_com< CBufferInStream, IInStream >( buffer );
+    // Moving the base stream, to check that the sub-stream does not depend on its position.
+    REQUIRE( base_stream->Seek( 8, STREAM_SEEK_SET, nullptr ) == S_OK );
+
+    CSubInStream in_stream{ base_stream, 3 };
+    buffer_t data( 4, 0 );
+    UInt32 processed_size{ 42 };
+    UInt64 new_position{ 42 };
+
+    SECTION( "Reading from the start of the sub-range" ) {
+        REQUIRE( in_stream.Read( data.data(), 4, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 4 );
+        REQUIRE( data == buffer_t{ 3, 4, 5, 6 } );
+
+        // Reading past the end of the base stream.
+        REQUIRE( in_stream.Read( data.data(), 4, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 3 );
+        REQUIRE( data == buffer_t{ 7, 8, 9, 6 } );
+
+        REQUIRE( in_stream.Read( data.data(), 4, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 0 );
+
+        REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 7 );
+    }
+
+    SECTION( "Seeking from the start of the sub-range (STREAM_SEEK_SET)" ) {
+        REQUIRE( in_stream.Seek( 2, STREAM_SEEK_SET, &new_position ) == S_OK );
+        REQUIRE( new_position == 2 );
+        REQUIRE( in_stream.Read( data.data(), 4, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 4 );
+        REQUIRE( data == buffer_t{ 5, 6, 7, 8 } );
+
+        REQUIRE( in_stream.Seek( 0, STREAM_SEEK_SET, &new_position ) == S_OK );
+        REQUIRE( new_position == 0 );
+        REQUIRE( in_stream.Read( data.data(), 1, &processed_size ) == S_OK );
+        REQUIRE( data[ 0 ] == 3 );
+    }
+
+    SECTION( "Seeking from the current position (STREAM_SEEK_CUR)" ) {
+        REQUIRE( in_stream.Read( data.data(), 2, &processed_size ) == S_OK );
+        REQUIRE( in_stream.Seek( 3, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 5 );
+        REQUIRE( in_stream.Seek( -4, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 1 );
+        REQUIRE( in_stream.Read( data.data(), 2, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 2 );
+        REQUIRE( data[ 0 ] == 4 );
+        REQUIRE( data[ 1 ] == 5 );
+    }
+
+    SECTION( "Seeking from the end of the sub-range (STREAM_SEEK_END)" ) {
+        REQUIRE( in_stream.Seek( 0, STREAM_SEEK_END, &new_position ) == S_OK );
+        REQUIRE( new_position == 7 );
+        REQUIRE( in_stream.Seek( -2, STREAM_SEEK_END, &new_position ) == S_OK );
+        REQUIRE( new_position == 5 );
+        REQUIRE( in_stream.Read( data.data(), 4, &processed_size ) == S_OK );
+        REQUIRE( processed_size == 2 );
+        REQUIRE( data[ 0 ] == 8 );
+        REQUIRE( data[ 1 ] == 9 );
+
+        REQUIRE( in_stream.Seek( -7, STREAM_SEEK_END, &new_position ) == S_OK );
+        REQUIRE( new_position == 0 );
+    }
+
+    SECTION( "Seeking before the start of the sub-range" ) {
+        REQUIRE( in_stream.Seek( 4, STREAM_SEEK_SET, &new_position ) == S_OK );
+
+        new_position = 42;
+        REQUIRE( in_stream.Seek( -1, STREAM_SEEK_SET, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+        REQUIRE( new_position == 42 ); // Not changed.
+        REQUIRE( in_stream.Seek( -5, STREAM_SEEK_CUR, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+        // Note: the sub-range starts at offset 3, so this would be a valid position in the base stream.
+        REQUIRE( in_stream.Seek( -8, STREAM_SEEK_END, &new_position ) == HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+        REQUIRE( in_stream.Seek( std::numeric_limits< Int64 >::min(), STREAM_SEEK_END, &new_position ) ==
+                 HRESULT_WIN32_ERROR_NEGATIVE_SEEK );
+        REQUIRE( new_position == 42 );
+
+        // The current position is unchanged.
+        REQUIRE( in_stream.Seek( 0, STREAM_SEEK_CUR, &new_position ) == S_OK );
+        REQUIRE( new_position == 4 );
+        REQUIRE( in_stream.Read( data.data(), 1, &processed_size ) == S_OK );
+        REQUIRE( data[ 0 ] == 7 );
+    }
+
+    SECTION( "Invalid seeks" ) {
+        REQUIRE( in_stream.Seek( 0, 3, &new_position ) == STG_E_INVALIDFUNCTION );
+        REQUIRE( in_stream.Seek( std::numeric_limits< Int64 >::max(), STREAM_SEEK_END, &new_position ) ==
+                 E_INVALIDARG );
+    }
+}
+
+TEST_CASE( "CSubInStream: Sub-range starting after the end of the base stream", "[csubinstream]" ) {
+    const buffer_t buffer{ 0, 1, 2, 3 };
+    const auto base_stream = bit7z::make_com< CBufferInStream, IInStream >( buffer );
+    CSubInStream in_stream{ base_stream, 10 };
+
+    UInt64 new_position{ 42 };
+    REQUIRE( in_stream.Seek( 0, STREAM_SEEK_END, &new_position ) == S_OK );
+    REQUIRE( new_position == 0 );
+}
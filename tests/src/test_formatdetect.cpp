@@ -0,0 +1,274 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef BIT7Z_AUTO_FORMAT
+
+#include <catch2/catch.hpp>
+
+#include <bitformatprober.hpp>
+#include <internal/formatdetect.hpp>
+
+#include <internal/fs.hpp>
+
+#include <random>
+#include <vector>
+
+using bit7z::BitFormatProber;
+using bit7z::BitProbeConfidence;
+using bit7z::byte_t;
+using bit7z::detectFormatFromBuffer;
+using bit7z::kSignatureWindowSize;
+using bit7z::SignatureCandidate;
+using bit7z::SignatureScanner;
+
+namespace BitFormat = bit7z::BitFormat;
+
+TEST_CASE( "formatdetect: Detecting the format from an in-memory signature window", "[formatdetect]" ) {
+    std::vector< byte_t > window( kSignatureWindowSize, 0 );
+    uint32_t signature_size = 0;
+
+    SECTION( "No matching signature" ) {
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == nullptr );
+        REQUIRE( detectFormatFromBuffer( window.data(), 0, signature_size ) == nullptr );
+    }
+
+    SECTION( "Signature at the start of the file" ) {
+        const std::vector< byte_t > seven_zip{ '7', 'z', 0xBC, 0xAF, 0x27, 0x1C, 0x00, 0x04 };
+        std::copy( seven_zip.cbegin(), seven_zip.cend(), window.begin() );
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == &BitFormat::SevenZip );
+        REQUIRE( signature_size == 6 );
+
+        // The signature is detected also when the file is shorter than the window.
+        REQUIRE( detectFormatFromBuffer( seven_zip.data(), seven_zip.size(), signature_size ) == &BitFormat::SevenZip );
+        REQUIRE( signature_size == 6 );
+    }
+
+    SECTION( "Signature ending with zero bytes" ) {
+        const std::vector< byte_t > rar{ 'R', 'a', 'r', '!', 0x1A, 0x07, 0x00 };
+        std::copy( rar.cbegin(), rar.cend(), window.begin() );
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == &BitFormat::Rar );
+        REQUIRE( signature_size == 7 );
+    }
+
+    SECTION( "Signature at an offset" ) {
+        const std::vector< byte_t > ustar{ 'u', 's', 't', 'a', 'r' };
+        std::copy( ustar.cbegin(), ustar.cend(), window.begin() + 0x101 );
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == &BitFormat::Tar );
+        REQUIRE( signature_size == 5 );
+
+        // The signature is beyond the end of the available data.
+        REQUIRE( detectFormatFromBuffer( window.data(), 0x101 + 2, signature_size ) == nullptr );
+    }
+
+    SECTION( "ISO and UDF volume descriptors" ) {
+        const std::vector< byte_t > iso{ 'C', 'D', '0', '0', '1' };
+        std::copy( iso.cbegin(), iso.cend(), window.begin() + 0x8001 );
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == &BitFormat::Iso );
+
+        const std::vector< byte_t > udf{ 'N', 'S', 'R', '0' };
+        std::copy( udf.cbegin(), udf.cend(), window.begin() + 0x8001 + 15 * 0x800 );
+        REQUIRE( detectFormatFromBuffer( window.data(), window.size(), signature_size ) == &BitFormat::Udf );
+    }
+}
+
+TEST_CASE( "BitFormatProber: Probing in-memory data", "[formatdetect][BitFormatProber]" ) {
+    const BitFormatProber prober{ 1 };
+    REQUIRE( prober.threadsCount() == 1 );
+
+    const std::vector< byte_t > zip{ 'P', 'K', 0x03, 0x04 };
+    auto result = prober.probe( zip.data(), zip.size() );
+    REQUIRE( result.detected() );
+    REQUIRE( result.format() == BitFormat::Zip );
+    REQUIRE( result.confidence() == BitProbeConfidence::Low );
+
+    const std::vector< byte_t > xz{ 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+    result = prober.probe( xz.data(), xz.size() );
+    REQUIRE( result.format() == BitFormat::Xz );
+    REQUIRE( result.confidence() == BitProbeConfidence::High );
+
+    const std::vector< byte_t > unknown{ 'h', 'e', 'l', 'l', 'o' };
+    result = prober.probe( unknown.data(), unknown.size() );
+    REQUIRE( !result.detected() );
+    REQUIRE( result.format() == BitFormat::Auto );
+    REQUIRE( result.confidence() == BitProbeConfidence::None );
+}
+
+TEST_CASE( "formatdetect: Scanning for embedded signatures", "[formatdetect][SignatureScanner]" ) {
+    const SignatureScanner scanner{};
+    std::vector< byte_t > data( 4096, 0 );
+    std::vector< SignatureCandidate > candidates;
+
+    SECTION( "No signatures" ) {
+        scanner.scan( data.data(), data.size(), data.size(), 0, candidates );
+        REQUIRE( candidates.empty() );
+    }
+
+    SECTION( "Signatures at any offset" ) {
+        const std::vector< byte_t > zip{ 'P', 'K', 0x03, 0x04 };
+        const std::vector< byte_t > xz{ 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+        const std::vector< byte_t > ustar{ 'u', 's', 't', 'a', 'r' };
+        std::copy( zip.cbegin(), zip.cend(), data.begin() + 1000 );
+        std::copy( xz.cbegin(), xz.cend(), data.begin() + 3000 );
+        std::copy( ustar.cbegin(), ustar.cend(), data.begin() + 2048 + 0x101 );
+        std::copy( ustar.cbegin(), ustar.cend(), data.begin() + 0x10 ); // Before the start of the data: ignored.
+
+        scanner.scan( data.data(), data.size(), data.size(), 0, candidates );
+        REQUIRE( candidates.size() == 3 );
+        REQUIRE( candidates[ 0 ].offset == 1000 );
+        REQUIRE( candidates[ 0 ].format == &BitFormat::Zip );
+        REQUIRE( candidates[ 1 ].offset == 2048 );
+        REQUIRE( candidates[ 1 ].format == &BitFormat::Tar );
+        REQUIRE( candidates[ 2 ].offset == 3000 );
+        REQUIRE( candidates[ 2 ].format == &BitFormat::Xz );
+
+        // Offsets are relative to the given base offset.
+        candidates.clear();
+        scanner.scan( data.data(), data.size(), data.size(), 1u << 20u, candidates );
+        REQUIRE( candidates.size() == 4 );
+    }
+
+    SECTION( "Only the given positions are checked, but signatures can end after them" ) {
+        const std::vector< byte_t > rar5{ 'R', 'a', 'r', '!', 0x1A, 0x07, 0x01, 0x00 };
+        std::copy( rar5.cbegin(), rar5.cend(), data.begin() + 100 );
+
+        scanner.scan( data.data(), data.size(), 100, 0, candidates );
+        REQUIRE( candidates.empty() );
+        scanner.scan( data.data(), 104, 101, 0, candidates );
+        REQUIRE( candidates.empty() ); // The signature is truncated.
+        scanner.scan( data.data(), 100 + rar5.size(), 101, 0, candidates );
+        REQUIRE( candidates.size() == 1 );
+        REQUIRE( candidates[ 0 ].format == &BitFormat::Rar5 );
+    }
+
+    SECTION( "Signatures with a wildcard byte" ) {
+        const std::vector< byte_t > bzip2{ 'B', 'Z', 'h', '9', '1', 'A', 'Y', '&', 'S', 'Y' };
+        std::copy( bzip2.cbegin(), bzip2.cend(), data.begin() + 10 );
+        const std::vector< byte_t > not_bzip2{ 'B', 'Z', 'h', '9', '1', 'A', 'Y', '&', 'S', 'X' };
+        std::copy( not_bzip2.cbegin(), not_bzip2.cend(), data.begin() + 100 );
+
+        scanner.scan( data.data(), data.size(), data.size(), 0, candidates );
+        REQUIRE( candidates.size() == 1 );
+        REQUIRE( candidates[ 0 ].offset == 10 );
+        REQUIRE( candidates[ 0 ].format == &BitFormat::BZip2 );
+    }
+
+    SECTION( "Same candidates as checking one position at a time" ) {
+        // Note: scanning a single position at a time never uses the SIMD filter (if any).
+        std::mt19937 random_engine{ 42 }; // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        std::uniform_int_distribution< int > random_byte{ 0, 255 };
+        for ( auto& byte : data ) {
+            byte = static_cast< byte_t >( random_byte( random_engine ) );
+        }
+        // Signatures starting at every position of a 16 bytes block, and at the end of the data.
+        const std::vector< std::vector< byte_t > > signatures{ { 'P', 'K', 0x03, 0x04 },
+                                                               { 0xFD, '7', 'z', 'X', 'Z', 0x00 },
+                                                               { '!', '<', 'a', 'r', 'c', 'h', '>' },
+                                                               { 0xED, 0xAB, 0xEE, 0xDB },
+                                                               { 'x', 'a', 'r', '!', 0x00, 0x1C } };
+        std::size_t position = 1024;
+        for ( std::size_t index = 0; index < 32; ++index ) {
+            const auto& signature = signatures[ index % signatures.size() ];
+            std::copy( signature.cbegin(), signature.cend(), data.begin() + position );
+            position += signature.size() + 11;
+        }
+        std::copy( signatures[ 0 ].cbegin(), signatures[ 0 ].cend(), data.end() - 4 );
+
+        // Scans the positions [start, start + scan_size), with the data ending at start + size.
+        const auto require_same_candidates = [ & ]( std::size_t start, std::size_t size, std::size_t scan_size ) {
+            candidates.clear();
+            scanner.scan( data.data() + start, size, scan_size, start, candidates );
+            std::vector< SignatureCandidate > expected_candidates;
+            for ( std::size_t offset = start; offset < start + scan_size; ++offset ) {
+                scanner.scan( data.data() + offset, start + size - offset, 1, offset, expected_candidates );
+            }
+            REQUIRE( candidates.size() == expected_candidates.size() );
+            for ( std::size_t index = 0; index < candidates.size(); ++index ) {
+                REQUIRE( candidates[ index ].offset == expected_candidates[ index ].offset );
+                REQUIRE( candidates[ index ].format == expected_candidates[ index ].format );
+            }
+        };
+
+        require_same_candidates( 0, data.size(), data.size() );
+        REQUIRE( candidates.size() >= 33 );
+
+        // Sizes that are not multiples of the sixteen bytes blocks, with the data ending at or after the positions.
+        for ( std::size_t scan_size = 0; scan_size <= 40; ++scan_size ) {
+            require_same_candidates( 1024, scan_size, scan_size );
+            require_same_candidates( 1024, scan_size + 1, scan_size );
+            require_same_candidates( 1024, scan_size + 8, scan_size );
+        }
+    }
+}
+
+TEST_CASE( "BitFormatProber: Scanning in-memory data", "[formatdetect][BitFormatProber]" ) {
+    std::vector< byte_t > data( 64 * 1024, 0 );
+    const std::vector< byte_t > seven_zip{ '7', 'z', 0xBC, 0xAF, 0x27, 0x1C };
+    const std::vector< byte_t > iso{ 'C', 'D', '0', '0', '1' };
+    std::copy( iso.cbegin(), iso.cend(), data.begin() + 0x8001 );
+    std::copy( seven_zip.cbegin(), seven_zip.cend(), data.begin() + 0x9000 );
+
+    const BitFormatProber prober{};
+    const auto archives = prober.scan( data.data(), data.size() );
+    REQUIRE( archives.size() == 2 );
+    REQUIRE( archives[ 0 ].offset() == 0 );
+    REQUIRE( archives[ 0 ].format() == BitFormat::Iso );
+    REQUIRE( archives[ 1 ].offset() == 0x9000 );
+    REQUIRE( archives[ 1 ].format() == BitFormat::SevenZip );
+}
+
+TEST_CASE( "BitFormatProber: Scanning a file", "[formatdetect][BitFormatProber]" ) {
+    // The file is split in two ranges scanned in parallel (each at least 16 MiB long), and each range
+    // is read in chunks of 1 MiB: the signatures straddling these boundaries must be found.
+    constexpr std::size_t kChunkSize = 1024 * 1024;
+    constexpr std::size_t kFileSize = 32 * kChunkSize + 4096;
+    constexpr std::size_t kRangeSize = kFileSize / 2;
+
+    const std::vector< byte_t > zip{ 'P', 'K', 0x03, 0x04 };
+    const std::vector< byte_t > seven_zip{ '7', 'z', 0xBC, 0xAF, 0x27, 0x1C };
+    const std::vector< byte_t > xz{ 0xFD, '7', 'z', 'X', 'Z', 0x00 };
+    const std::vector< byte_t > rar5{ 'R', 'a', 'r', '!', 0x1A, 0x07, 0x01, 0x00 };
+
+    std::vector< byte_t > data( kFileSize, 0 );
+    std::copy( zip.cbegin(), zip.cend(), data.begin() + kChunkSize - 2 ); // Chunk boundary (first range).
+    std::copy( seven_zip.cbegin(), seven_zip.cend(), data.begin() + kRangeSize - 3 ); // Ranges boundary.
+    std::copy( xz.cbegin(), xz.cend(), data.begin() + kRangeSize + 3 ); // Just after the start of the second range.
+    std::copy( rar5.cbegin(), rar5.cend(), data.begin() + kRangeSize + kChunkSize - 1 ); // Chunk boundary.
+    std::copy( zip.cbegin(), zip.cend(), data.end() - zip.size() ); // End of the file.
+    std::copy( seven_zip.cbegin(), seven_zip.cend() - 1, data.end() - 9 ); // Truncated: ignored.
+
+    const fs::path test_file = fs::temp_directory_path() / "bit7z_test_formatprober_scan.bin";
+    {
+        fs::ofstream file{ test_file, std::ios::binary | std::ios::trunc };
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        file.write( reinterpret_cast< const char* >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+    }
+
+    const auto threads_count = GENERATE( as< uint32_t >(), 1, 2 );
+    DYNAMIC_SECTION( "Scanning the file with " << threads_count << " threads" ) {
+        const BitFormatProber prober{ threads_count };
+        const auto archives = prober.scan( test_file.string< bit7z::tchar >() );
+        REQUIRE( archives.size() == 5 );
+        REQUIRE( archives[ 0 ].offset() == kChunkSize - 2 );
+        REQUIRE( archives[ 0 ].format() == BitFormat::Zip );
+        REQUIRE( archives[ 1 ].offset() == kRangeSize - 3 );
+        REQUIRE( archives[ 1 ].format() == BitFormat::SevenZip );
+        REQUIRE( archives[ 2 ].offset() == kRangeSize + 3 );
+        REQUIRE( archives[ 2 ].format() == BitFormat::Xz );
+        REQUIRE( archives[ 3 ].offset() == kRangeSize + kChunkSize - 1 );
+        REQUIRE( archives[ 3 ].format() == BitFormat::Rar5 );
+        REQUIRE( archives[ 4 ].offset() == kFileSize - zip.size() );
+        REQUIRE( archives[ 4 ].format() == BitFormat::Zip );
+    }
+    fs::remove( test_file );
+}
+
+#endif
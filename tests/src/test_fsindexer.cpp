@@ -0,0 +1,196 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bitexception.hpp>
+#include <internal/fsindexer.hpp>
+#include <internal/fsitemsstore.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace bit7z;
+using bit7z::filesystem::FSIndexer;
+using bit7z::filesystem::FSItem;
+using bit7z::filesystem::FSItemsStore;
+
+namespace {
+// NOLINTNEXTLINE(misc-no-recursion)
+void createTree( const fs::path& directory, int depth ) {
+    fs::create_directories( directory );
+    for ( int index = 0; index < 5; ++index ) {
+        std::ofstream file{ directory / ( "file" + std::to_string( index ) + ( index % 2 == 0 ? ".txt" : ".bin" ) ) };
+        file << index;
+    }
+    if ( depth > 0 ) {
+        for ( int index = 0; index < 3; ++index ) {
+            createTree( directory / ( "dir" + std::to_string( index ) + ( index == 1 ? ".txt" : "" ) ), depth - 1 );
+        }
+    }
+}
+
+std::vector< tstring > indexedPaths( const fs::path& directory,
+                                     const tstring& filter,
+                                     bool only_files,
+                                     bool recursive,
+                                     std::size_t threads_count,
+                                     bool sort_entries = false ) {
+    const FSItem directory_item{ directory, directory };
+    std::vector< std::unique_ptr< GenericInputItem > > items;
+    FSIndexer indexer{ directory_item, filter, only_files, sort_entries };
+    indexer.listDirectoryItems( items, recursive, threads_count );
+
+    std::vector< tstring > result;
+    result.reserve( items.size() );
+    for ( const auto& item : items ) {
+        result.push_back( item->inArchivePath().string< tchar >() );
+    }
+    return result;
+}
+
+void requireSameItems( const std::vector< std::unique_ptr< GenericInputItem > >& items, const FSItemsStore& store ) {
+    REQUIRE( store.size() == items.size() );
+    for ( std::size_t index = 0; index < items.size(); ++index ) {
+        const auto& item = *items[ index ];
+        REQUIRE( store.path( index ) == fs::path( item.path() ) );
+        REQUIRE( store.inArchivePath( index ) == item.inArchivePath() );
+        REQUIRE( store.isDir( index ) == item.isDir() );
+        REQUIRE( store.itemSize( index ) == item.size() );
+        for ( const auto property : { BitProperty::Path, BitProperty::IsDir, BitProperty::Size, BitProperty::Attrib,
+                                      BitProperty::CTime, BitProperty::ATime, BitProperty::MTime } ) {
+            REQUIRE( store.itemProperty( index, property ) == item.itemProperty( property ) );
+        }
+    }
+}
+} // namespace
+
+TEST_CASE( "fsindexer: Indexing a directory in parallel", "[fsindexer][listDirectoryItems]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsindexer";
+    fs::remove_all( test_dir );
+    createTree( test_dir, 3 );
+
+    for ( const tstring filter : { BIT7Z_STRING( "" ), BIT7Z_STRING( "*.txt" ) } ) {
+        for ( const bool only_files : { true, false } ) {
+            for ( const bool recursive : { true, false } ) {
+                const auto expected = indexedPaths( test_dir, filter, only_files, recursive, 1 );
+                REQUIRE( !expected.empty() );
+                for ( const std::size_t threads_count : { 2, 4, 16 } ) {
+                    // The parallel indexing must produce the same items, in the same order.
+                    REQUIRE( indexedPaths( test_dir, filter, only_files, recursive, threads_count ) == expected );
+                }
+            }
+        }
+    }
+
+    fs::remove_all( test_dir );
+}
+
+TEST_CASE( "fsindexer: Indexing a directory with sorted entries", "[fsindexer][listDirectoryItems]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsindexer_sorted";
+    fs::remove_all( test_dir );
+    createTree( test_dir, 2 );
+
+    for ( const tstring filter : { BIT7Z_STRING( "" ), BIT7Z_STRING( "*.txt" ) } ) {
+        for ( const bool only_files : { true, false } ) {
+            for ( const bool recursive : { true, false } ) {
+                /* Visiting the sorted entries of each directory depth-first gives the same order of the paths
+                 * compared element by element (a directory comes before its content). */
+                const auto unsorted = indexedPaths( test_dir, filter, only_files, recursive, 1 );
+                std::vector< fs::path > expected{ unsorted.cbegin(), unsorted.cend() };
+                std::sort( expected.begin(), expected.end() );
+
+                for ( const std::size_t threads_count : { 1, 2, 4, 16 } ) {
+                    const auto sorted = indexedPaths( test_dir, filter, only_files, recursive, threads_count, true );
+                    REQUIRE( std::vector< fs::path >{ sorted.cbegin(), sorted.cend() } == expected );
+                }
+            }
+        }
+    }
+
+    fs::remove_all( test_dir );
+}
+
+TEST_CASE( "fsindexer: Indexing a directory that cannot be listed", "[fsindexer][listDirectoryItems]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsindexer_missing";
+    fs::remove_all( test_dir );
+    fs::create_directories( test_dir );
+
+    const FSItem directory_item{ test_dir };
+    FSIndexer indexer{ directory_item };
+    fs::remove_all( test_dir ); // The directory is removed after being checked by the indexer.
+
+    for ( const std::size_t threads_count : { 1, 4 } ) {
+        std::vector< std::unique_ptr< GenericInputItem > > items;
+        REQUIRE_THROWS_AS( indexer.listDirectoryItems( items, true, threads_count ), BitException );
+        REQUIRE( items.empty() );
+
+        FSItemsStore store;
+        REQUIRE_THROWS_AS( indexer.listDirectoryItems( store, true, threads_count ), BitException );
+    }
+}
+
+TEST_CASE( "fsindexer: Indexing a directory into a compact store", "[fsindexer][FSItemsStore]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsindexer_store";
+    fs::remove_all( test_dir );
+    createTree( test_dir, 2 );
+
+    for ( const auto& in_archive_path : { fs::path{}, fs::path{ test_dir } } ) {
+        const FSItem directory_item{ test_dir, in_archive_path };
+        for ( const tstring filter : { BIT7Z_STRING( "" ), BIT7Z_STRING( "*.txt" ) } ) {
+            for ( const bool only_files : { true, false } ) {
+                for ( const bool recursive : { true, false } ) {
+                    std::vector< std::unique_ptr< GenericInputItem > > items;
+                    FSIndexer indexer{ directory_item, filter, only_files };
+                    indexer.listDirectoryItems( items, recursive );
+                    REQUIRE( !items.empty() );
+
+                    for ( const std::size_t threads_count : { 1, 4 } ) {
+                        FSItemsStore store;
+                        indexer.listDirectoryItems( store, recursive, threads_count );
+                        requireSameItems( items, store );
+                    }
+                }
+            }
+        }
+    }
+
+    fs::remove_all( test_dir );
+}
+
+TEST_CASE( "FSItem: Naming the items given by the user", "[fsindexer][FSItem]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsitem_name";
+    fs::remove_all( test_dir );
+    createTree( test_dir / "folder", 0 );
+
+    REQUIRE( FSItem{ test_dir / "folder" }.name() == BIT7Z_STRING( "folder" ) );
+    REQUIRE( FSItem{ test_dir / "folder" / "" }.name() == BIT7Z_STRING( "folder" ) );
+    REQUIRE( FSItem{ test_dir / "folder" / "." }.name() == BIT7Z_STRING( "folder" ) );
+    REQUIRE( FSItem{ test_dir / "folder" / "file0.txt" }.name() == BIT7Z_STRING( "file0.txt" ) );
+    REQUIRE( FSItem{ test_dir / "folder" / ".." }.name() == test_dir.filename().string< tchar >() );
+
+#ifndef _WIN32
+    // Symbolic links are named after the link itself, both when given by the user and when indexed.
+    fs::create_symlink( test_dir / "folder" / "file0.txt", test_dir / "link.txt" );
+    REQUIRE( FSItem{ test_dir / "link.txt" }.name() == BIT7Z_STRING( "link.txt" ) );
+
+    std::vector< std::unique_ptr< GenericInputItem > > items;
+    FSIndexer indexer{ FSItem{ test_dir }, BIT7Z_STRING( "link*" ) };
+    indexer.listDirectoryItems( items, false );
+    REQUIRE( items.size() == 1 );
+    REQUIRE( items[ 0 ]->name() == BIT7Z_STRING( "link.txt" ) );
+#endif
+
+    fs::remove_all( test_dir );
+}
@@ -15,6 +15,8 @@
 #include <bit7z/bitformat.hpp>
 #include <internal/fsutil.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <vector>
 #include <map>
 
@@ -173,4 +175,88 @@ TEST_CASE( "fsutil: Wildcard matching with both question mark and star", "[fsuti
     REQUIRE( wildcardMatch( BIT7Z_STRING( "?**?c?" ), BIT7Z_STRING( "abcd" ) ) == true );
     REQUIRE( wildcardMatch( BIT7Z_STRING( "?**?d?" ), BIT7Z_STRING( "abcd" ) ) == false );
     REQUIRE( wildcardMatch( BIT7Z_STRING( "?*b*?*d*?" ), BIT7Z_STRING( "abcde" ) ) == true );
-}
\ No newline at end of file
+}
+TEST_CASE( "fsutil: Reading the metadata of files and directories", "[fsutil][getFileMetadata]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsutil_metadata";
+    fs::remove_all( test_dir );
+    fs::create_directories( test_dir / "subdir" );
+    {
+        std::ofstream file{ test_dir / "file.txt" };
+        file << "Hello, World!";
+    }
+
+    const DirectoryHandle directory{ test_dir };
+    for ( const bool from_directory : { false, true } ) {
+        const auto read_metadata = [ & ]( const fs::path& path, FileMetadata& metadata ) -> bool {
+            return from_directory ? directory.entryMetadata( path, metadata ) : getFileMetadata( path, metadata );
+        };
+
+        FileMetadata metadata;
+        REQUIRE( read_metadata( test_dir / "file.txt", metadata ) );
+        REQUIRE( metadata.exists );
+        REQUIRE_FALSE( metadata.is_dir );
+        REQUIRE( metadata.size == 13 );
+        REQUIRE( ( metadata.attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0 );
+
+        metadata = {};
+        REQUIRE( read_metadata( test_dir / "subdir", metadata ) );
+        REQUIRE( metadata.exists );
+        REQUIRE( metadata.is_dir );
+        REQUIRE( metadata.size == 0 );
+        REQUIRE( ( metadata.attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) != 0 );
+
+        metadata = {};
+        REQUIRE_FALSE( read_metadata( test_dir / "missing.txt", metadata ) );
+
+#ifndef _WIN32
+        fs::create_symlink( test_dir / "subdir", test_dir / "link" );
+        fs::create_symlink( test_dir / "missing.txt", test_dir / "dangling" );
+
+        metadata = {};
+        REQUIRE( read_metadata( test_dir / "link", metadata ) );
+        REQUIRE( metadata.exists );
+        REQUIRE( metadata.is_dir ); // The type is the one of the target...
+        REQUIRE( ( metadata.attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == 0 ); // ...the attributes not.
+
+        metadata = {};
+        REQUIRE( read_metadata( test_dir / "dangling", metadata ) );
+        REQUIRE_FALSE( metadata.exists );
+        REQUIRE_FALSE( metadata.is_dir );
+
+        fs::remove( test_dir / "link" );
+        fs::remove( test_dir / "dangling" );
+#endif
+    }
+
+    fs::remove_all( test_dir );
+}
+
+TEST_CASE( "fsutil: Listing the entries of a directory", "[fsutil][DirectoryHandle]" ) {
+    const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_fsutil_listing";
+    fs::remove_all( test_dir );
+    fs::create_directories( test_dir / "subdir" );
+    {
+        std::ofstream file{ test_dir / "file.txt" };
+        file << "Hello, World!";
+    }
+
+    DirectoryHandle directory{ test_dir };
+    vector< fs::path > entries;
+    fs::path entry_path;
+    while ( directory.nextEntry( entry_path ) ) {
+        FileMetadata metadata;
+        REQUIRE( directory.entryMetadata( entry_path, metadata ) );
+        REQUIRE( metadata.is_dir == ( entry_path.filename() == "subdir" ) );
+        entries.push_back( entry_path );
+    }
+    std::sort( entries.begin(), entries.end() );
+    REQUIRE( entries == vector< fs::path >{ test_dir / "file.txt", test_dir / "subdir" } );
+    REQUIRE_FALSE( directory.nextEntry( entry_path ) );
+    REQUIRE_FALSE( directory.error() );
+
+    DirectoryHandle missing_directory{ test_dir / "missing" };
+    REQUIRE_FALSE( missing_directory.nextEntry( entry_path ) );
+    REQUIRE( missing_directory.error() == std::errc::no_such_file_or_directory );
+
+    fs::remove_all( test_dir );
+}
@@ -0,0 +1,100 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <internal/cbufferinstream.hpp>
+#include <internal/iostats.hpp>
+
+#include <array>
+#include <chrono>
+#include <limits>
+
+using bit7z::buffer_t;
+using bit7z::CBufferInStream;
+using bit7z::IOOperation;
+using bit7z::IOStatsCollector;
+
+TEST_CASE( "iostats: Seek distance histogram buckets", "[iostats][seekDistanceBucket]" ) {
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 0 ) == 0 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 1 ) == 1 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 4 * 1024 ) == 1 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 4 * 1024 + 1 ) == 2 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 64 * 1024 ) == 2 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 1024 * 1024 ) == 3 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 16 * 1024 * 1024 ) == 4 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( 16 * 1024 * 1024 + 1 ) == 5 );
+    REQUIRE( IOStatsCollector::seekDistanceBucket( std::numeric_limits< uint64_t >::max() ) == 5 );
+}
+
+TEST_CASE( "iostats: Recording and merging statistics", "[iostats][IOStatsCollector]" ) {
+    using std::chrono::nanoseconds;
+
+    IOStatsCollector collector;
+    collector.record( IOOperation::Read, 100, nanoseconds{ 10 } );
+    collector.record( IOOperation::Read, 50, nanoseconds{ 5 } );
+    collector.record( IOOperation::Write, 42, nanoseconds{ 7 } );
+    collector.record( IOOperation::Seek, 0, nanoseconds{ 1 } );
+    collector.record( IOOperation::Seek, 1024 * 1024 * 1024, nanoseconds{ 2 } );
+
+    auto stats = collector.stats();
+    REQUIRE( stats.readCalls == 2 );
+    REQUIRE( stats.readBytes == 150 );
+    REQUIRE( stats.readTime == nanoseconds{ 15 } );
+    REQUIRE( stats.writeCalls == 1 );
+    REQUIRE( stats.writeBytes == 42 );
+    REQUIRE( stats.writeTime == nanoseconds{ 7 } );
+    REQUIRE( stats.seekCalls == 2 );
+    REQUIRE( stats.seekTime == nanoseconds{ 3 } );
+    REQUIRE( stats.seekDistances == std::array< uint64_t, bit7z::kSeekDistanceBuckets >{ { 1, 0, 0, 0, 0, 1 } } );
+
+    IOStatsCollector total;
+    total.merge( stats );
+    total.merge( stats );
+    stats = total.stats();
+    REQUIRE( stats.readCalls == 4 );
+    REQUIRE( stats.readBytes == 300 );
+    REQUIRE( stats.writeTime == nanoseconds{ 14 } );
+    REQUIRE( stats.seekDistances == std::array< uint64_t, bit7z::kSeekDistanceBuckets >{ { 2, 0, 0, 0, 0, 2 } } );
+}
+
+TEST_CASE( "iostats: Recording the calls of a stream", "[iostats][IOStatsRecorder]" ) {
+    const buffer_t buffer( 10 * 1024, 0x2A );
+    CBufferInStream in_stream{ buffer };
+    IOStatsCollector collector;
+
+    buffer_t data( 1024 );
+    UInt32 processed_size = 0;
+    REQUIRE( in_stream.Read( data.data(), 1024, &processed_size ) == S_OK ); // Not recorded, no collector attached.
+
+    in_stream.setIOStatsCollector( &collector );
+    REQUIRE( in_stream.Read( data.data(), 1024, &processed_size ) == S_OK );
+    REQUIRE( in_stream.Seek( 8 * 1024, STREAM_SEEK_SET, nullptr ) == S_OK ); // From 2 KiB to 8 KiB.
+    REQUIRE( in_stream.Read( data.data(), 1024, &processed_size ) == S_OK );
+    REQUIRE( in_stream.Read( data.data(), 1024, &processed_size ) == S_OK ); // Only 1 KiB remaining.
+    REQUIRE( in_stream.Read( data.data(), 1024, &processed_size ) == S_OK ); // End of the stream.
+    REQUIRE( in_stream.Seek( -1, STREAM_SEEK_SET, nullptr ) != S_OK ); // Failed seek, the position doesn't change.
+    in_stream.setIOStatsCollector( nullptr );
+
+    REQUIRE( in_stream.Seek( 0, STREAM_SEEK_SET, nullptr ) == S_OK ); // Not recorded.
+
+    const auto stats = collector.stats();
+    REQUIRE( stats.readCalls == 4 );
+    REQUIRE( stats.readBytes == 3 * 1024 );
+    REQUIRE( stats.writeCalls == 0 );
+    REQUIRE( stats.seekCalls == 2 );
+    REQUIRE( stats.seekDistances == std::array< uint64_t, bit7z::kSeekDistanceBuckets >{ { 1, 0, 1, 0, 0, 0 } } );
+}
@@ -0,0 +1,149 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/itemssnapshot.hpp>
+
+#include <map>
+#include <utility>
+
+using bit7z::BitPropVariant;
+using bit7z::BitProperty;
+using bit7z::ItemsSnapshot;
+
+using ItemsProperties = std::map< std::pair< uint32_t, BitProperty >, BitPropVariant >;
+
+namespace {
+ItemsSnapshot makeSnapshot( uint32_t items_count, const ItemsProperties& properties ) {
+    return ItemsSnapshot{ items_count, [ &properties ]( uint32_t index, BitProperty property ) {
+        const auto res = properties.find( std::make_pair( index, property ) );
+        return res != properties.end() ? res->second : BitPropVariant{};
+    } };
+}
+} // namespace
+
+TEST_CASE( "ItemsSnapshot: Storing the paths of the items", "[itemssnapshot]" ) {
+    const ItemsProperties properties = {
+        { { 0, BitProperty::Path }, BitPropVariant{ std::wstring{ L"folder" } } },
+        { { 1, BitProperty::Path }, BitPropVariant{ std::wstring{ L"folder/file.txt" } } },
+        // Item 2 has no path.
+        { { 3, BitProperty::Path }, BitPropVariant{ std::wstring{} } },
+        { { 4, BitProperty::Path }, BitPropVariant{ std::wstring{ L"\u00E8\u4E2D.bin" } } }
+    };
+    const ItemsSnapshot snapshot = makeSnapshot( 5, properties );
+    REQUIRE( snapshot.itemsCount() == 5 );
+
+    REQUIRE( snapshot.itemProperty( 0, BitProperty::Path ) == properties.at( { 0, BitProperty::Path } ) );
+    REQUIRE( snapshot.itemProperty( 1, BitProperty::Path ) == properties.at( { 1, BitProperty::Path } ) );
+    REQUIRE( snapshot.itemProperty( 2, BitProperty::Path ).isEmpty() );
+    REQUIRE( snapshot.itemProperty( 3, BitProperty::Path ) == properties.at( { 3, BitProperty::Path } ) );
+    REQUIRE( snapshot.itemProperty( 4, BitProperty::Path ) == properties.at( { 4, BitProperty::Path } ) );
+}
+
+TEST_CASE( "ItemsSnapshot: Storing the properties of the items", "[itemssnapshot]" ) {
+    FILETIME write_time{};
+    write_time.dwLowDateTime = 42;
+    write_time.dwHighDateTime = 24;
+
+    const ItemsProperties properties = {
+        { { 0, BitProperty::IsDir }, BitPropVariant{ true } },
+        { { 1, BitProperty::IsDir }, BitPropVariant{ false } },
+        { { 1, BitProperty::Size }, BitPropVariant{ static_cast< uint64_t >( 10 ) } },
+        { { 1, BitProperty::PackSize }, BitPropVariant{ static_cast< uint64_t >( 4 ) } },
+        { { 1, BitProperty::CRC }, BitPropVariant{ static_cast< uint32_t >( 0x1234 ) } },
+        { { 1, BitProperty::MTime }, BitPropVariant{ write_time } },
+        { { 1, BitProperty::Encrypted }, BitPropVariant{ true } },
+        { { 2, BitProperty::Attrib }, BitPropVariant{ static_cast< uint32_t >( 0x20 ) } }
+    };
+    const ItemsSnapshot snapshot = makeSnapshot( 3, properties );
+
+    for ( const auto& property : properties ) {
+        const BitPropVariant value = snapshot.itemProperty( property.first.first, property.first.second );
+        REQUIRE( value == property.second );
+        REQUIRE( value.vt == property.second.vt );
+    }
+    REQUIRE( snapshot.itemProperty( 0, BitProperty::Size ).isEmpty() );
+    REQUIRE( snapshot.itemProperty( 2, BitProperty::IsDir ).isEmpty() );
+
+    REQUIRE( snapshot.isDir( 0 ) );
+    REQUIRE_FALSE( snapshot.isDir( 1 ) );
+    REQUIRE_FALSE( snapshot.isDir( 2 ) );
+    REQUIRE( snapshot.isEncrypted( 1 ) );
+    REQUIRE_FALSE( snapshot.isEncrypted( 2 ) );
+    REQUIRE( snapshot.size( 1 ) == 10 );
+    REQUIRE( snapshot.size( 2 ) == 0 );
+    REQUIRE( snapshot.packSize( 1 ) == 4 );
+
+    REQUIRE( ItemsSnapshot::covers( BitProperty::Path ) );
+    REQUIRE( ItemsSnapshot::covers( BitProperty::CRC ) );
+    REQUIRE_FALSE( ItemsSnapshot::covers( BitProperty::Comment ) );
+}
+
+TEST_CASE( "ItemsSnapshot: Storing properties with unusual types", "[itemssnapshot]" ) {
+    // The handlers usually return 64-bit sizes, 32-bit attributes, and boolean flags.
+    const ItemsProperties properties = {
+        { { 0, BitProperty::Size }, BitPropVariant{ static_cast< uint32_t >( 5 ) } },
+        { { 0, BitProperty::PackSize }, BitPropVariant{ static_cast< uint16_t >( 3 ) } },
+        { { 0, BitProperty::Attrib }, BitPropVariant{ static_cast< uint64_t >( 0x20 ) } },
+        { { 0, BitProperty::IsDir }, BitPropVariant{ static_cast< uint32_t >( 0 ) } },
+        { { 1, BitProperty::Path }, BitPropVariant{ static_cast< uint32_t >( 42 ) } },
+        { { 1, BitProperty::Size }, BitPropVariant{ static_cast< uint64_t >( 7 ) } }
+    };
+    const ItemsSnapshot snapshot = makeSnapshot( 2, properties );
+
+    // The values are returned as they are, with their original types.
+    for ( const auto& property : properties ) {
+        const BitPropVariant value = snapshot.itemProperty( property.first.first, property.first.second );
+        REQUIRE( value == property.second );
+        REQUIRE( value.vt == property.second.vt );
+    }
+    REQUIRE( snapshot.size( 0 ) == 5 );
+    REQUIRE( snapshot.packSize( 0 ) == 3 );
+    REQUIRE( snapshot.size( 1 ) == 7 );
+    REQUIRE( snapshot.itemProperty( 1, BitProperty::PackSize ).isEmpty() );
+}
+
+TEST_CASE( "ItemsSnapshot: Aggregating the properties of the items", "[itemssnapshot]" ) {
+    SECTION( "No items" ) {
+        const ItemsSnapshot snapshot = makeSnapshot( 0, {} );
+        REQUIRE( snapshot.itemsCount() == 0 );
+        REQUIRE( snapshot.foldersCount() == 0 );
+        REQUIRE( snapshot.totalSize() == 0 );
+        REQUIRE( snapshot.totalPackSize() == 0 );
+        REQUIRE_FALSE( snapshot.hasEncryptedItems() );
+    }
+
+    SECTION( "Files and folders" ) {
+        const ItemsProperties properties = {
+            { { 0, BitProperty::IsDir }, BitPropVariant{ true } },
+            { { 0, BitProperty::Size }, BitPropVariant{ static_cast< uint64_t >( 100 ) } }, // Ignored (folder).
+            { { 0, BitProperty::Encrypted }, BitPropVariant{ true } }, // Ignored (folder).
+            { { 1, BitProperty::Size }, BitPropVariant{ static_cast< uint64_t >( 10 ) } },
+            { { 1, BitProperty::PackSize }, BitPropVariant{ static_cast< uint64_t >( 4 ) } },
+            { { 2, BitProperty::Size }, BitPropVariant{ static_cast< uint32_t >( 5 ) } }, // Kept in the side map.
+            { { 2, BitProperty::PackSize }, BitPropVariant{ static_cast< uint64_t >( 3 ) } },
+            { { 3, BitProperty::IsDir }, BitPropVariant{ true } }
+        };
+        ItemsProperties encrypted_properties = properties;
+        encrypted_properties[ { 2, BitProperty::Encrypted } ] = BitPropVariant{ true };
+
+        const ItemsSnapshot snapshot = makeSnapshot( 4, properties );
+        REQUIRE( snapshot.foldersCount() == 2 );
+        REQUIRE( snapshot.totalSize() == 15 );
+        REQUIRE( snapshot.totalPackSize() == 7 );
+        REQUIRE_FALSE( snapshot.hasEncryptedItems() );
+
+        const ItemsSnapshot encrypted_snapshot = makeSnapshot( 4, encrypted_properties );
+        REQUIRE( encrypted_snapshot.hasEncryptedItems() );
+    }
+}
@@ -0,0 +1,206 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bit7zlibrary.hpp>
+#include <bit7z/bitarchivereader.hpp>
+#include <internal/fs.hpp>
+#include <internal/parallelextraction.hpp>
+
+#include "fakearchive.hpp"
+#include "shared_lib.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using bit7z::Bit7zLibrary;
+using bit7z::BitArchiveReader;
+using bit7z::BitProgressMonitor;
+using bit7z::ExtractionCallbacks;
+using bit7z::ParallelExtractionState;
+using bit7z::partitionBySize;
+using bit7z::byte_t;
+
+namespace BitFormat = bit7z::BitFormat;
+namespace fake = bit7z::test::fake;
+
+TEST_CASE( "parallelextraction: Partitioning items by size", "[parallelextraction][partitionBySize]" ) {
+    SECTION( "No items" ) {
+        const auto groups = partitionBySize( {}, {}, 4 );
+        REQUIRE( groups.empty() );
+    }
+
+    SECTION( "Fewer items than groups" ) {
+        const auto groups = partitionBySize( { 3, 1 }, { 10, 20 }, 4 );
+        REQUIRE( groups.size() == 2 );
+        REQUIRE( groups[ 0 ] == std::vector< uint32_t >{ 1 } );
+        REQUIRE( groups[ 1 ] == std::vector< uint32_t >{ 3 } );
+    }
+
+    SECTION( "Single group" ) {
+        const auto groups = partitionBySize( { 5, 2, 7 }, { 1, 2, 3 }, 1 );
+        REQUIRE( groups.size() == 1 );
+        REQUIRE( groups[ 0 ] == std::vector< uint32_t >{ 2, 5, 7 } );
+    }
+
+    SECTION( "Groups are balanced and sorted" ) {
+        // Total size: 200, so the best split in two groups is 100 + 100.
+        const std::vector< uint32_t > indices{ 0, 1, 2, 3, 4, 5 };
+        const std::vector< uint64_t > sizes{ 10, 60, 40, 50, 30, 10 };
+        const auto groups = partitionBySize( indices, sizes, 2 );
+        REQUIRE( groups.size() == 2 );
+
+        std::vector< uint32_t > all_indices;
+        for ( const auto& group : groups ) {
+            REQUIRE( std::is_sorted( group.cbegin(), group.cend() ) );
+            uint64_t group_size = 0;
+            for ( const auto index : group ) {
+                group_size += sizes[ index ];
+            }
+            REQUIRE( group_size == 100 );
+            all_indices.insert( all_indices.end(), group.cbegin(), group.cend() );
+        }
+        std::sort( all_indices.begin(), all_indices.end() );
+        REQUIRE( all_indices == indices );
+    }
+}
+
+TEST_CASE( "parallelextraction: Merging the progress of the workers", "[parallelextraction][BitProgressMonitor]" ) {
+    constexpr size_t workers_count = 8;
+    constexpr uint64_t items_count = 20000; // For each worker.
+    constexpr uint64_t item_size = 10;
+    constexpr uint64_t total_size = workers_count * items_count * item_size;
+
+    const BitProgressMonitor monitor;
+    std::vector< uint64_t > notified_sizes; // Note: the progress callback is never called concurrently.
+    ExtractionCallbacks callbacks;
+    callbacks.progress = [ &notified_sizes ]( uint64_t processed_size ) -> bool {
+        notified_sizes.push_back( processed_size );
+        return true;
+    };
+
+    ParallelExtractionState state{ monitor, callbacks, workers_count };
+    state.beginOperation( workers_count * items_count, total_size );
+
+    // Polling the original monitor while the workers are running.
+    std::atomic< bool > workers_done{ false };
+    bool monotonic = true;
+    std::thread poller{ [ & ]() {
+        uint64_t last_size = 0;
+        uint64_t last_items = 0;
+        while ( !workers_done ) {
+            const uint64_t processed_size = monitor.processedSize();
+            const uint64_t processed_items = monitor.processedItems();
+            monotonic = monotonic && processed_size >= last_size && processed_items >= last_items;
+            last_size = processed_size;
+            last_items = processed_items;
+        }
+    } };
+
+    std::vector< std::thread > workers;
+    for ( size_t worker_index = 0; worker_index < workers_count; ++worker_index ) {
+        workers.emplace_back( [ &state, worker_index ]() {
+            for ( uint64_t item = 1; item <= items_count; ++item ) {
+                if ( !state.setCompleted( worker_index, item * item_size, item ) ) {
+                    return;
+                }
+            }
+        } );
+    }
+    for ( auto& worker : workers ) {
+        worker.join();
+    }
+    state.updateProgress();
+    workers_done = true;
+    poller.join();
+
+    REQUIRE( monotonic );
+    REQUIRE( std::is_sorted( notified_sizes.cbegin(), notified_sizes.cend() ) );
+    REQUIRE( notified_sizes.size() == workers_count * items_count );
+    REQUIRE( monitor.processedSize() == total_size );
+    REQUIRE( monitor.processedItems() == workers_count * items_count );
+}
+
+TEST_CASE( "parallelextraction: Extracting an archive using multiple threads", "[parallelextraction]" ) {
+    const Bit7zLibrary lib{ bit7z::test::fake_lib_path() };
+
+    const std::vector< fake::Item > items = { { "first.txt", std::string( 300, 'a' ) },
+                                              fake::directory( "folder" ),
+                                              { "folder/second.txt", std::string( 200, 'b' ) },
+                                              { "folder/third.txt", std::string( 100, 'c' ) },
+                                              { "fourth.txt", std::string( 250, 'd' ) },
+                                              { "fifth.txt", std::string( 50, 'e' ) },
+                                              { "empty.txt", "" } };
+    constexpr uint64_t total_size = 900;
+
+    // The workers must reopen the archive at the same offset in the file.
+    const std::string prefix = GENERATE( as< std::string >(), "", "an archive embedded after some data" );
+    DYNAMIC_SECTION( "Archive at offset " << prefix.size() ) {
+        const fs::path test_dir = fs::temp_directory_path() / "bit7z_test_parallelextraction";
+        fs::remove_all( test_dir );
+        fs::create_directories( test_dir );
+
+        const fs::path archive_path = test_dir / "archive.fake";
+        {
+            const auto archive = fake::make_archive( items, 0, 64 );
+            fs::ofstream archive_file{ archive_path, std::ios::binary };
+            archive_file << prefix;
+            archive_file.write( reinterpret_cast< const char* >( archive.data() ), // NOLINT(*-reinterpret-cast)
+                                static_cast< std::streamsize >( archive.size() ) );
+        }
+
+        BitArchiveReader reader{ lib, archive_path.string< bit7z::tchar >(), prefix.size(), BitFormat::SevenZip };
+        reader.setExtractionThreads( 3 );
+
+        uint64_t notified_total = 0;
+        std::vector< uint64_t > notified_sizes; // Note: the progress callback is never called concurrently.
+        reader.setTotalCallback( [ &notified_total ]( uint64_t total ) {
+            notified_total = total;
+        } );
+        reader.setProgressCallback( [ &notified_sizes ]( uint64_t processed_size ) -> bool {
+            notified_sizes.push_back( processed_size );
+            return true;
+        } );
+
+        const fs::path out_dir = test_dir / "out";
+        const auto extract_calls = bit7z::test::fake_extract_calls();
+        REQUIRE_NOTHROW( reader.extract( out_dir.string< bit7z::tchar >() ) );
+        // One extraction for each worker, plus the one of the folders (after all the files have been extracted).
+        REQUIRE( bit7z::test::fake_extract_calls() == extract_calls + 4 );
+
+        for ( const auto& item : items ) {
+            const fs::path item_path = out_dir / item.path;
+            if ( ( item.flags & fake::kDirectory ) != 0 ) {
+                REQUIRE( fs::is_directory( item_path ) );
+                continue;
+            }
+            fs::ifstream item_file{ item_path, std::ios::binary };
+            REQUIRE( item_file.is_open() );
+            const std::vector< byte_t > content{ std::istreambuf_iterator< char >{ item_file },
+                                                 std::istreambuf_iterator< char >{} };
+            REQUIRE( content == item.content );
+        }
+
+        REQUIRE( notified_total == total_size );
+        REQUIRE_FALSE( notified_sizes.empty() );
+        REQUIRE( std::is_sorted( notified_sizes.cbegin(), notified_sizes.cend() ) );
+        REQUIRE( notified_sizes.back() == total_size );
+        REQUIRE( reader.progressMonitor().processedSize() == total_size );
+
+        fs::remove_all( test_dir );
+    }
+}
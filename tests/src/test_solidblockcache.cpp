@@ -0,0 +1,82 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <internal/solidblockcache.hpp>
+
+#include <array>
+
+using bit7z::byte_t;
+using bit7z::SolidBlockCache;
+
+using Buffer = std::vector< byte_t >;
+using BlockItems = std::map< uint32_t, Buffer >;
+
+TEST_CASE( "SolidBlockCache: Caching the items of solid blocks", "[solidblockcache]" ) {
+    SolidBlockCache cache{ 8 };
+    Buffer out_buffer;
+    REQUIRE_FALSE( cache.get( 0, out_buffer ) );
+
+    cache.insert( BlockItems{ { 0, Buffer{ 1, 2 } }, { 1, Buffer{ 3, 4 } } } );
+    REQUIRE( cache.usedMemory() == 4 );
+    REQUIRE( cache.get( 1, out_buffer ) );
+    REQUIRE( out_buffer == Buffer{ 3, 4 } );
+
+    SECTION( "Copying into a fixed-size buffer" ) {
+        std::array< byte_t, 2 > fixed_buffer{};
+        REQUIRE( cache.get( 0, fixed_buffer.data(), fixed_buffer.size() ) );
+        REQUIRE( fixed_buffer == std::array< byte_t, 2 >{ { 1, 2 } } );
+        REQUIRE_FALSE( cache.get( 0, fixed_buffer.data(), 1 ) );
+    }
+
+    SECTION( "Evicting the least recently used block" ) {
+        cache.insert( BlockItems{ { 5, Buffer{ 5, 6, 7 } } } );
+        REQUIRE( cache.usedMemory() == 7 );
+        REQUIRE( cache.get( 0, out_buffer ) ); // The first block is now the most recently used one.
+
+        cache.insert( BlockItems{ { 8, Buffer{ 8, 9 } } } );
+        REQUIRE( cache.usedMemory() == 6 );
+        REQUIRE_FALSE( cache.get( 5, out_buffer ) );
+        REQUIRE( cache.get( 1, out_buffer ) );
+        REQUIRE( cache.get( 8, out_buffer ) );
+        REQUIRE( out_buffer == Buffer{ 8, 9 } );
+    }
+
+    SECTION( "Re-inserting already cached items" ) {
+        cache.insert( BlockItems{ { 1, Buffer{ 3, 4 } }, { 2, Buffer{ 5 } } } );
+        REQUIRE( cache.usedMemory() == 5 );
+        REQUIRE( cache.contains( 0 ) );
+        REQUIRE( cache.contains( 1 ) );
+
+        // Evicting the first block must not drop item 1, which is now stored in the second block.
+        cache.insert( BlockItems{ { 7, Buffer{ 7, 7, 7, 7, 7 } } } );
+        REQUIRE_FALSE( cache.contains( 0 ) );
+        REQUIRE( cache.get( 1, out_buffer ) );
+        REQUIRE( out_buffer == Buffer{ 3, 4 } );
+        REQUIRE( cache.usedMemory() == 8 );
+
+        // Evicting the remaining blocks releases all their memory.
+        cache.insert( BlockItems{ { 9, Buffer( 6, 9 ) } } );
+        REQUIRE_FALSE( cache.contains( 1 ) );
+        REQUIRE_FALSE( cache.contains( 2 ) );
+        REQUIRE_FALSE( cache.contains( 7 ) );
+        REQUIRE( cache.usedMemory() == 6 );
+    }
+
+    SECTION( "Blocks larger than the cache are ignored" ) {
+        cache.insert( BlockItems{ { 9, Buffer( 9, 0 ) } } );
+        REQUIRE( cache.usedMemory() == 4 );
+        REQUIRE_FALSE( cache.get( 9, out_buffer ) );
+        REQUIRE( cache.get( 0, out_buffer ) );
+    }
+}
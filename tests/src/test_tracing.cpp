@@ -0,0 +1,92 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * bit7z - A C++ static library to interface with the 7-zip shared libraries.
+ * Copyright (c) 2014-2022 Riccardo Ostani - All Rights Reserved.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef BIT7Z_ENABLE_TRACING
+
+#include <catch2/catch.hpp>
+
+#include <bit7z/bittrace.hpp>
+#include <internal/tracing.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using bit7z::ThreadTraceBuffer;
+using bit7z::TraceEvent;
+
+TEST_CASE( "tracing: Thread trace buffer", "[tracing][ThreadTraceBuffer]" ) {
+    ThreadTraceBuffer buffer{ 42, 4 };
+    std::vector< TraceEvent > events;
+
+    SECTION( "Empty buffer" ) {
+        buffer.collect( events );
+        REQUIRE( events.empty() );
+    }
+
+    SECTION( "Events are collected from the oldest to the newest" ) {
+        buffer.push( "first", 10, 1 );
+        buffer.push( "second", 20, 2 );
+        buffer.collect( events );
+        REQUIRE( events.size() == 2 );
+        REQUIRE( std::string{ events[ 0 ].name } == "first" );
+        REQUIRE( events[ 0 ].start == 10 );
+        REQUIRE( events[ 0 ].duration == 1 );
+        REQUIRE( events[ 0 ].threadIndex == 42 );
+        REQUIRE( std::string{ events[ 1 ].name } == "second" );
+        REQUIRE( events[ 1 ].start == 20 );
+    }
+
+    SECTION( "The oldest events are overwritten when the buffer is full" ) {
+        for ( uint64_t i = 0; i < 10; ++i ) {
+            buffer.push( "event", i, 0 );
+        }
+        buffer.collect( events );
+        // Note: the oldest slot is also discarded, since the owning thread might be writing it.
+        REQUIRE( events.size() == 3 );
+        REQUIRE( events[ 0 ].start == 7 );
+        REQUIRE( events[ 2 ].start == 9 );
+    }
+
+    SECTION( "Clearing the buffer" ) {
+        buffer.push( "old", 1, 0 );
+        buffer.clear();
+        buffer.collect( events );
+        REQUIRE( events.empty() );
+
+        buffer.push( "new", 2, 0 );
+        buffer.collect( events );
+        REQUIRE( events.size() == 1 );
+        REQUIRE( std::string{ events[ 0 ].name } == "new" );
+    }
+}
+
+TEST_CASE( "tracing: Exporting spans as Chrome trace events", "[tracing][writeChromeTrace]" ) {
+    bit7z::clearTrace();
+    {
+        BIT7Z_TRACE_SCOPE( "test span" );
+    }
+
+    std::ostringstream output;
+    bit7z::writeChromeTrace( output );
+    const std::string trace = output.str();
+    REQUIRE( trace.find( R"({"traceEvents":[)" ) == 0 );
+    REQUIRE( trace.find( R"("name":"test span")" ) != std::string::npos );
+    REQUIRE( trace.find( R"("ph":"X")" ) != std::string::npos );
+
+    bit7z::clearTrace();
+    output.str( "" );
+    bit7z::writeChromeTrace( output );
+    REQUIRE( output.str().find( "test span" ) == std::string::npos );
+}
+
+#endif